@@ -0,0 +1,390 @@
+﻿#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <intrin.h>
+#include "Log.h"
+#include "SIMD.h"
+#include "Configuration.h"
+#include "DrawBuffer.h"
+#include "AutoTuner.h"
+
+namespace SWGL {
+
+    // Number of synthetic frames that are rendered per candidate configuration
+    static constexpr int NUM_FRAMES = 3;
+
+    // Number of overlapping layers that are drawn into every tile per frame
+    static constexpr int NUM_LAYERS = 3;
+
+    // Edge length of the synthetic texture
+    static constexpr int TEXTURE_SIZE = 256;
+
+    // The tile sizes that are tried
+    static constexpr unsigned int TILE_SIZES[] = { 32U, 64U, 128U, 256U };
+
+    // Name of the cache file if SWGL_AUTOTUNE_CACHE isn't set
+    static constexpr const char *CACHE_FILENAME = "swGL-autotune.txt";
+
+
+
+    static void drawTile(DrawBuffer &drawBuffer, TextureMipMap &texture, TextureParameter &texParams) {
+
+        auto color = drawBuffer.getColor();
+        auto depth = drawBuffer.getDepth();
+        auto halfWidth = drawBuffer.getWidth() >> 1;
+        auto numQuads = (drawBuffer.getWidth() * drawBuffer.getHeight()) >> 2;
+
+        const QFloat quadX = _mm_set_ps(1.0f, 0.0f, 1.0f, 0.0f);
+        const QFloat quadY = _mm_set_ps(1.0f, 1.0f, 0.0f, 0.0f);
+        const QFloat texScale = _mm_set1_ps(1.0f / static_cast<float>(TEXTURE_SIZE));
+        const QFloat colorScale = _mm_set1_ps(255.0f);
+
+        drawBuffer.clearColor(0, drawBuffer.getMinX(), drawBuffer.getMinY(), drawBuffer.getMaxX(), drawBuffer.getMaxY());
+        drawBuffer.clearDepth(0xffffffff, drawBuffer.getMinX(), drawBuffer.getMinY(), drawBuffer.getMaxX(), drawBuffer.getMaxY());
+
+        // Every layer is closer than the previous one, so all of them pass the depth
+        // test (which is about the worst case for overdraw)
+        for (int layer = 0; layer < NUM_LAYERS; layer++) {
+
+            QInt layerDepth = _mm_set1_epi32((NUM_LAYERS - layer) << 24);
+            QFloat layerOffset = _mm_set1_ps(static_cast<float>(layer * 17));
+
+            for (int quadIdx = 0; quadIdx < numQuads; quadIdx++) {
+
+                auto x = static_cast<float>(drawBuffer.getMinX() + ((quadIdx % halfWidth) << 1));
+                auto y = static_cast<float>(drawBuffer.getMinY() + ((quadIdx / halfWidth) << 1));
+
+                TextureCoordinates texCoords;
+                texCoords.s = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_set1_ps(x), quadX), layerOffset), texScale);
+                texCoords.t = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(y), quadY), texScale);
+                texCoords.r = _mm_setzero_ps();
+
+                ARGBColor texColor;
+                sampleTexelsLinear(texture, texParams, texCoords, texColor);
+
+                auto colorPtr = reinterpret_cast<QInt *>(color + (quadIdx << 2));
+                auto depthPtr = reinterpret_cast<QInt *>(depth + (quadIdx << 2));
+
+                QInt dstDepth = _mm_load_si128(depthPtr);
+                QInt mask = _mm_cmplt_epi32(
+
+                    _mm_xor_si128(layerDepth, _mm_set1_epi32(0x80000000)),
+                    _mm_xor_si128(dstDepth, _mm_set1_epi32(0x80000000))
+                );
+
+                QInt srcColor = _mm_or_si128(
+
+                    _mm_or_si128(
+
+                        _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(texColor.a, colorScale)), 24),
+                        _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(texColor.r, colorScale)), 16)
+                    ),
+                    _mm_or_si128(
+
+                        _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(texColor.g, colorScale)), 8),
+                        _mm_cvtps_epi32(_mm_mul_ps(texColor.b, colorScale))
+                    )
+                );
+
+                // Average with the color of the previous layer, like a blended draw
+                QInt dstColor = _mm_load_si128(colorPtr);
+                srcColor = _mm_avg_epu8(srcColor, dstColor);
+
+                _mm_store_si128(depthPtr, SIMD::blend(dstDepth, layerDepth, mask));
+                _mm_store_si128(colorPtr, SIMD::blend(dstColor, srcColor, mask));
+            }
+        }
+    }
+
+
+
+    AutoTuner::AutoTuner(int width, int height)
+
+        : m_width(std::max((width + 1) & ~1, 2)),
+          m_height(std::max((height + 1) & ~1, 2)) {
+
+        // Some noise, so the samples don't come from a flat texture
+        unsigned int seed = 0x12345678U;
+
+        m_texture.width = TEXTURE_SIZE;
+        m_texture.height = TEXTURE_SIZE;
+        m_texture.pixel.resize(TEXTURE_SIZE * TEXTURE_SIZE);
+
+        for (auto &pixel : m_texture.pixel) {
+
+            seed = (seed * 1664525U) + 1013904223U;
+            pixel = seed;
+        }
+    }
+
+
+
+    void AutoTuner::tuneOnce(HDC hdc) {
+
+        static bool isTuned = false;
+
+        auto &config = Configuration::getInstance();
+        if (isTuned || config.getAutoTuneMode() == AutoTuneMode::Disabled) {
+
+            return;
+        }
+
+        isTuned = true;
+
+        RECT r = {};
+        GetClientRect(WindowFromDC(hdc), &r);
+
+        AutoTuner tuner(
+
+            static_cast<int>(r.right - r.left),
+            static_cast<int>(r.bottom - r.top)
+        );
+
+        Result result;
+        if (config.getAutoTuneMode() == AutoTuneMode::Always || !tuner.loadResult(result)) {
+
+            result = tuner.tune();
+            tuner.saveResult(result);
+        }
+
+        config.setTunedValues(result.tileSize, result.numDrawThreads);
+    }
+
+
+
+    AutoTuner::Result AutoTuner::tune() {
+
+        auto numProcessors = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+
+        // All logical processors, one left for the application thread, and one
+        // thread per physical core (if the processors have SMT)
+        std::vector<unsigned int> threadCounts = {
+
+            static_cast<unsigned int>(numProcessors),
+            static_cast<unsigned int>(std::max(numProcessors - 1, 1)),
+            static_cast<unsigned int>(std::max(numProcessors / 2, 1))
+        };
+
+        for (auto &numThreads : threadCounts) {
+
+            numThreads = std::min(numThreads, SWGL_MAX_DRAW_THREADS);
+        }
+
+        std::sort(threadCounts.begin(), threadCounts.end());
+        threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+
+        Result best = { SWGL_DEFAULT_TILE_SIZE, static_cast<unsigned int>(numProcessors) };
+        auto bestTime = std::numeric_limits<long long>::max();
+
+        for (auto tileSize : TILE_SIZES) {
+
+            for (auto numThreads : threadCounts) {
+
+                auto time = measure(tileSize, numThreads);
+
+                LOG("Tile size: %u, Drawing threads: %u, Time: %lld us", tileSize, numThreads, time / 1000);
+
+                // Fewer threads are tried first. More threads (or a larger tile) are
+                // only worth it if they are noticeably faster, otherwise the result
+                // would depend on the noise of the measurements.
+                if (bestTime == std::numeric_limits<long long>::max() || time < bestTime - (bestTime / 20)) {
+
+                    bestTime = time;
+                    best = { tileSize, numThreads };
+                }
+            }
+        }
+
+        return best;
+    }
+
+    long long AutoTuner::measure(unsigned int tileSize, unsigned int numThreads) {
+
+        // Split the frame into tiles, the same way DrawSurface does
+        auto size = static_cast<int>(tileSize);
+        auto numTilesX = (m_width + size - 1) / size;
+        auto numTilesY = (m_height + size - 1) / size;
+
+        std::vector<DrawBuffer> drawBuffers(numTilesX * numTilesY);
+        ColorBuffer frameImage(m_width * m_height);
+
+        for (int y = 0; y < numTilesY; y++) {
+
+            for (int x = 0; x < numTilesX; x++) {
+
+                auto minX = x * size;
+                auto minY = y * size;
+
+                drawBuffers[x + (y * numTilesX)].resize(
+
+                    minX, minY,
+                    std::min(minX + size, m_width),
+                    std::min(minY + size, m_height)
+                );
+            }
+        }
+
+        // The tiles are handed out round robin, like to the drawing threads. Every
+        // thread draws its tiles and copies them into the frame image.
+        std::atomic<bool> isStarted(false);
+        std::vector<std::thread> threads;
+
+        for (auto threadIdx = 0U; threadIdx < numThreads; threadIdx++) {
+
+            threads.emplace_back([&, threadIdx] {
+
+                while (!isStarted.load(std::memory_order_acquire)) {
+
+                    std::this_thread::yield();
+                }
+
+                for (int frame = 0; frame < NUM_FRAMES; frame++) {
+
+                    for (auto i = threadIdx; i < drawBuffers.size(); i += numThreads) {
+
+                        drawTile(drawBuffers[i], m_texture, m_texParams);
+                        drawBuffers[i].unswizzleColor(frameImage.data(), m_width);
+                    }
+                }
+            });
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        isStarted.store(true, std::memory_order_release);
+
+        for (auto &thread : threads) {
+
+            thread.join();
+        }
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+
+            std::chrono::steady_clock::now() - startTime
+        ).count();
+    }
+
+
+
+    bool AutoTuner::loadResult(Result &result) {
+
+        std::ifstream in(getCachePath());
+        auto key = getCacheKey();
+
+        std::string line;
+        while (std::getline(in, line)) {
+
+            std::istringstream entry(line);
+            std::string entryKey;
+            Result entryResult;
+
+            if (entry >> entryKey >> entryResult.tileSize >> entryResult.numDrawThreads && entryKey == key) {
+
+                LOG("Using the cached configuration of %s", key.c_str());
+
+                result = entryResult;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void AutoTuner::saveResult(const Result &result) {
+
+        auto path = getCachePath();
+        auto key = getCacheKey();
+
+        // Keep the results of the other machines / resolutions
+        std::vector<std::string> lines;
+        {
+            std::ifstream in(path);
+
+            std::string line;
+            while (std::getline(in, line)) {
+
+                std::istringstream entry(line);
+                std::string entryKey;
+
+                if (entry >> entryKey && entryKey != key) {
+
+                    lines.push_back(line);
+                }
+            }
+        }
+
+        std::ofstream out(path, std::ios::out | std::ios::trunc);
+        if (!out) {
+
+            LOG("Can't write the tuning cache %s", path.c_str());
+            return;
+        }
+
+        for (auto &line : lines) {
+
+            out << line << "\n";
+        }
+
+        out << key << " " << result.tileSize << " " << result.numDrawThreads << "\n";
+    }
+
+    std::string AutoTuner::getCacheKey() const {
+
+        // The processor brand string identifies the machine (well enough), as the
+        // results depend on its caches and cores
+        int cpuInfo[12] = {};
+        __cpuid(cpuInfo, 0x80000000);
+
+        if (static_cast<unsigned int>(cpuInfo[0]) >= 0x80000004U) {
+
+            __cpuid(cpuInfo, 0x80000002);
+            __cpuid(cpuInfo + 4, 0x80000003);
+            __cpuid(cpuInfo + 8, 0x80000004);
+        }
+        else {
+
+            std::fill(std::begin(cpuInfo), std::end(cpuInfo), 0);
+        }
+
+        std::string brand(reinterpret_cast<const char *>(cpuInfo), sizeof(cpuInfo));
+        brand.resize(brand.find('\0') != std::string::npos ? brand.find('\0') : brand.size());
+
+        // Spaces separate the values of an entry
+        std::string key;
+        for (auto c : brand) {
+
+            if (c != ' ' || (!key.empty() && key.back() != '_')) {
+
+                key += (c == ' ') ? '_' : c;
+            }
+        }
+
+        std::ostringstream out;
+        out << (key.empty() ? "Unknown" : key) << "/" << std::thread::hardware_concurrency() << "/" << m_width << "x" << m_height;
+
+        return out.str();
+    }
+
+    std::string AutoTuner::getCachePath() {
+
+        char buffer[MAX_PATH];
+
+        auto length = GetEnvironmentVariableA("SWGL_AUTOTUNE_CACHE", buffer, sizeof(buffer));
+        if (length > 0 && length < sizeof(buffer)) {
+
+            return buffer;
+        }
+
+        length = GetEnvironmentVariableA("LOCALAPPDATA", buffer, sizeof(buffer));
+        if (length > 0 && length < sizeof(buffer)) {
+
+            return std::string(buffer) + "\\" + CACHE_FILENAME;
+        }
+
+        return CACHE_FILENAME;
+    }
+}
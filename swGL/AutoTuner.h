@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <Windows.h>
+#include <string>
+#include "Defines.h"
+#include "TextureManager.h"
+
+namespace SWGL {
+
+    //
+    // Picks the tile size and the number of drawing threads for the machine and the
+    // resolution when the first context is created (if enabled with SWGL_AUTOTUNE).
+    // Every candidate configuration renders a few synthetic frames, which rasterize,
+    // sample a texture and unswizzle the tiles like the drawing threads do, and the
+    // fastest one is taken. The result is kept in a small cache file, so later
+    // launches start tuned right away.
+    //
+    class AutoTuner {
+
+    public:
+        AutoTuner(int width, int height);
+        ~AutoTuner() = default;
+
+    public:
+        // Tunes the configuration (or loads the cached result) if this is the first
+        // context of the process
+        static void tuneOnce(HDC hdc);
+
+    private:
+        struct Result {
+
+            unsigned int tileSize;
+            unsigned int numDrawThreads;
+        };
+
+        Result tune();
+        long long measure(unsigned int tileSize, unsigned int numThreads);
+
+        bool loadResult(Result &result);
+        void saveResult(const Result &result);
+        std::string getCacheKey() const;
+        static std::string getCachePath();
+
+    private:
+        int m_width;
+        int m_height;
+        TextureMipMap m_texture;
+        TextureParameter m_texParams;
+    };
+}
@@ -0,0 +1,172 @@
+﻿#include <algorithm>
+#include "SIMD.h"
+#include "Triangle.h"
+#include "ContextTypes.h"
+#include "TextureManager.h"
+#include "CommandDrawTriangle.h"
+#include "CostModel.h"
+#include "Kernels.h"
+#include "Binner.h"
+
+namespace SWGL {
+
+    Binner::Binner(ThreadPool &threadPool)
+
+        : m_threadPool(threadPool),
+          m_numBinsX(0),
+          m_numBinsY(0),
+          m_binSize(0) {
+
+    }
+
+
+
+    void Binner::binTriangles(TriangleDrawCallState &state, int numBinsX, int numBinsY, int binSize) {
+
+        m_numBinsX = numBinsX;
+        m_numBinsY = numBinsY;
+        m_binSize = binSize;
+
+        auto pixelCost = CostModel::getPixelCost(state);
+        auto numTriangles = static_cast<int>(state.triangles.size());
+        auto numChunks = (numTriangles + SWGL_BINNING_CHUNK_SIZE - 1) / SWGL_BINNING_CHUNK_SIZE;
+
+        resetBins(m_bins);
+
+        // Small draw calls are binned right away
+        if (numChunks <= 1 || m_threadPool.getNumThreads() <= 1) {
+
+            binChunk(state, pixelCost, 0, numTriangles, m_bins);
+            return;
+        }
+
+        if (static_cast<int>(m_chunks.size()) < numChunks) {
+
+            m_chunks.resize(numChunks);
+        }
+
+        m_threadPool.run(numChunks, [&](int chunkIdx) {
+
+            auto begin = chunkIdx * SWGL_BINNING_CHUNK_SIZE;
+            auto end = std::min(begin + SWGL_BINNING_CHUNK_SIZE, numTriangles);
+
+            resetBins(m_chunks[chunkIdx]);
+            binChunk(state, pixelCost, begin, end, m_chunks[chunkIdx]);
+        });
+
+        // Concatenate the bins of the chunks in order
+        auto numBins = numBinsX * numBinsY;
+        auto numMergeJobs = std::min(numBins, m_threadPool.getNumThreads() * 4);
+
+        m_threadPool.run(numMergeJobs, [&](int jobIdx) {
+
+            mergeChunks(
+
+                numChunks,
+                (numBins * jobIdx) / numMergeJobs,
+                (numBins * (jobIdx + 1)) / numMergeJobs
+            );
+        });
+    }
+
+
+
+    void Binner::resetBins(BinSet &bins) {
+
+        auto numBins = static_cast<unsigned int>(m_numBinsX * m_numBinsY);
+
+        bins.indices.resize(numBins);
+        bins.costs.assign(numBins, 0);
+
+        for (auto &indices : bins.indices) {
+
+            indices.clear();
+        }
+    }
+
+    void Binner::binChunk(TriangleDrawCallState &state, int pixelCost, int begin, int end, BinSet &bins) {
+
+        // The bounding boxes are cut against the binned area and the scissor rectangle
+        int clipMinX = 0, clipMinY = 0;
+        int clipMaxX = m_numBinsX * m_binSize;
+        int clipMaxY = m_numBinsY * m_binSize;
+
+        auto &scissor = state.stateBlock->scissor;
+        if (scissor.isEnabled()) {
+
+            scissor.cut(clipMinX, clipMinY, clipMaxX, clipMaxY);
+        }
+
+        auto &kernels = Kernels::get();
+
+        TriangleBounds bounds;
+
+        for (int i = begin; i < end; i += 4) {
+
+            auto numLanes = std::min(end - i, 4);
+
+            auto visibleMask = kernels.setupTriangles(state, i, numLanes, clipMinX, clipMinY, clipMaxX, clipMaxY, bounds);
+            if (visibleMask == 0) {
+
+                continue;
+            }
+
+            //
+            // Add the triangles into the corresponding bin(s)
+            //
+            for (int lane = 0; lane < numLanes; lane++) {
+
+                if ((visibleMask & (1 << lane)) == 0) {
+
+                    continue;
+                }
+
+                int binStartY = bounds.minY[lane] / m_binSize;
+                int binEndY = (bounds.maxY[lane] + m_binSize - 1) / m_binSize;
+                int binStartX = bounds.minX[lane] / m_binSize;
+                int binEndX = (bounds.maxX[lane] + m_binSize - 1) / m_binSize;
+
+                for (int y = binStartY; y < binEndY; y++) {
+
+                    int binMinY = y * m_binSize;
+                    int height = std::min(bounds.maxY[lane], binMinY + m_binSize) - std::max(bounds.minY[lane], binMinY);
+
+                    for (int x = binStartX; x < binEndX; x++) {
+
+                        int binMinX = x * m_binSize;
+                        int width = std::min(bounds.maxX[lane], binMinX + m_binSize) - std::max(bounds.minX[lane], binMinX);
+                        int idx = x + (y * m_numBinsX);
+
+                        bins.indices[idx].emplace_back(i + lane);
+                        bins.costs[idx] += CostModel::getTriangleCost(pixelCost, width * height);
+                    }
+                }
+            }
+        }
+    }
+
+    void Binner::mergeChunks(int numChunks, int beginBin, int endBin) {
+
+        for (int bin = beginBin; bin < endBin; bin++) {
+
+            auto &indices = m_bins.indices[bin];
+            auto numIndices = 0U;
+            auto cost = 0LL;
+
+            for (int chunk = 0; chunk < numChunks; chunk++) {
+
+                numIndices += static_cast<unsigned int>(m_chunks[chunk].indices[bin].size());
+                cost += m_chunks[chunk].costs[bin];
+            }
+
+            indices.reserve(numIndices);
+            for (int chunk = 0; chunk < numChunks; chunk++) {
+
+                auto &chunkIndices = m_chunks[chunk].indices[bin];
+                indices.insert(indices.end(), chunkIndices.begin(), chunkIndices.end());
+            }
+
+            m_bins.costs[bin] = cost;
+        }
+    }
+}
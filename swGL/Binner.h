@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <vector>
+#include "ThreadPool.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    struct TriangleDrawCallState;
+
+    //
+    // Sorts the triangles of a draw call into the bins (tiles) they overlap and
+    // estimates the cost of every bin. Large draw calls are split into chunks that
+    // are binned in parallel and merged afterwards, so the order of the triangles
+    // within a bin is always the order of the draw call.
+    //
+    class Binner {
+
+    public:
+        Binner(ThreadPool &threadPool);
+        ~Binner() = default;
+
+    public:
+        void binTriangles(TriangleDrawCallState &state, int numBinsX, int numBinsY, int binSize);
+
+        std::vector<int> &getIndices(int binIdx) { return m_bins.indices[binIdx]; }
+        long long getCost(int binIdx) const { return m_bins.costs[binIdx]; }
+
+    private:
+        struct BinSet {
+
+            std::vector<std::vector<int>> indices;
+            std::vector<long long> costs;
+        };
+
+        void resetBins(BinSet &bins);
+        void binChunk(TriangleDrawCallState &state, int pixelCost, int begin, int end, BinSet &bins);
+        void mergeChunks(int numChunks, int beginBin, int endBin);
+
+    private:
+        ThreadPool &m_threadPool;
+        BinSet m_bins;
+        std::vector<BinSet> m_chunks;
+
+    private:
+        int m_numBinsX;
+        int m_numBinsY;
+        int m_binSize;
+    };
+}
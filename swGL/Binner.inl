@@ -0,0 +1,212 @@
+﻿#pragma once
+
+#include <algorithm>
+#include "SIMD.h"
+#include "Triangle.h"
+#include "ContextTypes.h"
+#include "TextureManager.h"
+#include "CommandDrawTriangle.h"
+#include "Kernels.h"
+
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    // Loads an attribute of the vertices of four triangles. Afterwards the registers
+    // hold the (w, z, y, x) components of the four triangles.
+    template<typename Function>
+    static INLINED void loadAttribute(TriangleList &triangles, int first, int numLanes, QFloat (&rows)[4], Function getAttribute) {
+
+        for (int lane = 0; lane < 4; lane++) {
+
+            auto &t = triangles[first + SIMD::min(lane, numLanes - 1)];
+            rows[lane] = _mm_loadu_ps(&getAttribute(t)[0]);
+        }
+
+        _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+    }
+
+    static INLINED void setupEdgeEquation(int *edge, QInt x, QInt y, QInt dx, QInt dy) {
+
+        // Fill convention: edges going up, and horizontal edges going right, are
+        // biased by one (the mask is -1 for them)
+        QInt isNotTopLeft = _mm_or_si128(
+
+            _mm_cmplt_epi32(dy, _mm_setzero_si128()),
+            _mm_and_si128(_mm_cmpeq_epi32(dy, _mm_setzero_si128()), _mm_cmpgt_epi32(dx, _mm_setzero_si128()))
+        );
+
+        QInt value = _mm_sub_epi32(SIMD::multiply(dy, x), SIMD::multiply(dx, y));
+        _mm_store_si128(reinterpret_cast<QInt *>(edge), _mm_sub_epi32(value, isNotTopLeft));
+    }
+
+    //
+    // Sets up the edge and gradient equations of four triangles at once. The vertex
+    // positions are given as (w, z, y, x) registers.
+    //
+    static void setupEquations(TriangleDrawCallState &state, int first, int numLanes, QFloat (&v1)[4], QFloat (&v2)[4], QFloat (&v3)[4]) {
+
+        auto &setup = state.setup;
+
+        QFloat fdx21 = _mm_sub_ps(v2[3], v1[3]), fdy21 = _mm_sub_ps(v2[2], v1[2]);
+        QFloat fdx31 = _mm_sub_ps(v3[3], v1[3]), fdy31 = _mm_sub_ps(v3[2], v1[2]);
+        QFloat rcpArea = _mm_div_ps(
+
+            _mm_set1_ps(1.0f),
+            _mm_sub_ps(_mm_mul_ps(fdx21, fdy31), _mm_mul_ps(fdy21, fdx31))
+        );
+
+        //
+        // Fixed point positions, the vertices are ordered counter clockwise
+        //
+        const QFloat subPixelScale = _mm_set1_ps(16.0f);
+        QInt isCounterClockwise = _mm_castps_si128(_mm_cmplt_ps(rcpArea, _mm_setzero_ps()));
+
+        QInt x1 = _mm_cvttps_epi32(_mm_mul_ps(v1[3], subPixelScale));
+        QInt y1 = _mm_cvttps_epi32(_mm_mul_ps(v1[2], subPixelScale));
+        QInt vx2 = _mm_cvttps_epi32(_mm_mul_ps(v2[3], subPixelScale));
+        QInt vy2 = _mm_cvttps_epi32(_mm_mul_ps(v2[2], subPixelScale));
+        QInt vx3 = _mm_cvttps_epi32(_mm_mul_ps(v3[3], subPixelScale));
+        QInt vy3 = _mm_cvttps_epi32(_mm_mul_ps(v3[2], subPixelScale));
+
+        QInt x2 = SIMD::blend(vx3, vx2, isCounterClockwise);
+        QInt y2 = SIMD::blend(vy3, vy2, isCounterClockwise);
+        QInt x3 = SIMD::blend(vx2, vx3, isCounterClockwise);
+        QInt y3 = SIMD::blend(vy2, vy3, isCounterClockwise);
+
+        _mm_store_si128(reinterpret_cast<QInt *>(setup.getPosition(TriangleSetup::X1) + first), x1);
+        _mm_store_si128(reinterpret_cast<QInt *>(setup.getPosition(TriangleSetup::Y1) + first), y1);
+        _mm_store_si128(reinterpret_cast<QInt *>(setup.getPosition(TriangleSetup::X2) + first), x2);
+        _mm_store_si128(reinterpret_cast<QInt *>(setup.getPosition(TriangleSetup::Y2) + first), y2);
+        _mm_store_si128(reinterpret_cast<QInt *>(setup.getPosition(TriangleSetup::X3) + first), x3);
+        _mm_store_si128(reinterpret_cast<QInt *>(setup.getPosition(TriangleSetup::Y3) + first), y3);
+
+        setupEdgeEquation(setup.getPosition(TriangleSetup::Edge12) + first, x1, y1, _mm_sub_epi32(x1, x2), _mm_sub_epi32(y1, y2));
+        setupEdgeEquation(setup.getPosition(TriangleSetup::Edge23) + first, x2, y2, _mm_sub_epi32(x2, x3), _mm_sub_epi32(y2, y3));
+        setupEdgeEquation(setup.getPosition(TriangleSetup::Edge31) + first, x3, y3, _mm_sub_epi32(x3, x1), _mm_sub_epi32(y3, y1));
+
+        //
+        // Gradient equations
+        //
+        auto setupGradient = [&](int attribute, QFloat q1, QFloat q2, QFloat q3) {
+
+            QFloat dq21 = _mm_sub_ps(q2, q1);
+            QFloat dq31 = _mm_sub_ps(q3, q1);
+            QFloat dqdx = _mm_mul_ps(rcpArea, _mm_sub_ps(_mm_mul_ps(dq21, fdy31), _mm_mul_ps(dq31, fdy21)));
+            QFloat dqdy = _mm_mul_ps(rcpArea, _mm_sub_ps(_mm_mul_ps(dq31, fdx21), _mm_mul_ps(dq21, fdx31)));
+
+            // The value at the origin point
+            QFloat value = _mm_sub_ps(_mm_sub_ps(q1, _mm_mul_ps(v1[3], dqdx)), _mm_mul_ps(v1[2], dqdy));
+
+            _mm_store_ps(setup.getGradient(attribute, TriangleSetup::Value) + first, value);
+            _mm_store_ps(setup.getGradient(attribute, TriangleSetup::DX) + first, dqdx);
+            _mm_store_ps(setup.getGradient(attribute, TriangleSetup::DY) + first, dqdy);
+        };
+
+        setupGradient(TriangleSetup::Z, v1[1], v2[1], v3[1]);
+        setupGradient(TriangleSetup::RcpW, v1[0], v2[0], v3[0]);
+
+        QFloat c1[4], c2[4], c3[4];
+        loadAttribute(state.triangles, first, numLanes, c1, [](Triangle &t) -> Vector & { return t.v[0].colorPrimary; });
+        loadAttribute(state.triangles, first, numLanes, c2, [](Triangle &t) -> Vector & { return t.v[1].colorPrimary; });
+        loadAttribute(state.triangles, first, numLanes, c3, [](Triangle &t) -> Vector & { return t.v[2].colorPrimary; });
+
+        setupGradient(TriangleSetup::PrimaryA, c1[0], c2[0], c3[0]);
+        setupGradient(TriangleSetup::PrimaryR, c1[3], c2[3], c3[3]);
+        setupGradient(TriangleSetup::PrimaryG, c1[2], c2[2], c3[2]);
+        setupGradient(TriangleSetup::PrimaryB, c1[1], c2[1], c3[1]);
+
+        for (auto i = 0U; i < SWGL_MAX_TEXTURE_UNITS; i++) {
+
+            if (state.stateBlock->textures[i].texData == nullptr) {
+
+                continue;
+            }
+
+            QFloat t1[4], t2[4], t3[4];
+            loadAttribute(state.triangles, first, numLanes, t1, [i](Triangle &t) -> Vector & { return t.v[0].texCoord[i]; });
+            loadAttribute(state.triangles, first, numLanes, t2, [i](Triangle &t) -> Vector & { return t.v[1].texCoord[i]; });
+            loadAttribute(state.triangles, first, numLanes, t3, [i](Triangle &t) -> Vector & { return t.v[2].texCoord[i]; });
+
+            auto texCoord = state.setup.getTexCoord(i);
+            setupGradient(texCoord + 0, t1[3], t2[3], t3[3]);
+            setupGradient(texCoord + 1, t1[2], t2[2], t3[2]);
+            setupGradient(texCoord + 2, t1[1], t2[1], t3[1]);
+            setupGradient(texCoord + 3, t1[0], t2[0], t3[0]);
+        }
+    }
+
+
+
+    //
+    // Triangle setup kernel. Determines the bounding boxes of four triangles, which are
+    // cut against the clip rectangle, and sets up the triangles if any of them is visible.
+    // Returns the mask of the visible triangles.
+    //
+    static int setupTriangles(TriangleDrawCallState &state, int first, int numLanes, int clipMinX, int clipMinY, int clipMaxX, int clipMaxY, TriangleBounds &bounds) {
+
+        auto &triangles = state.triangles;
+
+        const QFloat subPixelScale = _mm_set1_ps(16.0f);
+        const QInt subPixelRound = _mm_set1_epi32(0x0f);
+        const QInt qClipMinX = _mm_set1_epi32(clipMinX);
+        const QInt qClipMinY = _mm_set1_epi32(clipMinY);
+        const QInt qClipMaxX = _mm_set1_epi32(clipMaxX);
+        const QInt qClipMaxY = _mm_set1_epi32(clipMaxY);
+
+        QFloat v1[4], v2[4], v3[4];
+
+        for (int lane = 0; lane < 4; lane++) {
+
+            // Unused lanes repeat the last triangle and are masked out below
+            auto &t = triangles[first + SIMD::min(lane, numLanes - 1)];
+
+            v1[lane] = _mm_loadu_ps(&t.v[0].posObj[0]);
+            v2[lane] = _mm_loadu_ps(&t.v[1].posObj[0]);
+            v3[lane] = _mm_loadu_ps(&t.v[2].posObj[0]);
+        }
+
+        // Vectors are stored as (w, z, y, x), so afterwards the last register holds the
+        // x and the one before the y coordinates
+        _MM_TRANSPOSE4_PS(v1[0], v1[1], v1[2], v1[3]);
+        _MM_TRANSPOSE4_PS(v2[0], v2[1], v2[2], v2[3]);
+        _MM_TRANSPOSE4_PS(v3[0], v3[1], v3[2], v3[3]);
+
+        auto toPixel = [&](QFloat value) {
+
+            return _mm_srai_epi32(_mm_add_epi32(_mm_cvttps_epi32(_mm_mul_ps(value, subPixelScale)), subPixelRound), 4);
+        };
+
+        QInt qMinX = toPixel(_mm_min_ps(_mm_min_ps(v1[3], v2[3]), v3[3]));
+        QInt qMaxX = toPixel(_mm_max_ps(_mm_max_ps(v1[3], v2[3]), v3[3]));
+        QInt qMinY = toPixel(_mm_min_ps(_mm_min_ps(v1[2], v2[2]), v3[2]));
+        QInt qMaxY = toPixel(_mm_max_ps(_mm_max_ps(v1[2], v2[2]), v3[2]));
+
+        qMinX = SIMD::max(qMinX, qClipMinX);
+        qMinY = SIMD::max(qMinY, qClipMinY);
+        qMaxX = SIMD::min(qMaxX, qClipMaxX);
+        qMaxY = SIMD::min(qMaxY, qClipMaxY);
+
+        // Don't bother to bin triangles that have a zero sized bounding box
+        auto visibleMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+
+            _mm_cmplt_epi32(qMinX, qMaxX),
+            _mm_cmplt_epi32(qMinY, qMaxY)
+        ))) & ((1 << numLanes) - 1);
+
+        if (visibleMask == 0) {
+
+            return 0;
+        }
+
+        setupEquations(state, first, numLanes, v1, v2, v3);
+
+        _mm_store_si128(reinterpret_cast<QInt *>(bounds.minX), qMinX);
+        _mm_store_si128(reinterpret_cast<QInt *>(bounds.minY), qMinY);
+        _mm_store_si128(reinterpret_cast<QInt *>(bounds.maxX), qMaxX);
+        _mm_store_si128(reinterpret_cast<QInt *>(bounds.maxY), qMaxY);
+
+        return visibleMask;
+    }
+}
+}
@@ -32,7 +32,22 @@ namespace SWGL {
 
         std::vector<Triangle> outputList;
 
-        for (auto &t : triangles) {
+        clipTriangles(triangles.data(), triangles.data() + triangles.size(), outputList);
+
+        if (!outputList.empty()) {
+
+            triangles = std::move(outputList);
+            return true;
+        }
+
+        return false;
+    }
+
+    void Clipper::clipTriangles(Triangle *first, Triangle *last, TriangleList &out) {
+
+        for (auto it = first; it != last; it++) {
+
+            auto &t = *it;
 
             // Generate the Sutherland-Hodgman style clipcodes to determine if the
             // triangle must be clipped against a plane of the view frustum.
@@ -80,24 +95,16 @@ namespace SWGL {
 
                     // The triangle is completely inside the view frustum and the user
                     // defined clipping planes
-                    outputList.emplace_back(t);
+                    out.emplace_back(t);
                 }
                 else {
                     
                     // The triangle is partially outside the view frustum or one of
                     // the user defined clipping planes and must be clipped
-                    clipTriangle(t, clipOr, outputList);
+                    clipTriangle(t, clipOr, out);
                 }
             }
         }
-
-        if (!outputList.empty()) {
-
-            triangles = std::move(outputList);
-            return true;
-        }
-
-        return false;
     }
 
     void Clipper::clipTriangle(Triangle &t, unsigned int clipcode, TriangleList &out) {
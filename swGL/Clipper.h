@@ -13,6 +13,7 @@ namespace SWGL {
 
     public:
         bool clipTriangles(TriangleList &triangles);
+        void clipTriangles(Triangle *first, Triangle *last, TriangleList &out);
 
     private:
         void clipTriangle(Triangle &t, unsigned int clipcode, TriangleList &out);
@@ -0,0 +1,126 @@
+﻿#pragma once
+
+#include <type_traits>
+#include "Defines.h"
+#include "Triangle.h"
+#include "ContextTypes.h"
+#include "TextureManager.h"
+#include "CommandClearColor.h"
+#include "CommandClearDepth.h"
+#include "CommandDrawTriangle.h"
+#include "CommandSynchronize.h"
+#include "CommandPresent.h"
+
+namespace SWGL {
+
+    //
+    // Types of the draw commands
+    //
+    enum class CommandType : unsigned char {
+
+        ClearColor,
+        ClearDepth,
+        DrawTriangle,
+        Synchronize,
+        Present
+    };
+
+    //
+    // Compact, tagged encoding of a draw command. The commands are stored by value
+    // in the command queues of the tiles and everything they refer to lives in the
+    // command arena of the frame, so issuing a command doesn't allocate anything.
+    //
+    class Command {
+
+    public:
+        Command() {}
+
+        Command(const CommandClearColor &command, long long workloadEstimate)
+
+            : m_type(CommandType::ClearColor),
+              m_workloadEstimate(workloadEstimate),
+              m_clearColor(command) {
+
+        }
+
+        Command(const CommandClearDepth &command, long long workloadEstimate)
+
+            : m_type(CommandType::ClearDepth),
+              m_workloadEstimate(workloadEstimate),
+              m_clearDepth(command) {
+
+        }
+
+        Command(const CommandDrawTriangle &command, long long workloadEstimate)
+
+            : m_type(CommandType::DrawTriangle),
+              m_workloadEstimate(workloadEstimate),
+              m_drawTriangle(command) {
+
+        }
+
+        Command(const CommandSynchronize &command)
+
+            : m_type(CommandType::Synchronize),
+              m_workloadEstimate(0),
+              m_synchronize(command) {
+
+        }
+
+        Command(const CommandPresent &command)
+
+            : m_type(CommandType::Present),
+              m_workloadEstimate(0),
+              m_present(command) {
+
+        }
+
+    public:
+        CommandType getType() const { return m_type; }
+
+        // Estimated cost of the command in the units of the CostModel
+        long long getWorkLoadEstimate() const { return m_workloadEstimate; }
+
+        bool isFlushingQueue() const {
+
+            return m_type == CommandType::Synchronize ||
+                   m_type == CommandType::Present;
+        }
+
+        // Draws of the visibility pass leave the shading to the next other command
+        bool isVisibilityPass() const {
+
+            return m_type == CommandType::DrawTriangle &&
+                   m_drawTriangle.isVisibilityPass();
+        }
+
+        INLINED bool execute(DrawThread *thread) {
+
+            switch (m_type) {
+
+                case CommandType::ClearColor: return m_clearColor.execute(thread);
+                case CommandType::ClearDepth: return m_clearDepth.execute(thread);
+                case CommandType::DrawTriangle: return m_drawTriangle.execute(thread);
+                case CommandType::Synchronize: return m_synchronize.execute(thread);
+                case CommandType::Present: return m_present.execute(thread);
+            }
+
+            return false;
+        }
+
+    private:
+        CommandType m_type;
+        long long m_workloadEstimate;
+
+        union {
+
+            CommandClearColor m_clearColor;
+            CommandClearDepth m_clearDepth;
+            CommandDrawTriangle m_drawTriangle;
+            CommandSynchronize m_synchronize;
+            CommandPresent m_present;
+        };
+    };
+
+    static_assert(std::is_trivially_copyable<Command>::value, "Commands have to be trivially copyable");
+}
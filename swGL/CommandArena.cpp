@@ -0,0 +1,69 @@
+﻿#include <algorithm>
+#include "Statistics.h"
+#include "CommandArena.h"
+
+namespace SWGL {
+
+    // Every allocation is aligned to this
+    static constexpr size_t ARENA_ALIGNMENT = 16U;
+
+
+
+    CommandArena::CommandArena()
+
+        : m_currentBlock(0),
+          m_offset(0) {
+
+    }
+
+    CommandArena::~CommandArena() {
+
+        reset();
+    }
+
+
+
+    void CommandArena::reset() {
+
+        // Objects are destroyed in reverse order of their creation
+        for (auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it) {
+
+            it->first(it->second);
+        }
+
+        m_destructors.clear();
+        m_currentBlock = 0;
+        m_offset = 0;
+    }
+
+    void *CommandArena::allocate(size_t size) {
+
+        size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+        STATISTICS_ADD(ARENA_BYTES, static_cast<long long>(size));
+
+        // Go on with the next block if the current one is full
+        while (m_currentBlock < m_blocks.size()) {
+
+            auto &block = m_blocks[m_currentBlock];
+            if (m_offset + size <= block.size()) {
+
+                auto ptr = block.data() + m_offset;
+                m_offset += size;
+                return ptr;
+            }
+
+            m_currentBlock++;
+            m_offset = 0;
+        }
+
+        // Out of memory, allocate a new block (which is large enough for huge allocations)
+        STATISTICS_ADD(ARENA_BLOCK_ALLOCATIONS, 1);
+
+        m_blocks.emplace_back(std::max(size, static_cast<size_t>(SWGL_COMMAND_ARENA_BLOCK_SIZE)));
+        m_currentBlock = static_cast<unsigned int>(m_blocks.size()) - 1;
+        m_offset = size;
+
+        return m_blocks.back().data();
+    }
+}
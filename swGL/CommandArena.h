@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "Defines.h"
+#include "DrawBuffer.h"
+
+namespace SWGL {
+
+    //
+    // Linear allocator for the data the commands of one frame refer to (draw call
+    // states, triangle indices). Everything is released at once when the frame has
+    // been presented and the arena gets reset. The memory blocks are kept, so after
+    // the first few frames no memory gets allocated anymore.
+    //
+    class CommandArena {
+
+    public:
+        CommandArena();
+        ~CommandArena();
+
+        CommandArena(const CommandArena &) = delete;
+        CommandArena &operator=(const CommandArena &) = delete;
+
+    public:
+        void reset();
+        void *allocate(size_t size);
+
+        template<typename T>
+        T *allocateArray(int count) {
+
+            static_assert(std::is_trivially_destructible<T>::value, "Arrays in the command arena have to be trivially destructible");
+            return static_cast<T *>(allocate(sizeof(T) * count));
+        }
+
+        template<typename T, typename... Args>
+        T *create(Args &&... args) {
+
+            auto object = new (allocate(sizeof(T))) T(std::forward<Args>(args)...);
+
+            if (!std::is_trivially_destructible<T>::value) {
+
+                m_destructors.emplace_back(&destroy<T>, object);
+            }
+
+            return object;
+        }
+
+    private:
+        template<typename T>
+        static void destroy(void *object) {
+
+            static_cast<T *>(object)->~T();
+        }
+
+    private:
+        using Block = BufferType<unsigned char>;
+        using Destructor = std::pair<void (*)(void *), void *>;
+
+        std::vector<Block> m_blocks;
+        std::vector<Destructor> m_destructors;
+        unsigned int m_currentBlock;
+        size_t m_offset;
+    };
+}
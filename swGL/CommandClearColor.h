@@ -1,13 +1,16 @@
 ﻿#pragma once
 
-#include "CommandBase.h"
+#include "Defines.h"
 
 namespace SWGL {
 
+    // Forward declarations
+    class DrawThread;
+
     //
     // Clears the color buffer with a specific color
     //
-    class CommandClearColor : public CommandBase {
+    class CommandClearColor {
 
     public:
         CommandClearColor(unsigned int value, int minX, int minY, int maxX, int maxY)
@@ -22,7 +25,7 @@ namespace SWGL {
         ~CommandClearColor() = default;
 
     public:
-        bool execute(DrawThread *thread) override;
+        bool execute(DrawThread *thread);
 
     private:
         unsigned int m_value;
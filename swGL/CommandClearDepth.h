@@ -1,13 +1,16 @@
 ﻿#pragma once
 
-#include "CommandBase.h"
+#include "Defines.h"
 
 namespace SWGL {
 
+    // Forward declarations
+    class DrawThread;
+
     //
     // Clears the depth buffer with a specific depth value
     //
-    class CommandClearDepth : public CommandBase {
+    class CommandClearDepth {
 
     public:
         CommandClearDepth(unsigned int value, int minX, int minY, int maxX, int maxY)
@@ -22,7 +25,7 @@ namespace SWGL {
         ~CommandClearDepth() = default;
 
     public:
-        bool execute(DrawThread *thread) override;
+        bool execute(DrawThread *thread);
 
     private:
         unsigned int m_value;
@@ -1,60 +1,106 @@
 ﻿#pragma once
 
-#include "CommandBase.h"
+#include <vector>
+#include "Defines.h"
+#include "DrawStateCache.h"
 
 namespace SWGL {
 
+    // Forward declarations
+    class DrawThread;
+    class CommandArena;
+
+    //
+    // The setup of the triangles of a draw call, which is done once while binning
+    // and is shared by all tiles a triangle overlaps. The data is stored as
+    // structure of arrays, so four triangles can be set up at once. It lives in the
+    // command arena of the frame and only has room for the texture coordinates of
+    // the bound texture units.
+    //
+    struct TriangleSetup {
+
+        // The interpolated attributes
+        enum Attribute : int {
+
+            Z,
+            RcpW,
+            PrimaryA,
+            PrimaryR,
+            PrimaryG,
+            PrimaryB,
+            TexCoord,   // S, T, R and Q of every texture unit
+            NumAttributes = TexCoord + 4 * SWGL_MAX_TEXTURE_UNITS
+        };
+
+        // The gradient equation of an attribute is value + (x * dx) + (y * dy)
+        enum Component : int {
+
+            Value,
+            DX,
+            DY,
+            NumComponents
+        };
+
+        // The 28.4 fixed point positions of the (counter clockwise) vertices and the
+        // constant parts of the edge equations
+        enum Position : int {
+
+            X1, Y1,
+            X2, Y2,
+            X3, Y3,
+            Edge12, Edge23, Edge31,
+            NumPositions
+        };
+
+        // The memory is left uninitialized, the kernels write everything they read
+        void allocate(CommandArena &arena, const DrawStateBlock &stateBlock, int numTriangles);
+
+        float *getGradient(int attribute, int component) { return gradients + (attribute * NumComponents + component) * stride; }
+        int *getPosition(int position) { return positions + position * stride; }
+
+        // The attribute of the S coordinate of a (bound) texture unit, T, R and Q follow
+        int getTexCoord(unsigned int texUnit) const { return texCoords[texUnit]; }
+
+        int stride = 0;
+        int texCoords[SWGL_MAX_TEXTURE_UNITS] = {};
+        float *gradients = nullptr;
+        int *positions = nullptr;
+    };
+
     //
-    // The state that is needed in order to rasterize and shade triangles
+    // The triangles of a draw call and the state that is needed in order to
+    // rasterize and shade them
     //
     struct TriangleDrawCallState {
 
         TriangleList triangles;
-
-        Scissor scissor;
-        PolygonOffset polygonOffset;
-        DepthTesting depthTesting;
-        AlphaTesting alphaTesting;
-        Blending blending;
-        ColorMask colorMask;
-        bool deferedDepthWrite;
-
-        struct TextureState {
-
-            TextureDataPtr texData;
-            TextureParameter texParams;
-            TextureEnvironment texEnv;
-
-        } textures[SWGL_MAX_TEXTURE_UNITS];
+        TriangleSetup setup;
+        DrawStateBlock *stateBlock = nullptr;
     };
 
-    using TriangleDrawCallStatePtr = std::shared_ptr<TriangleDrawCallState>;
-
     //
     // Draw triangle(s) command
     //
-    class CommandDrawTriangle : public CommandBase {
+    class CommandDrawTriangle {
 
     public:
-        CommandDrawTriangle(TriangleDrawCallStatePtr state, std::vector<int> &indices)
+        CommandDrawTriangle(TriangleDrawCallState *state, const int *indices, int numIndices)
 
             : m_state(state),
-              m_indices(std::move(indices)) {
+              m_indices(indices),
+              m_numIndices(numIndices) {
 
         }
         ~CommandDrawTriangle() = default;
 
     public:
-        int getWorkLoadEstimate() {
-
-            // TODO: This really isn't a good estimation, but better than nothing :)
-            return m_indices.size();
-        }
+        bool execute(DrawThread *thread);
 
-        bool execute(DrawThread *thread) override;
+        bool isVisibilityPass() const { return m_state->stateBlock->isVisibilityPass; }
 
     private:
-        TriangleDrawCallStatePtr m_state;
-        std::vector<int> m_indices;
+        TriangleDrawCallState *m_state;
+        const int *m_indices;
+        int m_numIndices;
     };
 }
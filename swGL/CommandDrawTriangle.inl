@@ -0,0 +1,777 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include "DrawBuffer.h"
+#include "ContextTypes.h"
+#include "SIMD.h"
+#include "OpenGL.h"
+#include "Triangle.h"
+#include "TextureManager.h"
+#include "TextureSampler.inl"
+#include "DrawBuffer.inl"
+#include "CommandDrawTriangle.h"
+#include "Rasterizer.inl"
+
+#if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2
+#include "CommandDrawTriangleAVX2.inl"
+#endif
+
+#define GRADIENT_VALUE(NAME) \
+    qV ## NAME
+
+#define GRADIENT_DX(NAME) \
+    qDX ## NAME
+
+#define GRADIENT_DY(NAME) \
+    qDY ## NAME
+
+#define DEFINE_GRADIENT(NAME) \
+    QFloat GRADIENT_VALUE(NAME), GRADIENT_DX(NAME), GRADIENT_DY(NAME)
+
+#define LOAD_GRADIENT_EQ(NAME, ATTRIBUTE) \
+    loadGradientEquation(GRADIENT_VALUE(NAME), GRADIENT_DX(NAME), GRADIENT_DY(NAME), setup, ATTRIBUTE, triangleIdx)
+
+#define GET_GRADIENT_VALUE_AFFINE(NAME) \
+    _mm_add_ps(qV ## NAME, _mm_add_ps(_mm_mul_ps(xxxx, GRADIENT_DX(NAME)), _mm_mul_ps(yyyy, GRADIENT_DY(NAME))))
+
+#define GET_GRADIENT_VALUE_PERSP(NAME) \
+    _mm_mul_ps(w, GET_GRADIENT_VALUE_AFFINE(NAME))
+
+
+
+//
+// TODO: Find the cause of dropped fragments as there are cracks between adjacent triangles.
+//       It is very obvious in Unreal Tournament's map CTF-LavaGiant.
+//
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    static INLINED QInt getIntegerRGBA(ARGBColor &color) {
+
+        const QFloat cMin = _mm_setzero_ps();
+        const QFloat cMax = _mm_set1_ps(255.0f);
+
+        // Scale floating point color values
+        QFloat a = _mm_mul_ps(color.a, cMax);
+        QFloat r = _mm_mul_ps(color.r, cMax);
+        QFloat g = _mm_mul_ps(color.g, cMax);
+        QFloat b = _mm_mul_ps(color.b, cMax);
+
+        // Clamp the values between [0,255]
+        a = SIMD::clamp(a, cMin, cMax);
+        r = SIMD::clamp(r, cMin, cMax);
+        g = SIMD::clamp(g, cMin, cMax);
+        b = SIMD::clamp(b, cMin, cMax);
+
+        // Build result
+        QInt resA = _mm_slli_epi32(_mm_cvtps_epi32(a), 24);
+        QInt resR = _mm_slli_epi32(_mm_cvtps_epi32(r), 16);
+        QInt resG = _mm_slli_epi32(_mm_cvtps_epi32(g), 8);
+        QInt resB = _mm_cvtps_epi32(b);
+
+        return _mm_or_si128(
+
+            _mm_or_si128(resA, resR),
+            _mm_or_si128(resG, resB)
+        );
+    }
+
+    static INLINED void loadGradientEquation(QFloat &qVAL, QFloat &qDQDX, QFloat &qDQDY, TriangleSetup &setup, int attribute, int triangleIdx) {
+
+        // The triangle setup holds the interpolant value at the origin point
+        float value = setup.getGradient(attribute, TriangleSetup::Value)[triangleIdx];
+        float dqdx = setup.getGradient(attribute, TriangleSetup::DX)[triangleIdx];
+        float dqdy = setup.getGradient(attribute, TriangleSetup::DY)[triangleIdx];
+
+        qDQDX = _mm_set1_ps(dqdx);
+        qDQDY = _mm_set1_ps(dqdy);
+        qVAL = _mm_set_ps(
+
+            value + dqdy + dqdx,
+            value + dqdy,
+            value + dqdx,
+            value
+        );
+    }
+
+    static void setupEdgeEquation(EdgeEquation &eq, QInt &eVAL, QInt &eDEDX, int edge, int dx, int dy, int minX, int minY) {
+
+        eq = EdgeEquation(edge, dx, dy, minX, minY);
+
+        // Offsets of the pixels within a quad
+        eDEDX = _mm_set1_epi32(eq.dedx << 1);
+        eVAL = _mm_set_epi32(
+
+            eq.dedy + eq.dedx,
+            eq.dedy,
+            eq.dedx,
+            0
+        );
+    }
+
+
+
+    // 2D textures are sampled by the kernel itself, the other targets go through the
+    // samplers of TextureSampler.cpp
+    static INLINED void sampleTexture(DrawStateBlock::TextureState &texState, TextureCoordinates &texCoords, ARGBColor &colorOut) {
+
+        if (texState.target == GL_TEXTURE_2D) {
+
+            sample2D(static_cast<TextureData2D &>(*texState.texData), texState.texParams, texCoords, colorOut);
+        }
+        else {
+
+            texState.texData->sampleTexels(texState.texParams, texCoords, colorOut);
+        }
+    }
+
+
+
+    //
+    // Draw triangle kernel. The raster operations are template parameters, so the kernels
+    // of the common states don't branch on them for every quad. Parameters which are
+    // RASTER_OP_RUNTIME are read from the state block instead.
+    //
+    template<GLenum DepthFunc, GLenum DepthWrite, GLenum AlphaFunc, GLenum BlendSrc, GLenum BlendDst>
+    static bool drawTriangles(TriangleDrawCallState &state, const int *indices, int numIndices, DrawBuffer &drawBuffer) {
+
+        auto &stateBlock = *state.stateBlock;
+
+    #if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2
+        // The two quads of a pair have to be next to each other in the buffer, so the
+        // rows of the tile must hold an even number of quads
+        if (stateBlock.isPairShadingSupported && (drawBuffer.getWidth() & 3) == 0) {
+
+            return drawTrianglePairs<DepthFunc, DepthWrite, AlphaFunc, BlendSrc, BlendDst>(state, indices, numIndices, drawBuffer);
+        }
+    #endif
+
+        auto &scissor = stateBlock.scissor;
+        auto &polygonOffset = stateBlock.polygonOffset;
+        auto &colorMask = stateBlock.colorMask;
+        auto &textureState = stateBlock.textures;
+        auto &setup = state.setup;
+
+        // The raster operations are constants unless this is the generic kernel
+        auto &rasterOps = stateBlock.rasterOps;
+        const GLenum depthFunc = resolveRasterOp<DepthFunc>(rasterOps.depthFunc);
+        const GLenum depthWrite = resolveRasterOp<DepthWrite>(rasterOps.depthWrite);
+        const GLenum alphaFunc = resolveRasterOp<AlphaFunc>(rasterOps.alphaFunc);
+        const GLenum blendSrc = resolveRasterOp<BlendSrc>(rasterOps.blendSrc);
+        const GLenum blendDst = resolveRasterOp<BlendDst>(rasterOps.blendDst);
+        const bool isBlendingEnabled = blendSrc != GL_ONE || blendDst != GL_ZERO;
+
+        // With alpha testing the depth write is defered until the alpha test is done
+        const bool writeDepthAfterAlphaTest = depthWrite == GL_TRUE && alphaFunc != GL_NONE;
+        const bool writeDepthAfterDepthTest = depthWrite == GL_TRUE && alphaFunc == GL_NONE;
+
+        for (int indexIdx = 0; indexIdx < numIndices; indexIdx++) {
+
+            auto triangleIdx = indices[indexIdx];
+
+            //
+            // Get the fixed point coordinates from the triangle setup
+            //
+            int x1 = setup.getPosition(TriangleSetup::X1)[triangleIdx];
+            int y1 = setup.getPosition(TriangleSetup::Y1)[triangleIdx];
+            int x2 = setup.getPosition(TriangleSetup::X2)[triangleIdx];
+            int y2 = setup.getPosition(TriangleSetup::Y2)[triangleIdx];
+            int x3 = setup.getPosition(TriangleSetup::X3)[triangleIdx];
+            int y3 = setup.getPosition(TriangleSetup::Y3)[triangleIdx];
+
+            //
+            // Determine triangle bounding box with respect to our rendertarget
+            //
+            int minY = SIMD::max((SIMD::min(y1, SIMD::min(y2, y3)) + 0x0f) >> 4, drawBuffer.getMinY());
+            int maxY = SIMD::min((SIMD::max(y1, SIMD::max(y2, y3)) + 0x0f) >> 4, drawBuffer.getMaxY());
+            int minX = SIMD::max((SIMD::min(x1, SIMD::min(x2, x3)) + 0x0f) >> 4, drawBuffer.getMinX());
+            int maxX = SIMD::min((SIMD::max(x1, SIMD::max(x2, x3)) + 0x0f) >> 4, drawBuffer.getMaxX());
+
+            if (scissor.isEnabled()) {
+
+                // TODO: I don't think that scissoring works correctly if the coordinates
+                //       are uneven. An example would be minXY=(1, 1) and maxXY=(7, 7)
+                scissor.cut(minX, minY, maxX, maxY);
+            }
+
+            // Make sure that we rasterize at the beginning of a quad (which is 2x2 pixel)
+            minX &= ~1;
+            minY &= ~1;
+
+
+            //
+            // Determine the triangle edge equations
+            //
+            int dx12 = x1 - x2, dx23 = x2 - x3, dx31 = x3 - x1;
+            int dy12 = y1 - y2, dy23 = y2 - y3, dy31 = y3 - y1;
+
+            EdgeEquation edges[3];
+            QInt quadEdgeValue[3], edgeDX[3];
+            setupEdgeEquation(edges[0], quadEdgeValue[0], edgeDX[0], setup.getPosition(TriangleSetup::Edge12)[triangleIdx], dx12, dy12, minX, minY);
+            setupEdgeEquation(edges[1], quadEdgeValue[1], edgeDX[1], setup.getPosition(TriangleSetup::Edge23)[triangleIdx], dx23, dy23, minX, minY);
+            setupEdgeEquation(edges[2], quadEdgeValue[2], edgeDX[2], setup.getPosition(TriangleSetup::Edge31)[triangleIdx], dx31, dy31, minX, minY);
+
+            //
+            // Get the gradient equations from the triangle setup
+            //
+            DEFINE_GRADIENT(z);
+            LOAD_GRADIENT_EQ(z, TriangleSetup::Z);
+
+            DEFINE_GRADIENT(rcpW);
+            LOAD_GRADIENT_EQ(rcpW, TriangleSetup::RcpW);
+
+            DEFINE_GRADIENT(primaryA);
+            LOAD_GRADIENT_EQ(primaryA, TriangleSetup::PrimaryA);
+            DEFINE_GRADIENT(primaryR);
+            LOAD_GRADIENT_EQ(primaryR, TriangleSetup::PrimaryR);
+            DEFINE_GRADIENT(primaryG);
+            LOAD_GRADIENT_EQ(primaryG, TriangleSetup::PrimaryG);
+            DEFINE_GRADIENT(primaryB);
+            LOAD_GRADIENT_EQ(primaryB, TriangleSetup::PrimaryB);
+
+            DEFINE_GRADIENT(texS[SWGL_MAX_TEXTURE_UNITS]);
+            DEFINE_GRADIENT(texT[SWGL_MAX_TEXTURE_UNITS]);
+            DEFINE_GRADIENT(texR[SWGL_MAX_TEXTURE_UNITS]);
+            DEFINE_GRADIENT(texQ[SWGL_MAX_TEXTURE_UNITS]);
+            for (auto i = 0U; i < SWGL_MAX_TEXTURE_UNITS; i++) {
+
+                // Units without a texture aren't set up
+                if (textureState[i].texData == nullptr) {
+
+                    continue;
+                }
+
+                auto texCoord = setup.getTexCoord(i);
+                LOAD_GRADIENT_EQ(texS[i], texCoord + 0);
+                LOAD_GRADIENT_EQ(texT[i], texCoord + 1);
+                LOAD_GRADIENT_EQ(texR[i], texCoord + 2);
+                LOAD_GRADIENT_EQ(texQ[i], texCoord + 3);
+            }
+
+            //
+            // Calculate polygon offset (see page 77, glspec13.pdf)
+            //
+            if (polygonOffset.isFillEnabled()) {
+
+                QFloat m = _mm_max_ps(
+
+                    SIMD::absolute(GRADIENT_DX(z)),
+                    SIMD::absolute(GRADIENT_DY(z))
+                );
+
+                QFloat zOffset = SIMD::multiplyAdd(
+
+                    m,
+                    _mm_set1_ps(stateBlock.polygonOffsetFactor),
+                    _mm_set1_ps(stateBlock.polygonOffsetRTimesUnits)
+                );
+
+                GRADIENT_VALUE(z) = _mm_add_ps(GRADIENT_VALUE(z), zOffset);
+            }
+
+
+            //
+            // Hierarchical depth test, triangles behind the contents of the tile are
+            // rejected as a whole
+            //
+            DepthPlane depthPlane = {};
+
+            if (depthFunc != GL_NONE) {
+
+                depthPlane.value = _mm_cvtss_f32(GRADIENT_VALUE(z));
+                depthPlane.dzdx = _mm_cvtss_f32(GRADIENT_DX(z));
+                depthPlane.dzdy = _mm_cvtss_f32(GRADIENT_DY(z));
+
+                if (isDepthTestFailing(depthFunc, depthPlane.getBounds(minX, minY, maxX, maxY), drawBuffer.getTileDepthBounds())) {
+
+                    continue;
+                }
+            }
+
+
+            //
+            // Rasterize and shade the triangle
+            //
+            ARGBColor srcColor;
+            ARGBColor texColor;
+            ARGBColor primaryColor;
+            TextureCoordinates texCoords;
+
+            // The bounding box is walked block by block. Blocks outside of the triangle or
+            // behind the depth bounds of the block are skipped as a whole, and the quads of
+            // blocks inside of the triangle are shaded without testing the edges. The blocks
+            // are aligned to the tile like the depth bounds.
+            int gridMinX = minX - ((minX - drawBuffer.getMinX()) % SWGL_RASTER_BLOCK_SIZE);
+            int gridMinY = minY - ((minY - drawBuffer.getMinY()) % SWGL_RASTER_BLOCK_SIZE);
+
+            for (int blockY = gridMinY; blockY < maxY; blockY += SWGL_RASTER_BLOCK_SIZE) {
+
+                int firstY = SIMD::max(blockY, minY);
+                int blockMaxY = SIMD::min(blockY + SWGL_RASTER_BLOCK_SIZE, maxY);
+
+                for (int blockX = gridMinX; blockX < maxX; blockX += SWGL_RASTER_BLOCK_SIZE) {
+
+                    int firstX = SIMD::max(blockX, minX);
+                    int blockMaxX = SIMD::min(blockX + SWGL_RASTER_BLOCK_SIZE, maxX);
+
+                    // The last pixel which is touched by the quads of the block
+                    int lastX = firstX + ((1 + (blockMaxX - firstX)) & ~1) - 1;
+                    int lastY = firstY + ((1 + (blockMaxY - firstY)) & ~1) - 1;
+
+                    auto coverage = testBlockCoverage(edges, firstX - minX, firstY - minY, lastX - minX, lastY - minY);
+                    if (coverage == BlockCoverage::Empty) {
+
+                        continue;
+                    }
+
+                    if (depthFunc != GL_NONE &&
+                        isDepthTestFailing(depthFunc, depthPlane.getBounds(firstX, firstY, lastX, lastY), drawBuffer.getDepthBounds(blockX, blockY))) {
+
+                        continue;
+                    }
+
+                    bool isDepthWritten = false;
+
+                    for (int y = firstY; y < blockMaxY; y += 2) {
+
+                        QFloat yyyy = _mm_set1_ps(static_cast<float>(y));
+
+                        // Edge equation values at the first quad of the row
+                        QInt edgeValue[3];
+                        for (int i = 0; i < 3; i++) {
+
+                            edgeValue[i] = _mm_add_epi32(quadEdgeValue[i], _mm_set1_epi32(edges[i].evaluate(firstX - minX, y - minY)));
+                        }
+
+                        ptrdiff_t bufferOffset = ((firstX - drawBuffer.getMinX()) << 1) + ((y - drawBuffer.getMinY()) * drawBuffer.getWidth());
+                        auto colorBuffer = drawBuffer.getColor() + bufferOffset;
+                        auto depthBuffer = drawBuffer.getDepth() + bufferOffset;
+
+                        for (int x = firstX; x < blockMaxX; x += 2) {
+
+                            //
+                            // Coverage test for a 2x2 pixel quad, fully covered blocks don't need it
+                            //
+                            QInt fragmentMask = _mm_set1_epi32(-1);
+
+                            if (coverage == BlockCoverage::Partial) {
+
+                                QInt e0 = _mm_cmpgt_epi32(edgeValue[0], _mm_setzero_si128());
+                                QInt e1 = _mm_cmpgt_epi32(edgeValue[1], _mm_setzero_si128());
+                                QInt e2 = _mm_cmpgt_epi32(edgeValue[2], _mm_setzero_si128());
+                                fragmentMask = _mm_and_si128(_mm_and_si128(e0, e1), e2);
+                            }
+
+                            if (!SIMD::isZero(fragmentMask)) {
+
+                                QFloat xxxx = _mm_set1_ps(static_cast<float>(x));
+
+
+                                //
+                                // (Early) Depth test
+                                //
+                                QInt depthBufferZ, currentZ;
+
+                                if (depthFunc != GL_NONE) {
+
+                                    depthBufferZ = _mm_load_si128(reinterpret_cast<QInt *>(depthBuffer));
+                                    currentZ = _mm_cvtps_epi32(
+                                        _mm_mul_ps(
+                                            _mm_set1_ps(16777215.0f),
+                                            SIMD::clamp01(GET_GRADIENT_VALUE_AFFINE(z))
+                                        )
+                                    );
+
+                                    switch (depthFunc) {
+
+                                    case GL_NEVER: goto nextQuad;
+                                    case GL_LESS: fragmentMask = _mm_and_si128(_mm_cmplt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_EQUAL: fragmentMask = _mm_and_si128(_mm_cmpeq_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_LEQUAL: fragmentMask = _mm_andnot_si128(_mm_cmpgt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_GREATER: fragmentMask = _mm_and_si128(_mm_cmpgt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_NOTEQUAL: fragmentMask = _mm_andnot_si128(_mm_cmpeq_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_GEQUAL: fragmentMask = _mm_andnot_si128(_mm_cmplt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    }
+
+                                    // Check if any fragment survived the depth test
+                                    if (SIMD::isZero(fragmentMask)) {
+
+                                        goto nextQuad;
+                                    }
+
+                                    // Write the new depth values to the depth buffer
+                                    if (writeDepthAfterDepthTest) {
+
+                                        _mm_store_si128(
+
+                                            reinterpret_cast<QInt *>(depthBuffer),
+                                            SIMD::blend(depthBufferZ, currentZ, fragmentMask)
+                                        );
+                                        isDepthWritten = true;
+                                    }
+                                }
+
+
+                                //
+                                // Calculate perspective w
+                                //
+                                QFloat w = _mm_div_ps(_mm_set1_ps(1.0f), GET_GRADIENT_VALUE_AFFINE(rcpW));
+
+
+                                //
+                                // Set the fragments initial color
+                                //
+                                primaryColor.a = GET_GRADIENT_VALUE_PERSP(primaryA);
+                                primaryColor.r = GET_GRADIENT_VALUE_PERSP(primaryR);
+                                primaryColor.g = GET_GRADIENT_VALUE_PERSP(primaryG);
+                                primaryColor.b = GET_GRADIENT_VALUE_PERSP(primaryB);
+
+
+                                //
+                                // Texture sampling and blending for each active texture unit
+                                //
+                                srcColor = primaryColor;
+
+                                for (auto texUnit = 0U; texUnit < SWGL_MAX_TEXTURE_UNITS; texUnit++) {
+
+                                    auto &texState = textureState[texUnit];
+                                    if (texState.texData == nullptr) {
+
+                                        continue;
+                                    }
+
+                                    // Get texture sample
+                                    QFloat rcpQ = _mm_div_ps(_mm_set1_ps(1.0f), GET_GRADIENT_VALUE_AFFINE(texQ[texUnit]));
+                                    texCoords.s = _mm_mul_ps(rcpQ, GET_GRADIENT_VALUE_AFFINE(texS[texUnit]));
+                                    texCoords.t = _mm_mul_ps(rcpQ, GET_GRADIENT_VALUE_AFFINE(texT[texUnit]));
+                                    texCoords.r = _mm_mul_ps(rcpQ, GET_GRADIENT_VALUE_AFFINE(texR[texUnit]));
+                                    sampleTexture(texState, texCoords, texColor);
+
+                                    // Execute the texturing function
+                                    texState.texEnvKernel(texState.texEnv, texColor, primaryColor, srcColor);
+
+                                    // Not quite sure about that
+                                    //srcColor.a = SIMD::clamp01(srcColor.a);
+                                    //srcColor.r = SIMD::clamp01(srcColor.r);
+                                    //srcColor.g = SIMD::clamp01(srcColor.g);
+                                    //srcColor.b = SIMD::clamp01(srcColor.b);
+                                }
+
+
+                                //
+                                // Alpha testing
+                                //
+                                if (alphaFunc != GL_NONE) {
+
+                                    QFloat refVal = _mm_set1_ps(stateBlock.alphaReference);
+
+                                    switch (alphaFunc) {
+
+                                    case GL_NEVER: fragmentMask = _mm_setzero_si128(); break;
+                                    case GL_LESS: fragmentMask = _mm_and_si128(fragmentMask, _mm_castps_si128(_mm_cmplt_ps(srcColor.a, refVal))); break;
+                                    case GL_EQUAL: fragmentMask = _mm_and_si128(fragmentMask, _mm_castps_si128(_mm_cmpeq_ps(srcColor.a, refVal))); break;
+                                    case GL_LEQUAL: fragmentMask = _mm_and_si128(fragmentMask, _mm_castps_si128(_mm_cmple_ps(srcColor.a, refVal))); break;
+                                    case GL_GREATER: fragmentMask = _mm_and_si128(fragmentMask, _mm_castps_si128(_mm_cmpgt_ps(srcColor.a, refVal))); break;
+                                    case GL_NOTEQUAL: fragmentMask = _mm_and_si128(fragmentMask, _mm_castps_si128(_mm_cmpneq_ps(srcColor.a, refVal))); break;
+                                    case GL_GEQUAL: fragmentMask = _mm_and_si128(fragmentMask, _mm_castps_si128(_mm_cmpge_ps(srcColor.a, refVal))); break;
+                                    case GL_ALWAYS: break;
+                                    }
+
+                                    // Check if any fragment survived the alpha test
+                                    if (SIMD::isZero(fragmentMask)) {
+
+                                        goto nextQuad;
+                                    }
+
+                                    // The write to the depthbuffer can be defered after alpha testing is done. This makes
+                                    // it possible to do a early depthbuffer test while maintaining the "natural" flow of
+                                    // data as OpenGL specifies it.
+                                    if (writeDepthAfterAlphaTest) {
+
+                                        _mm_store_si128(
+
+                                            reinterpret_cast<QInt *>(depthBuffer),
+                                            SIMD::blend(depthBufferZ, currentZ, fragmentMask)
+                                        );
+                                        isDepthWritten = true;
+                                    }
+                                }
+
+
+                                //
+                                // Blending with the color buffer
+                                //
+                                QInt quadBackbuffer = _mm_load_si128(reinterpret_cast<QInt *>(colorBuffer));
+                                QInt quadBlendingResult;
+
+                                if (isBlendingEnabled) {
+
+                                    // Convert the backbuffer colors back to floats
+                                    const QFloat normalize = _mm_set1_ps(1.0f / 255.0f);
+                                    const QInt mask = _mm_set1_epi32(0xff);
+
+                                    ARGBColor dstColor;
+                                    dstColor.a = _mm_mul_ps(normalize, _mm_cvtepi32_ps(_mm_srli_epi32(quadBackbuffer, 24)));
+                                    dstColor.r = _mm_mul_ps(normalize, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(quadBackbuffer, 16), mask)));
+                                    dstColor.g = _mm_mul_ps(normalize, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(quadBackbuffer, 8), mask)));
+                                    dstColor.b = _mm_mul_ps(normalize, _mm_cvtepi32_ps(_mm_and_si128(quadBackbuffer, mask)));
+
+                                    // Determine the source and destination blending factors
+                                    ARGBColor srcFactor, dstFactor;
+
+                                    switch (blendSrc) {
+
+                                    case GL_ZERO:
+                                        srcFactor.a = _mm_setzero_ps();
+                                        srcFactor.r = _mm_setzero_ps();
+                                        srcFactor.g = _mm_setzero_ps();
+                                        srcFactor.b = _mm_setzero_ps();
+                                        break;
+
+                                    case GL_ONE:
+                                        srcFactor.a = _mm_set1_ps(1.0f);
+                                        srcFactor.r = _mm_set1_ps(1.0f);
+                                        srcFactor.g = _mm_set1_ps(1.0f);
+                                        srcFactor.b = _mm_set1_ps(1.0f);
+                                        break;
+
+                                    case GL_DST_COLOR:
+                                        srcFactor = dstColor;
+                                        break;
+
+                                    case GL_ONE_MINUS_DST_COLOR:
+                                        srcFactor.a = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.r = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.r);
+                                        srcFactor.g = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.g);
+                                        srcFactor.b = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.b);
+                                        break;
+
+                                    case GL_SRC_ALPHA:
+                                        srcFactor.a = srcColor.a;
+                                        srcFactor.r = srcColor.a;
+                                        srcFactor.g = srcColor.a;
+                                        srcFactor.b = srcColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_SRC_ALPHA:
+                                        srcFactor.a = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        srcFactor.r = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        srcFactor.g = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        srcFactor.b = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        break;
+
+                                    case GL_DST_ALPHA:
+                                        srcFactor.a = dstColor.a;
+                                        srcFactor.r = dstColor.a;
+                                        srcFactor.g = dstColor.a;
+                                        srcFactor.b = dstColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_DST_ALPHA:
+                                        srcFactor.a = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.r = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.g = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.b = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        break;
+
+                                    case GL_SRC_ALPHA_SATURATE:
+                                        srcFactor.a = _mm_set1_ps(1.0f);
+                                        srcFactor.r = _mm_min_ps(srcColor.a, _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a));
+                                        srcFactor.g = _mm_min_ps(srcColor.a, _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a));
+                                        srcFactor.b = _mm_min_ps(srcColor.a, _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a));
+                                        break;
+                                    }
+
+                                    switch (blendDst) {
+
+                                    case GL_ZERO:
+                                        dstFactor.a = _mm_setzero_ps();
+                                        dstFactor.r = _mm_setzero_ps();
+                                        dstFactor.g = _mm_setzero_ps();
+                                        dstFactor.b = _mm_setzero_ps();
+                                        break;
+
+                                    case GL_ONE:
+                                        dstFactor.a = _mm_set1_ps(1.0f);
+                                        dstFactor.r = _mm_set1_ps(1.0f);
+                                        dstFactor.g = _mm_set1_ps(1.0f);
+                                        dstFactor.b = _mm_set1_ps(1.0f);
+                                        break;
+
+                                    case GL_SRC_COLOR:
+                                        dstFactor = srcColor;
+                                        break;
+
+                                    case GL_ONE_MINUS_SRC_COLOR:
+                                        dstFactor.a = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.r = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.r);
+                                        dstFactor.g = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.g);
+                                        dstFactor.b = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.b);
+                                        break;
+
+                                    case GL_SRC_ALPHA:
+                                        dstFactor.a = srcColor.a;
+                                        dstFactor.r = srcColor.a;
+                                        dstFactor.g = srcColor.a;
+                                        dstFactor.b = srcColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_SRC_ALPHA:
+                                        dstFactor.a = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.r = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.g = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.b = _mm_sub_ps(_mm_set1_ps(1.0f), srcColor.a);
+                                        break;
+
+                                    case GL_DST_ALPHA:
+                                        dstFactor.a = dstColor.a;
+                                        dstFactor.r = dstColor.a;
+                                        dstFactor.g = dstColor.a;
+                                        dstFactor.b = dstColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_DST_ALPHA:
+                                        dstFactor.a = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        dstFactor.r = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        dstFactor.g = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        dstFactor.b = _mm_sub_ps(_mm_set1_ps(1.0f), dstColor.a);
+                                        break;
+                                    }
+
+                                    // Perform the blending
+                                    srcColor.a = _mm_add_ps(_mm_mul_ps(srcColor.a, srcFactor.a), _mm_mul_ps(dstColor.a, dstFactor.a));
+                                    srcColor.r = _mm_add_ps(_mm_mul_ps(srcColor.r, srcFactor.r), _mm_mul_ps(dstColor.r, dstFactor.r));
+                                    srcColor.g = _mm_add_ps(_mm_mul_ps(srcColor.g, srcFactor.g), _mm_mul_ps(dstColor.g, dstFactor.g));
+                                    srcColor.b = _mm_add_ps(_mm_mul_ps(srcColor.b, srcFactor.b), _mm_mul_ps(dstColor.b, dstFactor.b));
+                                }
+
+                                quadBlendingResult = getIntegerRGBA(srcColor);
+
+
+                                //
+                                // Color masking
+                                //
+                                quadBlendingResult = SIMD::mask(
+
+                                    quadBlendingResult,
+                                    quadBackbuffer,
+                                    _mm_set1_epi32(colorMask.getMask())
+                                );
+
+
+                                //
+                                // Store final color in the color buffer
+                                //
+                                _mm_store_si128(
+
+                                    reinterpret_cast<QInt *>(colorBuffer),
+                                    SIMD::blend(quadBackbuffer, quadBlendingResult, fragmentMask)
+                                );
+                            }
+
+                        nextQuad:
+
+                            // Update edge equation values with respect to the change in x
+                            edgeValue[0] = _mm_add_epi32(edgeValue[0], edgeDX[0]);
+                            edgeValue[1] = _mm_add_epi32(edgeValue[1], edgeDX[1]);
+                            edgeValue[2] = _mm_add_epi32(edgeValue[2], edgeDX[2]);
+
+                            // Update buffer address
+                            colorBuffer += 4;
+                            depthBuffer += 4;
+                        }
+                    }
+
+                    // Keep the depth bounds of the block up to date
+                    if (isDepthWritten) {
+
+                        updateDepthBounds(drawBuffer, blockX, blockY);
+                    }
+                }
+            }
+        }
+
+        // The bounds of the tile have only been widened while the blocks were drawn
+        if (depthWrite == GL_TRUE) {
+
+            drawBuffer.updateTileDepthBounds();
+        }
+
+        return true;
+    }
+
+
+
+    //
+    // The raster operations the draw triangle kernel is specialized on. These are the
+    // common states of Quake 3 and Unreal Tournament, every other state is drawn by
+    // the generic kernel.
+    //
+    static constexpr RasterOps SPECIALIZED_RASTER_OPS[] = {
+
+        // Opaque and alpha tested (masked) surfaces
+        { GL_LEQUAL, GL_TRUE, GL_NONE, GL_ONE, GL_ZERO },
+        { GL_LEQUAL, GL_TRUE, GL_GREATER, GL_ONE, GL_ZERO },
+        { GL_LEQUAL, GL_TRUE, GL_GEQUAL, GL_ONE, GL_ZERO },
+
+        // Lightmaps and the later stages of multi pass shaders
+        { GL_LEQUAL, GL_FALSE, GL_NONE, GL_DST_COLOR, GL_ZERO },
+        { GL_EQUAL, GL_FALSE, GL_NONE, GL_DST_COLOR, GL_ZERO },
+        { GL_EQUAL, GL_FALSE, GL_NONE, GL_ZERO, GL_SRC_COLOR },
+        { GL_EQUAL, GL_FALSE, GL_NONE, GL_ONE, GL_ONE },
+
+        // Effects, translucent and modulated surfaces
+        { GL_LEQUAL, GL_FALSE, GL_NONE, GL_ONE, GL_ONE },
+        { GL_LEQUAL, GL_FALSE, GL_NONE, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA },
+        { GL_LEQUAL, GL_FALSE, GL_NONE, GL_ONE, GL_ONE_MINUS_SRC_COLOR },
+        { GL_LEQUAL, GL_FALSE, GL_NONE, GL_DST_COLOR, GL_SRC_COLOR },
+
+        // User interface
+        { GL_NONE, GL_FALSE, GL_NONE, GL_ONE, GL_ZERO },
+        { GL_NONE, GL_FALSE, GL_NONE, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA }
+    };
+
+    template<size_t... Indices>
+    static DrawTrianglesKernel selectDrawTriangles(const RasterOps &rasterOps, std::index_sequence<Indices...>) {
+
+        static const DrawTrianglesKernel kernels[] = {
+
+            &drawTriangles<
+
+                SPECIALIZED_RASTER_OPS[Indices].depthFunc,
+                SPECIALIZED_RASTER_OPS[Indices].depthWrite,
+                SPECIALIZED_RASTER_OPS[Indices].alphaFunc,
+                SPECIALIZED_RASTER_OPS[Indices].blendSrc,
+                SPECIALIZED_RASTER_OPS[Indices].blendDst
+            >...
+        };
+
+        for (size_t i = 0; i < std::size(SPECIALIZED_RASTER_OPS); i++) {
+
+            if (SPECIALIZED_RASTER_OPS[i] == rasterOps) {
+
+                return kernels[i];
+            }
+        }
+
+        return &drawTriangles<RASTER_OP_RUNTIME, RASTER_OP_RUNTIME, RASTER_OP_RUNTIME, RASTER_OP_RUNTIME, RASTER_OP_RUNTIME>;
+    }
+
+    static DrawTrianglesKernel selectDrawTriangles(const RasterOps &rasterOps) {
+
+        return selectDrawTriangles(rasterOps, std::make_index_sequence<std::size(SPECIALIZED_RASTER_OPS)>());
+    }
+}
+}
+
+#undef GET_GRADIENT_VALUE_PERSP
+#undef GET_GRADIENT_VALUE_AFFINE
+#undef LOAD_GRADIENT_EQ
+#undef DEFINE_GRADIENT
+#undef GRADIENT_DY
+#undef GRADIENT_DX
+#undef GRADIENT_VALUE
@@ -0,0 +1,699 @@
+﻿#pragma once
+
+#include <algorithm>
+#include "DrawBuffer.h"
+#include "ContextTypes.h"
+#include "SIMDAVX2.h"
+#include "OpenGL.h"
+#include "Triangle.h"
+#include "TextureManager.h"
+#include "TextureSamplerAVX2.inl"
+#include "DrawBuffer.inl"
+#include "CommandDrawTriangle.h"
+#include "Rasterizer.inl"
+
+#define GRADIENT_VALUE(NAME) \
+    oV ## NAME
+
+#define GRADIENT_DX(NAME) \
+    oDX ## NAME
+
+#define GRADIENT_DY(NAME) \
+    oDY ## NAME
+
+#define DEFINE_GRADIENT(NAME) \
+    OFloat GRADIENT_VALUE(NAME), GRADIENT_DX(NAME), GRADIENT_DY(NAME)
+
+#define LOAD_GRADIENT_EQ(NAME, ATTRIBUTE) \
+    loadGradientEquation(GRADIENT_VALUE(NAME), GRADIENT_DX(NAME), GRADIENT_DY(NAME), setup, ATTRIBUTE, triangleIdx)
+
+#define GET_GRADIENT_VALUE_AFFINE(NAME) \
+    _mm256_add_ps(oV ## NAME, _mm256_add_ps(_mm256_mul_ps(xxxx, GRADIENT_DX(NAME)), _mm256_mul_ps(yyyy, GRADIENT_DY(NAME))))
+
+#define GET_GRADIENT_VALUE_PERSP(NAME) \
+    _mm256_mul_ps(w, GET_GRADIENT_VALUE_AFFINE(NAME))
+
+
+
+//
+// The triangle rasterizer of CommandDrawTriangle.inl for two quads side by side (4x2 pixels).
+// The lanes of a pair hold the same values as the two quads would, and every value is
+// calculated in the same way, so both paths produce exactly the same pixels. That matters
+// as the draw calls of multi pass rendering may take different paths (GL_EQUAL depth test).
+//
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    static INLINED OInt getIntegerRGBA(ARGBColor8 &color) {
+
+        const OFloat cMin = _mm256_setzero_ps();
+        const OFloat cMax = _mm256_set1_ps(255.0f);
+
+        // Scale floating point color values
+        OFloat a = _mm256_mul_ps(color.a, cMax);
+        OFloat r = _mm256_mul_ps(color.r, cMax);
+        OFloat g = _mm256_mul_ps(color.g, cMax);
+        OFloat b = _mm256_mul_ps(color.b, cMax);
+
+        // Clamp the values between [0,255]
+        a = SIMD::clamp(a, cMin, cMax);
+        r = SIMD::clamp(r, cMin, cMax);
+        g = SIMD::clamp(g, cMin, cMax);
+        b = SIMD::clamp(b, cMin, cMax);
+
+        // Build result
+        OInt resA = _mm256_slli_epi32(_mm256_cvtps_epi32(a), 24);
+        OInt resR = _mm256_slli_epi32(_mm256_cvtps_epi32(r), 16);
+        OInt resG = _mm256_slli_epi32(_mm256_cvtps_epi32(g), 8);
+        OInt resB = _mm256_cvtps_epi32(b);
+
+        return _mm256_or_si256(
+
+            _mm256_or_si256(resA, resR),
+            _mm256_or_si256(resG, resB)
+        );
+    }
+
+    static INLINED void loadGradientEquation(OFloat &oVAL, OFloat &oDQDX, OFloat &oDQDY, TriangleSetup &setup, int attribute, int triangleIdx) {
+
+        // The triangle setup holds the interpolant value at the origin point
+        float value = setup.getGradient(attribute, TriangleSetup::Value)[triangleIdx];
+        float dqdx = setup.getGradient(attribute, TriangleSetup::DX)[triangleIdx];
+        float dqdy = setup.getGradient(attribute, TriangleSetup::DY)[triangleIdx];
+
+        // Both quads start at their own x coordinate (see xxxx below)
+        oDQDX = _mm256_set1_ps(dqdx);
+        oDQDY = _mm256_set1_ps(dqdy);
+        oVAL = _mm256_set_ps(
+
+            value + dqdy + dqdx,
+            value + dqdy,
+            value + dqdx,
+            value,
+            value + dqdy + dqdx,
+            value + dqdy,
+            value + dqdx,
+            value
+        );
+    }
+
+    static INLINED void setupEdgeEquation(EdgeEquation &eq, OInt &eVAL, OInt &eDEDX, int edge, int dx, int dy, int minX, int minY) {
+
+        eq = EdgeEquation(edge, dx, dy, minX, minY);
+
+        // Offsets of the pixels within a pair of quads
+        eDEDX = _mm256_set1_epi32(eq.dedx << 2);
+        eVAL = _mm256_set_epi32(
+
+            (eq.dedx * 3) + eq.dedy,
+            (eq.dedx * 2) + eq.dedy,
+            eq.dedx * 3,
+            eq.dedx * 2,
+            eq.dedy + eq.dedx,
+            eq.dedy,
+            eq.dedx,
+            0
+        );
+    }
+
+    static INLINED OInt getColumnMask(int x, int minX, int maxX) {
+
+        // The bounding box doesn't necessarily start or end with a full pair
+        int mask1 = (x >= minX) ? -1 : 0;
+        int mask2 = (x + 2 < maxX) ? -1 : 0;
+
+        return _mm256_set_epi32(mask2, mask2, mask2, mask2, mask1, mask1, mask1, mask1);
+    }
+
+
+
+    //
+    // Draw triangle kernel for pairs of quads, which is specialized on the raster
+    // operations like drawTriangles() (see CommandDrawTriangle.inl)
+    //
+    template<GLenum DepthFunc, GLenum DepthWrite, GLenum AlphaFunc, GLenum BlendSrc, GLenum BlendDst>
+    static bool drawTrianglePairs(TriangleDrawCallState &state, const int *indices, int numIndices, DrawBuffer &drawBuffer) {
+
+        auto &stateBlock = *state.stateBlock;
+        auto &scissor = stateBlock.scissor;
+        auto &polygonOffset = stateBlock.polygonOffset;
+        auto &colorMask = stateBlock.colorMask;
+        auto &textureState = stateBlock.textures;
+        auto &setup = state.setup;
+
+        // The raster operations are constants unless this is the generic kernel
+        auto &rasterOps = stateBlock.rasterOps;
+        const GLenum depthFunc = resolveRasterOp<DepthFunc>(rasterOps.depthFunc);
+        const GLenum depthWrite = resolveRasterOp<DepthWrite>(rasterOps.depthWrite);
+        const GLenum alphaFunc = resolveRasterOp<AlphaFunc>(rasterOps.alphaFunc);
+        const GLenum blendSrc = resolveRasterOp<BlendSrc>(rasterOps.blendSrc);
+        const GLenum blendDst = resolveRasterOp<BlendDst>(rasterOps.blendDst);
+        const bool isBlendingEnabled = blendSrc != GL_ONE || blendDst != GL_ZERO;
+
+        // With alpha testing the depth write is defered until the alpha test is done
+        const bool writeDepthAfterAlphaTest = depthWrite == GL_TRUE && alphaFunc != GL_NONE;
+        const bool writeDepthAfterDepthTest = depthWrite == GL_TRUE && alphaFunc == GL_NONE;
+
+        for (int indexIdx = 0; indexIdx < numIndices; indexIdx++) {
+
+            auto triangleIdx = indices[indexIdx];
+
+            //
+            // Get the fixed point coordinates from the triangle setup
+            //
+            int x1 = setup.getPosition(TriangleSetup::X1)[triangleIdx];
+            int y1 = setup.getPosition(TriangleSetup::Y1)[triangleIdx];
+            int x2 = setup.getPosition(TriangleSetup::X2)[triangleIdx];
+            int y2 = setup.getPosition(TriangleSetup::Y2)[triangleIdx];
+            int x3 = setup.getPosition(TriangleSetup::X3)[triangleIdx];
+            int y3 = setup.getPosition(TriangleSetup::Y3)[triangleIdx];
+
+            //
+            // Determine triangle bounding box with respect to our rendertarget
+            //
+            int minY = SIMD::max((SIMD::min(y1, SIMD::min(y2, y3)) + 0x0f) >> 4, drawBuffer.getMinY());
+            int maxY = SIMD::min((SIMD::max(y1, SIMD::max(y2, y3)) + 0x0f) >> 4, drawBuffer.getMaxY());
+            int minX = SIMD::max((SIMD::min(x1, SIMD::min(x2, x3)) + 0x0f) >> 4, drawBuffer.getMinX());
+            int maxX = SIMD::min((SIMD::max(x1, SIMD::max(x2, x3)) + 0x0f) >> 4, drawBuffer.getMaxX());
+
+            if (scissor.isEnabled()) {
+
+                scissor.cut(minX, minY, maxX, maxY);
+            }
+
+            // Make sure that we rasterize at the beginning of a quad (which is 2x2 pixel)
+            minX &= ~1;
+            minY &= ~1;
+
+            //
+            // Determine the triangle edge equations
+            //
+            int dx12 = x1 - x2, dx23 = x2 - x3, dx31 = x3 - x1;
+            int dy12 = y1 - y2, dy23 = y2 - y3, dy31 = y3 - y1;
+
+            EdgeEquation edges[3];
+            OInt pairEdgeValue[3], edgeDX[3];
+            setupEdgeEquation(edges[0], pairEdgeValue[0], edgeDX[0], setup.getPosition(TriangleSetup::Edge12)[triangleIdx], dx12, dy12, minX, minY);
+            setupEdgeEquation(edges[1], pairEdgeValue[1], edgeDX[1], setup.getPosition(TriangleSetup::Edge23)[triangleIdx], dx23, dy23, minX, minY);
+            setupEdgeEquation(edges[2], pairEdgeValue[2], edgeDX[2], setup.getPosition(TriangleSetup::Edge31)[triangleIdx], dx31, dy31, minX, minY);
+
+            //
+            // Get the gradient equations from the triangle setup
+            //
+            DEFINE_GRADIENT(z);
+            LOAD_GRADIENT_EQ(z, TriangleSetup::Z);
+
+            DEFINE_GRADIENT(rcpW);
+            LOAD_GRADIENT_EQ(rcpW, TriangleSetup::RcpW);
+
+            DEFINE_GRADIENT(primaryA);
+            LOAD_GRADIENT_EQ(primaryA, TriangleSetup::PrimaryA);
+            DEFINE_GRADIENT(primaryR);
+            LOAD_GRADIENT_EQ(primaryR, TriangleSetup::PrimaryR);
+            DEFINE_GRADIENT(primaryG);
+            LOAD_GRADIENT_EQ(primaryG, TriangleSetup::PrimaryG);
+            DEFINE_GRADIENT(primaryB);
+            LOAD_GRADIENT_EQ(primaryB, TriangleSetup::PrimaryB);
+
+            DEFINE_GRADIENT(texS[SWGL_MAX_TEXTURE_UNITS]);
+            DEFINE_GRADIENT(texT[SWGL_MAX_TEXTURE_UNITS]);
+            DEFINE_GRADIENT(texR[SWGL_MAX_TEXTURE_UNITS]);
+            DEFINE_GRADIENT(texQ[SWGL_MAX_TEXTURE_UNITS]);
+            for (auto i = 0U; i < SWGL_MAX_TEXTURE_UNITS; i++) {
+
+                // Units without a texture aren't set up
+                if (textureState[i].texData == nullptr) {
+
+                    continue;
+                }
+
+                auto texCoord = setup.getTexCoord(i);
+                LOAD_GRADIENT_EQ(texS[i], texCoord + 0);
+                LOAD_GRADIENT_EQ(texT[i], texCoord + 1);
+                LOAD_GRADIENT_EQ(texR[i], texCoord + 2);
+                LOAD_GRADIENT_EQ(texQ[i], texCoord + 3);
+            }
+
+            //
+            // Calculate polygon offset (see page 77, glspec13.pdf)
+            //
+            if (polygonOffset.isFillEnabled()) {
+
+                OFloat m = _mm256_max_ps(
+
+                    SIMD::absolute(GRADIENT_DX(z)),
+                    SIMD::absolute(GRADIENT_DY(z))
+                );
+
+                OFloat zOffset = SIMD::multiplyAdd(
+
+                    m,
+                    _mm256_set1_ps(stateBlock.polygonOffsetFactor),
+                    _mm256_set1_ps(stateBlock.polygonOffsetRTimesUnits)
+                );
+
+                GRADIENT_VALUE(z) = _mm256_add_ps(GRADIENT_VALUE(z), zOffset);
+            }
+
+
+            //
+            // Hierarchical depth test, triangles behind the contents of the tile are
+            // rejected as a whole
+            //
+            DepthPlane depthPlane = {};
+
+            if (depthFunc != GL_NONE) {
+
+                depthPlane.value = _mm256_cvtss_f32(GRADIENT_VALUE(z));
+                depthPlane.dzdx = _mm256_cvtss_f32(GRADIENT_DX(z));
+                depthPlane.dzdy = _mm256_cvtss_f32(GRADIENT_DY(z));
+
+                if (isDepthTestFailing(depthFunc, depthPlane.getBounds(minX, minY, maxX, maxY), drawBuffer.getTileDepthBounds())) {
+
+                    continue;
+                }
+            }
+
+
+            //
+            // Rasterize and shade the triangle
+            //
+            ARGBColor8 srcColor;
+            ARGBColor8 texColor;
+            ARGBColor8 primaryColor;
+            TextureCoordinates8 texCoords;
+
+            // The x coordinates of the two quads
+            const OFloat pairOffsetX = _mm256_set_ps(2.0f, 2.0f, 2.0f, 2.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+
+            // The blocks are aligned to the tile like the depth bounds, and so are the pairs.
+            // The quads in front of the bounding box are masked out.
+            int gridMinX = minX - ((minX - drawBuffer.getMinX()) % SWGL_RASTER_BLOCK_SIZE);
+            int gridMinY = minY - ((minY - drawBuffer.getMinY()) % SWGL_RASTER_BLOCK_SIZE);
+
+            for (int blockY = gridMinY; blockY < maxY; blockY += SWGL_RASTER_BLOCK_SIZE) {
+
+                int firstY = SIMD::max(blockY, minY);
+                int blockMaxY = SIMD::min(blockY + SWGL_RASTER_BLOCK_SIZE, maxY);
+
+                for (int blockX = gridMinX; blockX < maxX; blockX += SWGL_RASTER_BLOCK_SIZE) {
+
+                    int blockMaxX = SIMD::min(blockX + SWGL_RASTER_BLOCK_SIZE, maxX);
+
+                    // The first and the last pixel which are touched by the quads of the block
+                    int firstX = SIMD::max(blockX, minX);
+                    int pairX = blockX + ((firstX - blockX) & ~3);
+                    int lastX = firstX + ((1 + (blockMaxX - firstX)) & ~1) - 1;
+                    int lastY = firstY + ((1 + (blockMaxY - firstY)) & ~1) - 1;
+
+                    auto coverage = testBlockCoverage(edges, firstX - minX, firstY - minY, lastX - minX, lastY - minY);
+                    if (coverage == BlockCoverage::Empty) {
+
+                        continue;
+                    }
+
+                    if (depthFunc != GL_NONE &&
+                        isDepthTestFailing(depthFunc, depthPlane.getBounds(firstX, firstY, lastX, lastY), drawBuffer.getDepthBounds(blockX, blockY))) {
+
+                        continue;
+                    }
+
+                    bool isDepthWritten = false;
+
+                    for (int y = firstY; y < blockMaxY; y += 2) {
+
+                        OFloat yyyy = _mm256_set1_ps(static_cast<float>(y));
+
+                        // Edge equation values at the first pair of the row
+                        OInt edgeValue[3];
+                        for (int i = 0; i < 3; i++) {
+
+                            edgeValue[i] = _mm256_add_epi32(pairEdgeValue[i], _mm256_set1_epi32(edges[i].evaluate(pairX - minX, y - minY)));
+                        }
+
+                        ptrdiff_t bufferOffset = ((pairX - drawBuffer.getMinX()) << 1) + ((y - drawBuffer.getMinY()) * drawBuffer.getWidth());
+                        auto colorBuffer = drawBuffer.getColor() + bufferOffset;
+                        auto depthBuffer = drawBuffer.getDepth() + bufferOffset;
+
+                        for (int x = pairX; x < blockMaxX; x += 4) {
+
+                            //
+                            // Coverage test for a pair of 2x2 pixel quads, fully covered blocks don't need it
+                            //
+                            OInt fragmentMask = _mm256_setallones_si256();
+
+                            if (x < minX || x + 2 >= maxX) {
+
+                                fragmentMask = getColumnMask(x, minX, maxX);
+                            }
+
+                            if (coverage == BlockCoverage::Partial) {
+
+                                OInt e0 = _mm256_cmpgt_epi32(edgeValue[0], _mm256_setzero_si256());
+                                OInt e1 = _mm256_cmpgt_epi32(edgeValue[1], _mm256_setzero_si256());
+                                OInt e2 = _mm256_cmpgt_epi32(edgeValue[2], _mm256_setzero_si256());
+                                fragmentMask = _mm256_and_si256(fragmentMask, _mm256_and_si256(_mm256_and_si256(e0, e1), e2));
+                            }
+
+                            if (_mm256_testz_si256(fragmentMask, fragmentMask) == 0) {
+
+                                OFloat xxxx = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), pairOffsetX);
+
+
+                                //
+                                // (Early) Depth test
+                                //
+                                OInt depthBufferZ, currentZ;
+
+                                if (depthFunc != GL_NONE) {
+
+                                    depthBufferZ = _mm256_loadu_si256(reinterpret_cast<OInt *>(depthBuffer));
+                                    currentZ = _mm256_cvtps_epi32(
+                                        _mm256_mul_ps(
+                                            _mm256_set1_ps(16777215.0f),
+                                            SIMD::clamp01(GET_GRADIENT_VALUE_AFFINE(z))
+                                        )
+                                    );
+
+                                    switch (depthFunc) {
+
+                                    case GL_NEVER: goto nextPair;
+                                    case GL_LESS: fragmentMask = _mm256_and_si256(_mm256_cmplt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_EQUAL: fragmentMask = _mm256_and_si256(_mm256_cmpeq_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_LEQUAL: fragmentMask = _mm256_andnot_si256(_mm256_cmpgt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_GREATER: fragmentMask = _mm256_and_si256(_mm256_cmpgt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_NOTEQUAL: fragmentMask = _mm256_andnot_si256(_mm256_cmpeq_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    case GL_GEQUAL: fragmentMask = _mm256_andnot_si256(_mm256_cmplt_epi32(currentZ, depthBufferZ), fragmentMask); break;
+                                    }
+
+                                    // Check if any fragment survived the depth test
+                                    if (_mm256_testz_si256(fragmentMask, fragmentMask) != 0) {
+
+                                        goto nextPair;
+                                    }
+
+                                    // Write the new depth values to the depth buffer
+                                    if (writeDepthAfterDepthTest) {
+
+                                        _mm256_storeu_si256(
+
+                                            reinterpret_cast<OInt *>(depthBuffer),
+                                            SIMD::blend(depthBufferZ, currentZ, fragmentMask)
+                                        );
+                                        isDepthWritten = true;
+                                    }
+                                }
+
+
+                                //
+                                // Calculate perspective w
+                                //
+                                OFloat w = _mm256_div_ps(_mm256_set1_ps(1.0f), GET_GRADIENT_VALUE_AFFINE(rcpW));
+
+
+                                //
+                                // Set the fragments initial color
+                                //
+                                primaryColor.a = GET_GRADIENT_VALUE_PERSP(primaryA);
+                                primaryColor.r = GET_GRADIENT_VALUE_PERSP(primaryR);
+                                primaryColor.g = GET_GRADIENT_VALUE_PERSP(primaryG);
+                                primaryColor.b = GET_GRADIENT_VALUE_PERSP(primaryB);
+
+
+                                //
+                                // Texture sampling and blending for each active texture unit (only 2D
+                                // textures with a texture function for pairs of quads take this path)
+                                //
+                                srcColor = primaryColor;
+
+                                for (auto texUnit = 0U; texUnit < SWGL_MAX_TEXTURE_UNITS; texUnit++) {
+
+                                    auto &texState = textureState[texUnit];
+                                    if (texState.texData == nullptr) {
+
+                                        continue;
+                                    }
+
+                                    // Get texture sample
+                                    OFloat rcpQ = _mm256_div_ps(_mm256_set1_ps(1.0f), GET_GRADIENT_VALUE_AFFINE(texQ[texUnit]));
+                                    texCoords.s = _mm256_mul_ps(rcpQ, GET_GRADIENT_VALUE_AFFINE(texS[texUnit]));
+                                    texCoords.t = _mm256_mul_ps(rcpQ, GET_GRADIENT_VALUE_AFFINE(texT[texUnit]));
+                                    texCoords.r = _mm256_mul_ps(rcpQ, GET_GRADIENT_VALUE_AFFINE(texR[texUnit]));
+                                    sample2D8(static_cast<TextureData2D &>(*texState.texData), texState.texParams, texCoords, texColor);
+
+                                    // Execute the texturing function
+                                    texState.texEnvKernel8(texState.texEnv, texColor, primaryColor, srcColor);
+                                }
+
+
+                                //
+                                // Alpha testing
+                                //
+                                if (alphaFunc != GL_NONE) {
+
+                                    OFloat refVal = _mm256_set1_ps(stateBlock.alphaReference);
+
+                                    switch (alphaFunc) {
+
+                                    case GL_NEVER: fragmentMask = _mm256_setzero_si256(); break;
+                                    case GL_LESS: fragmentMask = _mm256_and_si256(fragmentMask, _mm256_castps_si256(_mm256_cmp_ps(srcColor.a, refVal, _CMP_LT_OQ))); break;
+                                    case GL_EQUAL: fragmentMask = _mm256_and_si256(fragmentMask, _mm256_castps_si256(_mm256_cmp_ps(srcColor.a, refVal, _CMP_EQ_OQ))); break;
+                                    case GL_LEQUAL: fragmentMask = _mm256_and_si256(fragmentMask, _mm256_castps_si256(_mm256_cmp_ps(srcColor.a, refVal, _CMP_LE_OQ))); break;
+                                    case GL_GREATER: fragmentMask = _mm256_and_si256(fragmentMask, _mm256_castps_si256(_mm256_cmp_ps(srcColor.a, refVal, _CMP_GT_OQ))); break;
+                                    case GL_NOTEQUAL: fragmentMask = _mm256_and_si256(fragmentMask, _mm256_castps_si256(_mm256_cmp_ps(srcColor.a, refVal, _CMP_NEQ_UQ))); break;
+                                    case GL_GEQUAL: fragmentMask = _mm256_and_si256(fragmentMask, _mm256_castps_si256(_mm256_cmp_ps(srcColor.a, refVal, _CMP_GE_OQ))); break;
+                                    case GL_ALWAYS: break;
+                                    }
+
+                                    // Check if any fragment survived the alpha test
+                                    if (_mm256_testz_si256(fragmentMask, fragmentMask) != 0) {
+
+                                        goto nextPair;
+                                    }
+
+                                    // The write to the depthbuffer is defered after alpha testing is done
+                                    // (see CommandDrawTriangle.inl)
+                                    if (writeDepthAfterAlphaTest) {
+
+                                        _mm256_storeu_si256(
+
+                                            reinterpret_cast<OInt *>(depthBuffer),
+                                            SIMD::blend(depthBufferZ, currentZ, fragmentMask)
+                                        );
+                                        isDepthWritten = true;
+                                    }
+                                }
+
+
+                                //
+                                // Blending with the color buffer
+                                //
+                                OInt pairBackbuffer = _mm256_loadu_si256(reinterpret_cast<OInt *>(colorBuffer));
+                                OInt pairBlendingResult;
+
+                                if (isBlendingEnabled) {
+
+                                    // Convert the backbuffer colors back to floats
+                                    const OFloat normalize = _mm256_set1_ps(1.0f / 255.0f);
+                                    const OInt mask = _mm256_set1_epi32(0xff);
+
+                                    ARGBColor8 dstColor;
+                                    dstColor.a = _mm256_mul_ps(normalize, _mm256_cvtepi32_ps(_mm256_srli_epi32(pairBackbuffer, 24)));
+                                    dstColor.r = _mm256_mul_ps(normalize, _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pairBackbuffer, 16), mask)));
+                                    dstColor.g = _mm256_mul_ps(normalize, _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pairBackbuffer, 8), mask)));
+                                    dstColor.b = _mm256_mul_ps(normalize, _mm256_cvtepi32_ps(_mm256_and_si256(pairBackbuffer, mask)));
+
+                                    // Determine the source and destination blending factors
+                                    ARGBColor8 srcFactor, dstFactor;
+
+                                    switch (blendSrc) {
+
+                                    case GL_ZERO:
+                                        srcFactor.a = _mm256_setzero_ps();
+                                        srcFactor.r = _mm256_setzero_ps();
+                                        srcFactor.g = _mm256_setzero_ps();
+                                        srcFactor.b = _mm256_setzero_ps();
+                                        break;
+
+                                    case GL_ONE:
+                                        srcFactor.a = _mm256_set1_ps(1.0f);
+                                        srcFactor.r = _mm256_set1_ps(1.0f);
+                                        srcFactor.g = _mm256_set1_ps(1.0f);
+                                        srcFactor.b = _mm256_set1_ps(1.0f);
+                                        break;
+
+                                    case GL_DST_COLOR:
+                                        srcFactor = dstColor;
+                                        break;
+
+                                    case GL_ONE_MINUS_DST_COLOR:
+                                        srcFactor.a = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.r = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.r);
+                                        srcFactor.g = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.g);
+                                        srcFactor.b = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.b);
+                                        break;
+
+                                    case GL_SRC_ALPHA:
+                                        srcFactor.a = srcColor.a;
+                                        srcFactor.r = srcColor.a;
+                                        srcFactor.g = srcColor.a;
+                                        srcFactor.b = srcColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_SRC_ALPHA:
+                                        srcFactor.a = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        srcFactor.r = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        srcFactor.g = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        srcFactor.b = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        break;
+
+                                    case GL_DST_ALPHA:
+                                        srcFactor.a = dstColor.a;
+                                        srcFactor.r = dstColor.a;
+                                        srcFactor.g = dstColor.a;
+                                        srcFactor.b = dstColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_DST_ALPHA:
+                                        srcFactor.a = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.r = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.g = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        srcFactor.b = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        break;
+
+                                    case GL_SRC_ALPHA_SATURATE:
+                                        srcFactor.a = _mm256_set1_ps(1.0f);
+                                        srcFactor.r = _mm256_min_ps(srcColor.a, _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a));
+                                        srcFactor.g = _mm256_min_ps(srcColor.a, _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a));
+                                        srcFactor.b = _mm256_min_ps(srcColor.a, _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a));
+                                        break;
+                                    }
+
+                                    switch (blendDst) {
+
+                                    case GL_ZERO:
+                                        dstFactor.a = _mm256_setzero_ps();
+                                        dstFactor.r = _mm256_setzero_ps();
+                                        dstFactor.g = _mm256_setzero_ps();
+                                        dstFactor.b = _mm256_setzero_ps();
+                                        break;
+
+                                    case GL_ONE:
+                                        dstFactor.a = _mm256_set1_ps(1.0f);
+                                        dstFactor.r = _mm256_set1_ps(1.0f);
+                                        dstFactor.g = _mm256_set1_ps(1.0f);
+                                        dstFactor.b = _mm256_set1_ps(1.0f);
+                                        break;
+
+                                    case GL_SRC_COLOR:
+                                        dstFactor = srcColor;
+                                        break;
+
+                                    case GL_ONE_MINUS_SRC_COLOR:
+                                        dstFactor.a = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.r = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.r);
+                                        dstFactor.g = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.g);
+                                        dstFactor.b = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.b);
+                                        break;
+
+                                    case GL_SRC_ALPHA:
+                                        dstFactor.a = srcColor.a;
+                                        dstFactor.r = srcColor.a;
+                                        dstFactor.g = srcColor.a;
+                                        dstFactor.b = srcColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_SRC_ALPHA:
+                                        dstFactor.a = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.r = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.g = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        dstFactor.b = _mm256_sub_ps(_mm256_set1_ps(1.0f), srcColor.a);
+                                        break;
+
+                                    case GL_DST_ALPHA:
+                                        dstFactor.a = dstColor.a;
+                                        dstFactor.r = dstColor.a;
+                                        dstFactor.g = dstColor.a;
+                                        dstFactor.b = dstColor.a;
+                                        break;
+
+                                    case GL_ONE_MINUS_DST_ALPHA:
+                                        dstFactor.a = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        dstFactor.r = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        dstFactor.g = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        dstFactor.b = _mm256_sub_ps(_mm256_set1_ps(1.0f), dstColor.a);
+                                        break;
+                                    }
+
+                                    // Perform the blending
+                                    srcColor.a = _mm256_add_ps(_mm256_mul_ps(srcColor.a, srcFactor.a), _mm256_mul_ps(dstColor.a, dstFactor.a));
+                                    srcColor.r = _mm256_add_ps(_mm256_mul_ps(srcColor.r, srcFactor.r), _mm256_mul_ps(dstColor.r, dstFactor.r));
+                                    srcColor.g = _mm256_add_ps(_mm256_mul_ps(srcColor.g, srcFactor.g), _mm256_mul_ps(dstColor.g, dstFactor.g));
+                                    srcColor.b = _mm256_add_ps(_mm256_mul_ps(srcColor.b, srcFactor.b), _mm256_mul_ps(dstColor.b, dstFactor.b));
+                                }
+
+                                pairBlendingResult = getIntegerRGBA(srcColor);
+
+
+                                //
+                                // Color masking
+                                //
+                                pairBlendingResult = SIMD::mask(
+
+                                    pairBlendingResult,
+                                    pairBackbuffer,
+                                    _mm256_set1_epi32(colorMask.getMask())
+                                );
+
+
+                                //
+                                // Store final color in the color buffer
+                                //
+                                _mm256_storeu_si256(
+
+                                    reinterpret_cast<OInt *>(colorBuffer),
+                                    SIMD::blend(pairBackbuffer, pairBlendingResult, fragmentMask)
+                                );
+                            }
+
+                        nextPair:
+
+                            // Update edge equation values with respect to the change in x
+                            edgeValue[0] = _mm256_add_epi32(edgeValue[0], edgeDX[0]);
+                            edgeValue[1] = _mm256_add_epi32(edgeValue[1], edgeDX[1]);
+                            edgeValue[2] = _mm256_add_epi32(edgeValue[2], edgeDX[2]);
+
+                            // Update buffer address
+                            colorBuffer += 8;
+                            depthBuffer += 8;
+                        }
+                    }
+
+                    // Keep the depth bounds of the block up to date
+                    if (isDepthWritten) {
+
+                        updateDepthBounds(drawBuffer, blockX, blockY);
+                    }
+                }
+            }
+        }
+
+        // The bounds of the tile have only been widened while the blocks were drawn
+        if (depthWrite == GL_TRUE) {
+
+            drawBuffer.updateTileDepthBounds();
+        }
+
+        return true;
+    }
+}
+}
+
+#undef GET_GRADIENT_VALUE_PERSP
+#undef GET_GRADIENT_VALUE_AFFINE
+#undef LOAD_GRADIENT_EQ
+#undef DEFINE_GRADIENT
+#undef GRADIENT_DY
+#undef GRADIENT_DX
+#undef GRADIENT_VALUE
@@ -0,0 +1,28 @@
+﻿#include "DrawThread.h"
+#include "DrawSurface.h"
+#include "CountDownLatch.h"
+#include "CommandPresent.h"
+
+namespace SWGL {
+
+    bool CommandPresent::execute(DrawThread *thread) {
+
+        auto &buffer = thread->getDrawBuffer();
+        buffer.unswizzleColor(m_image, m_imageWidth);
+
+#if !SWGL_USE_HARDWARE_GAMMA
+        // Software emulated gamma correction
+        auto &gammaRamp = DrawSurface::getGammaRamp();
+        auto row = m_image + buffer.getMinX() + (buffer.getMinY() * m_imageWidth);
+
+        for (int y = 0; y < buffer.getHeight(); y++, row += m_imageWidth) {
+
+            gammaRamp.correct(row, buffer.getWidth());
+        }
+#endif
+
+        m_latch->countDown();
+
+        return true;
+    }
+}
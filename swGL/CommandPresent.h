@@ -0,0 +1,36 @@
+﻿#pragma once
+
+#include "Defines.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    class DrawThread;
+    class CountDownLatch;
+
+    //
+    // Marks the end of a frame in the command queue of a tile. The tile unswizzles
+    // (and gamma corrects) its color buffer into the frame image, and the presenter
+    // gets notified (with a count down latch) once all tiles are done.
+    //
+    class CommandPresent {
+
+    public:
+        CommandPresent(CountDownLatch &latch, unsigned int *image, int imageWidth)
+
+            : m_latch(&latch),
+              m_image(image),
+              m_imageWidth(imageWidth) {
+
+        }
+        ~CommandPresent() = default;
+
+    public:
+        bool execute(DrawThread *thread);
+
+    private:
+        CountDownLatch *m_latch;
+        unsigned int *m_image;
+        int m_imageWidth;
+    };
+}
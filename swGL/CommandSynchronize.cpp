@@ -9,7 +9,7 @@ namespace SWGL {
     //
     bool CommandSynchronize::execute(DrawThread *thread) {
 
-        m_latch.countDown();
+        m_latch->countDown();
 
         return true;
     }
@@ -1,31 +1,30 @@
 ﻿#pragma once
 
-#include "CommandBase.h"
+#include "Defines.h"
 
 namespace SWGL {
 
+    // Forward declarations
+    class DrawThread;
+    class CountDownLatch;
+
     //
     // Used to synchronize all draw threads with a countdown latch
     //
-    class CommandSynchronize : public CommandBase {
+    class CommandSynchronize {
 
     public:
         CommandSynchronize(CountDownLatch &latch)
         
-            : m_latch(latch) {
+            : m_latch(&latch) {
                 
         }
         ~CommandSynchronize() = default;
 
     public:
-        bool isFlushingQueue() override {
-
-            return true;
-        }
-
-        bool execute(DrawThread *thread) override;
+        bool execute(DrawThread *thread);
 
     private:
-        CountDownLatch &m_latch;
+        CountDownLatch *m_latch;
     };
 }
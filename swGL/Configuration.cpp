@@ -0,0 +1,168 @@
+﻿#include <Windows.h>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <intrin.h>
+#include "Log.h"
+#include "Configuration.h"
+
+namespace SWGL {
+
+    Configuration::Configuration() {
+
+        // Use one drawing thread per hardware thread unless the user says otherwise
+        int numDrawThreads = static_cast<int>(std::thread::hardware_concurrency());
+        if (numDrawThreads <= 0) {
+
+            numDrawThreads = SWGL_DEFAULT_DRAW_THREADS;
+        }
+
+        m_isNumDrawThreadsFixed = readInteger("SWGL_NUM_DRAW_THREADS", 0) > 0;
+
+        numDrawThreads = readInteger("SWGL_NUM_DRAW_THREADS", numDrawThreads);
+        m_numDrawThreads = static_cast<unsigned int>(
+
+            std::clamp(numDrawThreads, 1, static_cast<int>(SWGL_MAX_DRAW_THREADS))
+        );
+
+        // The tile size has to be a multiple of two as the buffers are organized in 2x2 quads
+        m_isTileSizeFixed = readInteger("SWGL_TILE_SIZE", 0) > 0;
+
+        int tileSize = readInteger("SWGL_TILE_SIZE", static_cast<int>(SWGL_DEFAULT_TILE_SIZE));
+        m_tileSize = static_cast<unsigned int>(std::clamp(tileSize, 16, 1024)) & ~1U;
+
+        int numFramesInFlight = readInteger("SWGL_FRAMES_IN_FLIGHT", static_cast<int>(SWGL_DEFAULT_FRAMES_IN_FLIGHT));
+        m_numFramesInFlight = static_cast<unsigned int>(
+
+            std::clamp(numFramesInFlight, 1, static_cast<int>(SWGL_MAX_FRAMES_IN_FLIGHT))
+        );
+
+        int spinTime = readInteger("SWGL_SPIN_TIME", static_cast<int>(SWGL_DEFAULT_SPIN_TIME_US));
+        m_spinTime = std::chrono::microseconds(std::clamp(spinTime, 0, 10000));
+
+        // 0 = none, 1 = compact, 2 = scatter, 3 = one thread per physical core first
+        int affinityPolicy = readInteger("SWGL_AFFINITY", 0);
+        m_affinityPolicy = static_cast<AffinityPolicy>(std::clamp(affinityPolicy, 0, 3));
+
+        // Reassign the tiles to the drawing threads from frame to frame (see LoadBalancer)
+        m_isLoadBalancingEnabled = readInteger("SWGL_LOAD_BALANCING", 1) != 0;
+
+        // Execute the OpenGL calls on a thread of their own (see Frontend)
+        m_isFrontendThreadEnabled = readInteger("SWGL_FRONTEND_THREAD", 0) != 0;
+
+        // Shade opaque triangles after their visibility is known (see VisibilityBuffer.inl)
+        m_isVisibilityBufferEnabled = readInteger("SWGL_VISIBILITY_BUFFER", 0) != 0;
+
+        // 0 = disabled, 1 = use the cached result, 2 = always tune (see AutoTuner)
+        int autoTuneMode = readInteger("SWGL_AUTOTUNE", 0);
+        m_autoTuneMode = static_cast<AutoTuneMode>(std::clamp(autoTuneMode, 0, 2));
+
+        // 0 = SSE2, 1 = SSE4.1, 2 = AVX2, 3 = AVX-512, but never more than the CPU supports
+        int supportedLevel = static_cast<int>(getSupportedSIMDLevel());
+        int simdLevel = readInteger("SWGL_SIMD_LEVEL", supportedLevel);
+        m_simdLevel = static_cast<SIMDLevel>(std::clamp(simdLevel, 0, supportedLevel));
+
+        LOG("Number of drawing threads: %u, Tile size: %u, Frames in flight: %u", m_numDrawThreads, m_tileSize, m_numFramesInFlight);
+        LOG("Spin time: %d us, Affinity policy: %d, Load balancing: %d", static_cast<int>(m_spinTime.count()), static_cast<int>(m_affinityPolicy), m_isLoadBalancingEnabled ? 1 : 0);
+        LOG("Frontend thread: %d, Auto tuning: %d, SIMD level: %d (supported: %d)", m_isFrontendThreadEnabled ? 1 : 0, static_cast<int>(m_autoTuneMode), static_cast<int>(m_simdLevel), supportedLevel);
+        LOG("Visibility buffer: %d", m_isVisibilityBufferEnabled ? 1 : 0);
+    }
+
+
+
+    void Configuration::setTunedValues(unsigned int tileSize, unsigned int numDrawThreads) {
+
+        if (!m_isTileSizeFixed) {
+
+            m_tileSize = std::clamp(tileSize, 16U, 1024U) & ~1U;
+        }
+
+        if (!m_isNumDrawThreadsFixed) {
+
+            m_numDrawThreads = std::clamp(numDrawThreads, 1U, SWGL_MAX_DRAW_THREADS);
+        }
+
+        LOG("Tuned number of drawing threads: %u, Tile size: %u", m_numDrawThreads, m_tileSize);
+    }
+
+
+
+    Configuration &Configuration::getInstance() {
+
+        static Configuration instance;
+        return instance;
+    }
+
+
+
+    int Configuration::readInteger(const char *name, int defaultValue) {
+
+        char buffer[32];
+
+        auto length = GetEnvironmentVariableA(name, buffer, sizeof(buffer));
+        if (length == 0 || length >= sizeof(buffer)) {
+
+            return defaultValue;
+        }
+
+        char *end = nullptr;
+        auto value = std::strtol(buffer, &end, 10);
+        if (end == buffer) {
+
+            LOG("Ignoring invalid value \"%s\" of %s", buffer, name);
+            return defaultValue;
+        }
+
+        return static_cast<int>(value);
+    }
+
+    SIMDLevel Configuration::getSupportedSIMDLevel() {
+
+        int cpuInfo[4];
+
+        __cpuid(cpuInfo, 0);
+        int maxLeaf = cpuInfo[0];
+
+        __cpuid(cpuInfo, 1);
+        if ((cpuInfo[2] & (1 << 19)) == 0) {
+
+            return SIMDLevel::SSE2;
+        }
+
+        // The compiler contracts multiplies and adds into FMA instructions under
+        // /arch:AVX2, so the AVX2 kernels need FMA as well
+        bool isFMASupported = (cpuInfo[2] & (1 << 12)) != 0;
+
+        // The OS has to save the AVX registers on context switches (OSXSAVE and the
+        // XMM/YMM state bits of XCR0)
+        if (maxLeaf < 7 || (cpuInfo[2] & (1 << 27)) == 0 || (cpuInfo[2] & (1 << 28)) == 0) {
+
+            return SIMDLevel::SSE41;
+        }
+
+        auto xcr0 = _xgetbv(0);
+        if ((xcr0 & 0x06) != 0x06) {
+
+            return SIMDLevel::SSE41;
+        }
+
+        // AVX2, BMI1 and BMI2, which the compiler may also use under /arch:AVX2
+        __cpuidex(cpuInfo, 7, 0);
+        auto extendedFeatures = static_cast<unsigned int>(cpuInfo[1]);
+
+        const unsigned int avx2Bits = (1U << 3) | (1U << 5) | (1U << 8);
+        if ((extendedFeatures & avx2Bits) != avx2Bits || !isFMASupported) {
+
+            return SIMDLevel::SSE41;
+        }
+
+        // AVX-512 F, DQ, BW and VL, and the opmask/ZMM state bits of XCR0
+        const unsigned int avx512Bits = (1U << 16) | (1U << 17) | (1U << 30) | (1U << 31);
+        if ((extendedFeatures & avx512Bits) != avx512Bits || (xcr0 & 0xe0) != 0xe0) {
+
+            return SIMDLevel::AVX2;
+        }
+
+        return SIMDLevel::AVX512;
+    }
+}
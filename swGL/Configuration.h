@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include <chrono>
+#include "Defines.h"
+
+namespace SWGL {
+
+    // How the drawing threads are pinned to the logical processors
+    enum class AffinityPolicy {
+
+        None,       // Let the OS schedule the threads
+        Compact,    // Fill up one core (and NUMA node) after the other
+        Scatter,    // Spread the threads across the NUMA nodes and cores
+        SMT         // One thread per physical core before using SMT siblings
+    };
+
+    // Whether the tile size and the number of drawing threads are tuned (see AutoTuner)
+    enum class AutoTuneMode {
+
+        Disabled,   // Use the defaults (or the values of the environment variables)
+        Cached,     // Use the cached result, tune if there is none
+        Always      // Tune on every launch and update the cache
+    };
+
+    // The instruction set of the SIMD kernels (see Kernels.h), the values match the
+    // SWGL_SIMD_* levels of Defines.h
+    enum class SIMDLevel {
+
+        SSE2,
+        SSE41,
+        AVX2,
+        AVX512
+    };
+
+    //
+    // Holds the runtime configuration of swGL. The values are determined once
+    // (on first use) from the hardware and can be overridden with environment
+    // variables.
+    //
+    class Configuration {
+
+    public:
+        ~Configuration() = default;
+
+        static Configuration &getInstance();
+
+    public:
+        unsigned int getNumDrawThreads() const { return m_numDrawThreads; }
+        unsigned int getTileSize() const { return m_tileSize; }
+        unsigned int getNumFramesInFlight() const { return m_numFramesInFlight; }
+        std::chrono::microseconds getSpinTime() const { return m_spinTime; }
+        AffinityPolicy getAffinityPolicy() const { return m_affinityPolicy; }
+        bool isLoadBalancingEnabled() const { return m_isLoadBalancingEnabled; }
+        bool isFrontendThreadEnabled() const { return m_isFrontendThreadEnabled; }
+        bool isVisibilityBufferEnabled() const { return m_isVisibilityBufferEnabled; }
+        AutoTuneMode getAutoTuneMode() const { return m_autoTuneMode; }
+        SIMDLevel getSIMDLevel() const { return m_simdLevel; }
+
+        // Takes over the tuned values, unless the user has set them explicitly. Has to
+        // be called before the first context is created.
+        void setTunedValues(unsigned int tileSize, unsigned int numDrawThreads);
+
+    private:
+        Configuration();
+
+        static int readInteger(const char *name, int defaultValue);
+        static SIMDLevel getSupportedSIMDLevel();
+
+    private:
+        unsigned int m_numDrawThreads;
+        unsigned int m_tileSize;
+        unsigned int m_numFramesInFlight;
+        std::chrono::microseconds m_spinTime;
+        AffinityPolicy m_affinityPolicy;
+        bool m_isLoadBalancingEnabled;
+        bool m_isFrontendThreadEnabled;
+        bool m_isVisibilityBufferEnabled;
+        AutoTuneMode m_autoTuneMode;
+        SIMDLevel m_simdLevel;
+        bool m_isNumDrawThreadsFixed;
+        bool m_isTileSizeFixed;
+    };
+}
@@ -2,18 +2,22 @@
 #include "Defines.h"
 #include "MatrixStack.h"
 #include "VertexPipeline.h"
+#include "DrawThreadPool.h"
+#include "AutoTuner.h"
 #include "Context.h"
 
 namespace SWGL {
 
     std::map<int, ContextPtr> Context::m_contextMap;
-    ContextPtr Context::m_currentContext = nullptr;
+    std::mutex Context::m_contextMutex;
+    thread_local ContextPtr Context::m_currentContext = nullptr;
 
 
 
     Context::Context(ContextID id, HDC hdc)
     
         : m_id(id),
+          m_isInitialized(false),
           m_isCurrent(false),
           m_glExtensions("") {
 
@@ -128,6 +132,26 @@ namespace SWGL {
             addProcedure("glLockArraysEXT", ADDRESS_OF(glDrv_glLockArrays));
             addProcedure("glUnlockArraysEXT", ADDRESS_OF(glDrv_glUnlockArrays));
         }
+        addExtension("GL_NV_fence"); {
+
+            addProcedure("glGenFencesNV", ADDRESS_OF(glDrv_glGenFencesNV));
+            addProcedure("glDeleteFencesNV", ADDRESS_OF(glDrv_glDeleteFencesNV));
+            addProcedure("glSetFenceNV", ADDRESS_OF(glDrv_glSetFenceNV));
+            addProcedure("glTestFenceNV", ADDRESS_OF(glDrv_glTestFenceNV));
+            addProcedure("glFinishFenceNV", ADDRESS_OF(glDrv_glFinishFenceNV));
+            addProcedure("glIsFenceNV", ADDRESS_OF(glDrv_glIsFenceNV));
+            addProcedure("glGetFenceivNV", ADDRESS_OF(glDrv_glGetFenceivNV));
+        }
+        addExtension("GL_ARB_sync"); {
+
+            addProcedure("glFenceSync", ADDRESS_OF(glDrv_glFenceSync));
+            addProcedure("glIsSync", ADDRESS_OF(glDrv_glIsSync));
+            addProcedure("glDeleteSync", ADDRESS_OF(glDrv_glDeleteSync));
+            addProcedure("glClientWaitSync", ADDRESS_OF(glDrv_glClientWaitSync));
+            addProcedure("glWaitSync", ADDRESS_OF(glDrv_glWaitSync));
+            addProcedure("glGetInteger64v", ADDRESS_OF(glDrv_glGetInteger64v));
+            addProcedure("glGetSynciv", ADDRESS_OF(glDrv_glGetSynciv));
+        }
         addExtension("WGL_3DFX_gamma_control"); {
 
             addProcedure("wglGetDeviceGammaRamp3DFX", ADDRESS_OF(glDrv_wglGetDeviceGammaRamp));
@@ -137,6 +161,10 @@ namespace SWGL {
 
             addProcedure("wglGetExtensionsStringARB", ADDRESS_OF(glDrv_wglGetExtensionsString));
         }
+        addExtension("WGL_SWGL_context_priority"); {
+
+            addProcedure("wglSetContextPrioritySWGL", ADDRESS_OF(glDrv_wglSetContextPriority));
+        }
     }
 
 
@@ -144,13 +172,19 @@ namespace SWGL {
     void Context::init() {
 
         m_renderer.init();
-        m_isCurrent = true;
+
+        // The calls executed by the frontend thread refer to this context
+        auto self = shared_from_this();
+        m_frontend.start([self] { m_currentContext = self; });
+
+        m_isInitialized = true;
     }
 
     void Context::shutdown() {
 
+        m_frontend.stop();
         m_renderer.shutdown();
-        m_isCurrent = false;
+        m_isInitialized = false;
     }
 
 
@@ -191,12 +225,19 @@ namespace SWGL {
 
     ContextID Context::createContext(HDC hdc) {
 
+        std::lock_guard<std::mutex> cs(m_contextMutex);
+
         static SWGL::ContextID id(1U);
 
         if (id == 0) {
         
             id++;
         }
+
+        // The tuned configuration has to be known before the first drawing surface
+        // and the drawing threads are set up
+        AutoTuner::tuneOnce(hdc);
+
         m_contextMap[id] = std::make_shared<SWGL::Context>(id, hdc);
 
         return id++;
@@ -204,6 +245,8 @@ namespace SWGL {
 
     ContextPtr Context::getContext(SWGL::ContextID id) {
 
+        std::lock_guard<std::mutex> cs(m_contextMutex);
+
         auto context = m_contextMap.find(id);
         if (context != m_contextMap.end()) {
 
@@ -214,43 +257,85 @@ namespace SWGL {
 
     bool Context::deleteContext(SWGL::ContextID id) {
 
-        auto context = getContext(id);
-        if (context != nullptr) {
+        std::lock_guard<std::mutex> cs(m_contextMutex);
+
+        auto entry = m_contextMap.find(id);
+        if (entry != m_contextMap.end()) {
+
+            auto context = entry->second;
+
+            // A context can't be deleted while another thread uses it
+            if (context->m_isCurrent && context != m_currentContext) {
+
+                LOG("Context %u is current on another thread", id);
+                return false;
+            }
 
             if (context == m_currentContext) {
 
-                m_currentContext->shutdown();
+                m_currentContext->getFrontend().finish();
+                m_currentContext->m_isCurrent = false;
                 m_currentContext = nullptr;
             }
 
-            m_contextMap.erase(id);
+            if (context->m_isInitialized) {
+
+                context->shutdown();
+            }
+
+            m_contextMap.erase(entry);
+
+            // Nobody needs the drawing threads anymore
+            if (m_contextMap.empty()) {
+
+                DrawThreadPool::getInstance().stop();
+            }
+
             return true;
         }
 
         return false;
     }
 
-    void Context::setCurrentContext(ContextPtr context, HDC hdc) {
+    bool Context::setCurrentContext(ContextPtr context, HDC hdc) {
+
+        std::lock_guard<std::mutex> cs(m_contextMutex);
+
+        // A context can only be current on one thread at a time
+        if (context != nullptr && context != m_currentContext && context->m_isCurrent) {
 
-        if (m_currentContext != nullptr &&
-            m_currentContext != context) {
+            LOG("Context %u is current on another thread", context->getContextID());
+            return false;
+        }
+
+        // The queued calls refer to the current context, so they have to be done
+        // before it changes. The released context stays attached to the drawing
+        // threads, it only hands its pending work over to them.
+        if (m_currentContext != nullptr) {
+
+            m_currentContext->getFrontend().finish();
+
+            if (m_currentContext != context) {
 
-            m_currentContext->shutdown();
+                m_currentContext->getRenderer().flush();
+                m_currentContext->m_isCurrent = false;
+            }
         }
 
+        m_currentContext = context;
+
         if (context != nullptr) {
 
-            if (context != m_currentContext) {
+            if (!context->m_isInitialized) {
+
                 context->init();
-                m_currentContext = context;
             }
 
-            m_currentContext->getRenderer().getDrawSurface().setHDC(hdc);
+            context->m_isCurrent = true;
+            context->getRenderer().setHDC(hdc);
         }
-        else {
 
-            m_currentContext = nullptr;
-        }
+        return true;
     }
 
     const ContextPtr &Context::getCurrentContext() {
@@ -2,12 +2,15 @@
 
 #include <Windows.h>
 #include <memory>
+#include <mutex>
 #include <map>
 #include "OpenGL.h"
 #include "Wiggle.h"
 #include "Renderer.h"
 #include "VertexPipeline.h"
 #include "TextureManager.h"
+#include "FenceManager.h"
+#include "Frontend.h"
 #include "ContextTypes.h"
 
 namespace SWGL {
@@ -20,9 +23,11 @@ namespace SWGL {
     using ContextID = unsigned int;
 
     //
-    // The context is the root object of swGL
+    // The context is the root object of swGL. Every thread has a current context of
+    // its own, and a context keeps its renderer attached to the drawing threads from
+    // the first time it's made current until it's deleted.
     //
-    class Context {
+    class Context : public std::enable_shared_from_this<Context> {
 
     public:
         Context(ContextID id, HDC hdc);
@@ -36,7 +41,7 @@ namespace SWGL {
         static ContextID createContext(HDC hdc);
         static ContextPtr getContext(ContextID id);
         static bool deleteContext(ContextID id);
-        static void setCurrentContext(ContextPtr context, HDC hdc);
+        static bool setCurrentContext(ContextPtr context, HDC hdc);
         static const ContextPtr &getCurrentContext();
 
     public:
@@ -48,9 +53,11 @@ namespace SWGL {
         DepthTesting &getDepthTesting() { return m_depthTesting; }
         Blending &getBlending() { return m_blending; }
         TextureManager &getTextureManager() { return m_textureManager; }
+        FenceManager &getFenceManager() { return m_fenceManager; }
         PolygonOffset &getPolygonOffset() { return m_polygonOffset; }
         ColorMask &getColorMask() { return m_colorMask; }
         Renderer &getRenderer() { return m_renderer; }
+        Frontend &getFrontend() { return m_frontend; }
         GLError &getError() { return m_error; }
 
     public:
@@ -62,6 +69,7 @@ namespace SWGL {
 
     private:
         ContextID m_id;
+        bool m_isInitialized;
         bool m_isCurrent;
 
     private:
@@ -79,7 +87,9 @@ namespace SWGL {
         Blending m_blending;
         ColorMask m_colorMask;
         TextureManager m_textureManager;
+        FenceManager m_fenceManager;
         Renderer m_renderer;
+        Frontend m_frontend;
 
     private:
         void addProcedure(std::string name, const void *address);
@@ -89,6 +99,7 @@ namespace SWGL {
 
     private:
         static std::map<int, ContextPtr> m_contextMap;
-        static ContextPtr m_currentContext;
+        static std::mutex m_contextMutex;
+        static thread_local ContextPtr m_currentContext;
     };
 }
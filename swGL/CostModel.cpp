@@ -0,0 +1,108 @@
+﻿#include <algorithm>
+#include "Triangle.h"
+#include "ContextTypes.h"
+#include "TextureManager.h"
+#include "CommandDrawTriangle.h"
+#include "CostModel.h"
+
+namespace SWGL {
+
+    // Relative costs of the different parts of the rasterization (one unit is roughly
+    // the cost of clearing a single pixel). Only the conversion into time is calibrated
+    // at runtime, the ratios between the parts stay fixed.
+    static constexpr int COST_TRIANGLE_SETUP = 256;
+    static constexpr int COST_PIXEL = 4;
+    static constexpr int COST_PIXEL_TEXTURE = 8;
+    static constexpr int COST_PIXEL_BLENDING = 2;
+    static constexpr int COST_PIXEL_ALPHA_TEST = 1;
+    static constexpr int COST_PIXEL_DEPTH_TEST = 1;
+
+    // Initial guess of the conversion factor until the first measurements are in
+    static constexpr float INITIAL_NANOSECONDS_PER_UNIT = 1.0f;
+
+    // Measurements with less work than this are too noisy to be taken into account
+    static constexpr int MIN_MEASUREMENT_UNITS = 4096;
+
+    // Weight of a new measurement in the moving average
+    static constexpr float MEASUREMENT_WEIGHT = 0.1f;
+
+
+
+    CostModel::CostModel()
+
+        : m_nanosecondsPerUnit(INITIAL_NANOSECONDS_PER_UNIT) {
+
+    }
+
+
+
+    int CostModel::getPixelCost(TriangleDrawCallState &state) {
+
+        auto &stateBlock = *state.stateBlock;
+        int cost = COST_PIXEL;
+
+        for (auto i = 0U; i < SWGL_MAX_TEXTURE_UNITS; i++) {
+
+            if (stateBlock.textures[i].texData != nullptr) {
+
+                cost += COST_PIXEL_TEXTURE;
+            }
+        }
+
+        if (stateBlock.blending.isEnabled()) {
+
+            cost += COST_PIXEL_BLENDING;
+        }
+
+        if (stateBlock.alphaTesting.isEnabled()) {
+
+            cost += COST_PIXEL_ALPHA_TEST;
+        }
+
+        if (stateBlock.depthTesting.isTestEnabled()) {
+
+            cost += COST_PIXEL_DEPTH_TEST;
+        }
+
+        return cost;
+    }
+
+    long long CostModel::getTriangleCost(int pixelCost, int boxArea) {
+
+        // A triangle covers about half of its bounding box. The costs of a bin or a
+        // tile can get past the range of an int for big triangles with expensive
+        // pixels, so they are summed up as long long.
+        return COST_TRIANGLE_SETUP + ((static_cast<long long>(boxArea) * pixelCost) >> 1);
+    }
+
+    long long CostModel::getClearCost(int area) {
+
+        return area;
+    }
+
+
+
+    void CostModel::addMeasurement(long long costUnits, long long nanoseconds) {
+
+        if (costUnits < MIN_MEASUREMENT_UNITS) {
+
+            return;
+        }
+
+        auto sample = static_cast<float>(nanoseconds) / static_cast<float>(costUnits);
+
+        std::lock_guard<std::mutex> cs(m_mutex);
+
+        auto current = m_nanosecondsPerUnit.load(std::memory_order_relaxed);
+        m_nanosecondsPerUnit.store(
+
+            current + MEASUREMENT_WEIGHT * (sample - current),
+            std::memory_order_relaxed
+        );
+    }
+
+    bool CostModel::isWorthWakeUp(long long costUnits) const {
+
+        return static_cast<float>(costUnits) * getNanosecondsPerUnit() >= static_cast<float>(SWGL_DISPATCH_THRESHOLD_NS);
+    }
+}
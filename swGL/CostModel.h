@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include <mutex>
+#include <atomic>
+#include "Defines.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    struct TriangleDrawCallState;
+
+    //
+    // Estimates how expensive the commands are and decides when it is worth to wake
+    // up a drawing thread. The estimates are given in abstract cost units which are
+    // converted into time by a factor that is calibrated from the measured execution
+    // times of the drawing threads.
+    //
+    class CostModel {
+
+    public:
+        CostModel();
+        ~CostModel() = default;
+
+    public:
+        static int getPixelCost(TriangleDrawCallState &state);
+        static long long getTriangleCost(int pixelCost, int boxArea);
+        static long long getClearCost(int area);
+
+    public:
+        void addMeasurement(long long costUnits, long long nanoseconds);
+        bool isWorthWakeUp(long long costUnits) const;
+
+        float getNanosecondsPerUnit() const { return m_nanosecondsPerUnit.load(std::memory_order_relaxed); }
+
+    private:
+        std::mutex m_mutex;
+        std::atomic<float> m_nanosecondsPerUnit;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 
 namespace SWGL {
@@ -44,6 +45,20 @@ namespace SWGL {
             });
         }
 
+        bool waitFor(std::chrono::nanoseconds timeout) {
+
+            std::unique_lock<std::mutex> cs(m_mutex);
+            return m_condition.wait_for(cs, timeout, [this] {
+
+                return m_count == 0;
+            });
+        }
+
+        bool isDone() const {
+
+            return m_count.load() == 0;
+        }
+
     private:
         std::mutex m_mutex;
         std::atomic<int> m_count;
@@ -17,6 +17,12 @@
 // Enables avx2 instructions to gather texture samples (if avx2 is available).
 #define SWGL_USE_AVX2_GATHER 0
 
+// The instruction sets the SIMD kernels are compiled for (see Kernels.h)
+#define SWGL_SIMD_SSE2 0
+#define SWGL_SIMD_SSE41 1
+#define SWGL_SIMD_AVX2 2
+#define SWGL_SIMD_AVX512 3
+
 // Whether swGL should use hardware gamma correction, or not
 #define SWGL_USE_HARDWARE_GAMMA 1
 
@@ -26,6 +32,9 @@
 // Enable / disable log file flushing
 #define SWGL_ENABLE_LOG_FLUSH 0
 
+// Enable / disable the collection of statistics (written into the log file)
+#define SWGL_ENABLE_STATISTICS 0
+
 // The maximum number of matrices for one stack
 static constexpr unsigned int SWGL_MAX_MATRIXSTACK_DEPTH = 32U;
 
@@ -44,12 +53,90 @@ static constexpr unsigned int SWGL_MAX_CLIP_PLANES = 6U;
 // Maximum number of lights
 static constexpr unsigned int SWGL_MAX_LIGHTS = 8U;
 
-// Number of drawing threads
-static constexpr unsigned int SWGL_NUM_DRAW_THREADS = 16U;
+// Number of drawing threads if the hardware concurrency can't be determined. The actual
+// number is chosen at runtime (see Configuration) and can be overridden with the
+// environment variable SWGL_NUM_DRAW_THREADS.
+static constexpr unsigned int SWGL_DEFAULT_DRAW_THREADS = 4U;
+
+// Maximum number of drawing threads
+static constexpr unsigned int SWGL_MAX_DRAW_THREADS = 64U;
+
+// Default priority of a context. The drawing threads are shared by all contexts, each
+// context gets a share of them proportional to its priority. Can be changed per context
+// with wglSetContextPrioritySWGL().
+static constexpr int SWGL_DEFAULT_CONTEXT_PRIORITY = 8;
+
+// Maximum priority of a context
+static constexpr int SWGL_MAX_CONTEXT_PRIORITY = 64;
+
+// Maximum amount of (virtual) drawing time in nanoseconds a context that had nothing to
+// draw for a while may catch up on the others
+static constexpr long long SWGL_MAX_SCHEDULING_LAG_NS = 2000000;
 
-// Maximum number of commands in the command queue of a drawing thread
+// Default edge length (in pixels) of a screen tile. The drawing surface is split into
+// tiles which are distributed between the drawing threads. Can be overridden with the
+// environment variable SWGL_TILE_SIZE.
+static constexpr unsigned int SWGL_DEFAULT_TILE_SIZE = 64U;
+
+// Default number of frames that may be in flight. While a frame is being presented the
+// next ones can already be drawn. Can be overridden with the environment variable
+// SWGL_FRAMES_IN_FLIGHT (1 presents every frame before the next one is started).
+static constexpr unsigned int SWGL_DEFAULT_FRAMES_IN_FLIGHT = 2U;
+
+// Maximum number of frames in flight
+static constexpr unsigned int SWGL_MAX_FRAMES_IN_FLIGHT = 4U;
+
+// Default time (in microseconds) an idle drawing thread spins and waits for new work
+// before it goes to sleep. Can be overridden with the environment variable
+// SWGL_SPIN_TIME (0 disables spinning).
+static constexpr unsigned int SWGL_DEFAULT_SPIN_TIME_US = 50U;
+
+// Maximum number of commands in the command queue of a tile
 static constexpr unsigned int SWGL_COMMAND_QUEUE_SIZE = 64U;
 
+// Number of triangles that are binned as one piece. Draw calls with more triangles are
+// binned in parallel.
+static constexpr int SWGL_BINNING_CHUNK_SIZE = 2048;
+
+// Number of vertices / triangles that are processed as one piece by the vertex pipeline.
+// Larger draw calls are transformed, lit and clipped in parallel.
+static constexpr int SWGL_GEOMETRY_CHUNK_SIZE = 1024;
+
+// Maximum number of draw state blocks that are cached (see DrawStateCache). If the state
+// changes more often within the frames in flight, the renderer has to wait for the drawing
+// threads before the blocks can be freed.
+static constexpr int SWGL_MAX_DRAW_STATE_BLOCKS = 4096;
+
+// Consecutive draw calls with the same state are merged into one batch (see Renderer) until
+// it holds this many triangles
+static constexpr unsigned int SWGL_MAX_BATCH_TRIANGLES = 4096U;
+
+// Size (in pixels) of the blocks that are tested for coverage as a whole before the
+// triangle is rasterized quad by quad (see CommandDrawTriangle). The blocks are aligned
+// to the tile, and each of them keeps the range of its depth values (see DrawBuffer).
+// Must be a multiple of 4.
+static constexpr int SWGL_RASTER_BLOCK_SIZE = 8;
+
+// Maximum number of OpenGL calls that can be queued for the frontend thread (see Frontend)
+static constexpr unsigned int SWGL_FRONTEND_QUEUE_SIZE = 4096U;
+
+// Maximum size (in bytes) of the arguments of a queued OpenGL call
+static constexpr unsigned int SWGL_FRONTEND_CALL_SIZE = 120U;
+
+// Number of frames the application may queue for the frontend thread before it has to
+// wait in SwapBuffers()
+static constexpr int SWGL_FRONTEND_MAX_QUEUED_FRAMES = 1;
+
+// Size of the memory blocks of the command arenas
+static constexpr unsigned int SWGL_COMMAND_ARENA_BLOCK_SIZE = 1U << 20;
+
+// Number of frames over which the statistics are averaged
+static constexpr int SWGL_STATISTICS_INTERVAL = 100;
+
+// Minimum amount of work (estimated time in nanoseconds) that is batched up before a
+// drawing thread is woken up. Smaller batches don't pay off the cost of the wake-up.
+static constexpr unsigned int SWGL_DISPATCH_THRESHOLD_NS = 50000U;
+
 // Returns true if a given integer is a power of two
 template<typename T>
 static constexpr bool isPowerOfTwo(T value) {
@@ -58,7 +145,10 @@ static constexpr bool isPowerOfTwo(T value) {
 }
 
 // Some compile time error checks
-static_assert(isPowerOfTwo(SWGL_NUM_DRAW_THREADS), "The number of drawing threads has to be a power of two");
+static_assert(SWGL_DEFAULT_DRAW_THREADS <= SWGL_MAX_DRAW_THREADS, "The default number of drawing threads exceeds the maximum");
+static_assert(SWGL_DEFAULT_FRAMES_IN_FLIGHT <= SWGL_MAX_FRAMES_IN_FLIGHT, "The default number of frames in flight exceeds the maximum");
+static_assert(SWGL_DEFAULT_CONTEXT_PRIORITY <= SWGL_MAX_CONTEXT_PRIORITY, "The default context priority exceeds the maximum");
+static_assert((SWGL_DEFAULT_TILE_SIZE & 1U) == 0U, "The tile size has to be a multiple of two");
 static_assert(SWGL_MAX_MATRIXSTACK_DEPTH >= 32U, "The matrix stack depth has to be at least 32");
 static_assert(SWGL_MAX_TEXTURE_UNITS >= 2U, "The number of texture units has to be at least 2");
 static_assert(SWGL_MAX_LIGHTS >= 8U, "The number of lights has to be at least 8");
@@ -0,0 +1,202 @@
+﻿#include <algorithm>
+#include <climits>
+#include "DrawBuffer.h"
+
+namespace SWGL {
+
+    void DrawBuffer::resize(int minX, int minY, int maxX, int maxY) {
+
+        m_minX = minX; m_minY = minY;
+        m_maxX = maxX; m_maxY = maxY;
+
+        m_width = maxX - minX;
+        m_height = maxY - minY;
+        m_size = m_width * m_height;
+
+        m_color.resize(m_size);
+        m_depth.resize(m_size);
+
+        // Nothing is known about the depth values until the first clear
+        m_numDepthBlocksX = (m_width + SWGL_RASTER_BLOCK_SIZE - 1) / SWGL_RASTER_BLOCK_SIZE;
+        m_numDepthBlocksY = (m_height + SWGL_RASTER_BLOCK_SIZE - 1) / SWGL_RASTER_BLOCK_SIZE;
+        m_depthBounds.assign(m_numDepthBlocksX * m_numDepthBlocksY, { INT_MIN, INT_MAX });
+        m_tileDepthBounds = { INT_MIN, INT_MAX };
+
+        // The visibility buffer is only allocated once it is used
+        m_visibility.clear();
+        m_visibleTriangles.clear();
+        m_visibilityBlocks.assign(m_numDepthBlocksX * m_numDepthBlocksY, 0);
+    }
+
+
+
+    int DrawBuffer::getMinX() { return m_minX; }
+    int DrawBuffer::getMaxX() { return m_maxX; }
+    int DrawBuffer::getMinY() { return m_minY; }
+    int DrawBuffer::getMaxY() { return m_maxY; }
+
+    int DrawBuffer::getWidth() { return m_width; }
+    int DrawBuffer::getHeight() { return m_height; }
+
+    unsigned int *DrawBuffer::getColor() { return m_color.data(); }
+    unsigned int *DrawBuffer::getDepth() { return m_depth.data(); }
+
+
+
+    DepthBounds &DrawBuffer::getDepthBounds(int x, int y) {
+
+        int blockX = (x - m_minX) / SWGL_RASTER_BLOCK_SIZE;
+        int blockY = (y - m_minY) / SWGL_RASTER_BLOCK_SIZE;
+
+        return m_depthBounds[blockX + (blockY * m_numDepthBlocksX)];
+    }
+
+    DepthBounds &DrawBuffer::getTileDepthBounds() { return m_tileDepthBounds; }
+
+    int DrawBuffer::getNumDepthBlocksX() { return m_numDepthBlocksX; }
+    int DrawBuffer::getNumDepthBlocksY() { return m_numDepthBlocksY; }
+
+    void DrawBuffer::updateTileDepthBounds() {
+
+        DepthBounds bounds = { INT_MAX, INT_MIN };
+
+        for (auto &blockBounds : m_depthBounds) {
+
+            bounds.min = std::min(bounds.min, blockBounds.min);
+            bounds.max = std::max(bounds.max, blockBounds.max);
+        }
+
+        m_tileDepthBounds = bounds;
+    }
+
+
+
+    unsigned int *DrawBuffer::getVisibility() {
+
+        if (m_visibility.empty()) {
+
+            m_visibility.assign(m_size, 0);
+        }
+
+        return m_visibility.data();
+    }
+
+    unsigned int DrawBuffer::addVisibleTriangle(TriangleDrawCallState *state, int index) {
+
+        m_visibleTriangles.push_back({ state, index });
+        return static_cast<unsigned int>(m_visibleTriangles.size());
+    }
+
+    VisibleTriangle &DrawBuffer::getVisibleTriangle(unsigned int id) { return m_visibleTriangles[id - 1]; }
+
+    void DrawBuffer::markVisibilityBlock(int x, int y) {
+
+        int blockX = (x - m_minX) / SWGL_RASTER_BLOCK_SIZE;
+        int blockY = (y - m_minY) / SWGL_RASTER_BLOCK_SIZE;
+
+        m_visibilityBlocks[blockX + (blockY * m_numDepthBlocksX)] = 1;
+    }
+
+    bool DrawBuffer::isVisibilityBlockMarked(int blockIdx) { return m_visibilityBlocks[blockIdx] != 0; }
+
+    void DrawBuffer::resolveVisibility() {
+
+        if (!m_visibleTriangles.empty()) {
+
+            Kernels::get().resolveVisibility(*this);
+        }
+    }
+
+    void DrawBuffer::endVisibility() {
+
+        m_visibleTriangles.clear();
+        std::fill(m_visibilityBlocks.begin(), m_visibilityBlocks.end(), 0);
+    }
+
+
+
+    void DrawBuffer::unswizzleColor(unsigned int *dst, int dstWidth) {
+
+        Kernels::get().unswizzleColor(*this, dst, dstWidth);
+    }
+
+
+
+    template<typename T>
+    void DrawBuffer::clear(T *dst, T value, int minX, int minY, int maxX, int maxY) {
+
+        minX = std::max(minX, m_minX) - m_minX;
+        minY = std::max(minY, m_minY) - m_minY;
+        maxX = std::min(maxX, m_maxX) - m_minX;
+        maxY = std::min(maxY, m_maxY) - m_minY;
+
+        if (minX == 0 && minY == 0 && maxX == m_width && maxY == m_height) {
+
+            std::fill(dst, dst + m_size, value);
+        }
+        else {
+
+            // TODO: Optimize this later.
+            for (int y = minY; y < maxY; y++) {
+
+                T *p = &dst[((y & 1) << 1) + ((y & ~1) * m_width)];
+
+                for (int x = minX; x < maxX; x++) {
+
+                    p[((x & ~1) << 1) + (x & 1)] = value;
+                }
+            }
+        }
+    }
+
+    void DrawBuffer::clearDepthBounds(int value, int minX, int minY, int maxX, int maxY) {
+
+        minX = std::max(minX, m_minX) - m_minX;
+        minY = std::max(minY, m_minY) - m_minY;
+        maxX = std::min(maxX, m_maxX) - m_minX;
+        maxY = std::min(maxY, m_maxY) - m_minY;
+
+        if (minX >= maxX || minY >= maxY) {
+
+            return;
+        }
+
+        for (int blockY = minY / SWGL_RASTER_BLOCK_SIZE; blockY * SWGL_RASTER_BLOCK_SIZE < maxY; blockY++) {
+
+            int y0 = blockY * SWGL_RASTER_BLOCK_SIZE;
+            int y1 = std::min(y0 + SWGL_RASTER_BLOCK_SIZE, m_height);
+
+            for (int blockX = minX / SWGL_RASTER_BLOCK_SIZE; blockX * SWGL_RASTER_BLOCK_SIZE < maxX; blockX++) {
+
+                int x0 = blockX * SWGL_RASTER_BLOCK_SIZE;
+                int x1 = std::min(x0 + SWGL_RASTER_BLOCK_SIZE, m_width);
+
+                auto &bounds = m_depthBounds[blockX + (blockY * m_numDepthBlocksX)];
+
+                // Blocks which are only partially cleared keep their other values
+                if (minX <= x0 && minY <= y0 && maxX >= x1 && maxY >= y1) {
+
+                    bounds = { value, value };
+                }
+                else {
+
+                    bounds.min = std::min(bounds.min, value);
+                    bounds.max = std::max(bounds.max, value);
+                }
+            }
+        }
+
+        updateTileDepthBounds();
+    }
+
+    void DrawBuffer::clearColor(unsigned int value, int minX, int minY, int maxX, int maxY) {
+
+        clear(m_color.data(), value, minX, minY, maxX, maxY);
+    }
+
+    void DrawBuffer::clearDepth(unsigned int value, int minX, int minY, int maxX, int maxY) {
+
+        clear(m_depth.data(), value, minX, minY, maxX, maxY);
+        clearDepthBounds(static_cast<int>(value), minX, minY, maxX, maxY);
+    }
+}
@@ -3,22 +3,42 @@
 #include <vector>
 #include <memory>
 #include "AlignedAllocator.h"
+#include "SIMD.h"
+#include "Kernels.h"
 
 namespace SWGL {
 
-    // Forward declarations
-    class DrawBuffer;
-
     // Type aliases
     template<typename T>
     using BufferType = std::vector<T, AlignedAllocator<T, 16>>;
 
     using ColorBuffer = BufferType<unsigned int>;
     using DepthBuffer = BufferType<unsigned int>;
-    using DrawBufferPtr = std::shared_ptr<DrawBuffer>;
 
+    // The range of depth values in a part of the depth buffer. The values are compared as
+    // signed integers like the depth test of the kernels does.
+    struct DepthBounds {
+
+        int min;
+        int max;
+    };
+
+    // A triangle whose shading was deferred by the visibility pass (see VisibilityBuffer.inl)
+    struct VisibleTriangle {
+
+        TriangleDrawCallState *state;
+        int index;
+    };
+
+    //
+    // Holds the drawing buffers for one particular tile. The depth buffer is divided into
+    // blocks of SWGL_RASTER_BLOCK_SIZE pixels, and the range of the depth values of every
+    // block and of the whole tile is kept up to date by the clears and the depth writes.
+    // The kernels test triangles and blocks against it, so occluded ones are rejected
+    // without looking at their quads.
     //
-    // Holds the drawing buffers for one particular thread
+    // The members are compiled in DrawBuffer.cpp only, as the kernels of every instruction
+    // set call them (see Kernels.inl).
     //
     class DrawBuffer {
 
@@ -27,102 +47,65 @@ namespace SWGL {
         ~DrawBuffer() = default;
 
     public:
-        void resize(int minX, int minY, int maxX, int maxY) {
-
-            m_minX = minX; m_minY = minY;
-            m_maxX = maxX; m_maxY = maxY;
-
-            m_width = maxX - minX;
-            m_height = maxY - minY;
-            m_size = m_width * m_height;
-
-            m_color.resize(m_size);
-            m_depth.resize(m_size);
-        }
+        void resize(int minX, int minY, int maxX, int maxY);
 
     public:
-        int getMinX() { return m_minX; }
-        int getMaxX() { return m_maxX; }
-        int getMinY() { return m_minY; }
-        int getMaxY() { return m_maxY; }
+        int getMinX();
+        int getMaxX();
+        int getMinY();
+        int getMaxY();
 
-        int getWidth() { return m_width; }
-        int getHeight() { return m_height; }
+        int getWidth();
+        int getHeight();
 
     public:
-        unsigned int *getColor() { return m_color.data(); }
-        unsigned int *getDepth() { return m_depth.data(); }
+        unsigned int *getColor();
+        unsigned int *getDepth();
 
     public:
-        void unswizzleColor(unsigned int *dst, int dstWidth) {
-
-            unswizzle(m_color.data(), dst, dstWidth);
-        }
+        // The depth bounds of the block which contains the pixel
+        DepthBounds &getDepthBounds(int x, int y);
+        DepthBounds &getTileDepthBounds();
 
-        void clearColor(unsigned int value, int minX, int minY, int maxX, int maxY) {
+        int getNumDepthBlocksX();
+        int getNumDepthBlocksY();
 
-            clear(m_color.data(), value, minX, minY, maxX, maxY);
-        }
+        // Tightens the depth bounds of the tile after the bounds of blocks have changed.
+        // In the meantime the bounds of the tile are only widened.
+        void updateTileDepthBounds();
 
-        void clearDepth(unsigned int value, int minX, int minY, int maxX, int maxY) {
-
-            clear(m_depth.data(), value, minX, minY, maxX, maxY);
-        }
-
-    private:
-        template<typename T>
-        void unswizzle(T *src, T *dst, int dstWidth) {
+    public:
+        // The ids of the visible triangles per pixel, 0 means that there is nothing left
+        // to shade. An id is the index of the triangle in the list plus one.
+        unsigned int *getVisibility();
 
-            // Calculate offsets
-            auto startOffset = m_minX + (m_minY * dstWidth);
-            auto rowOffset = (dstWidth << 1) - m_width;
+        unsigned int addVisibleTriangle(TriangleDrawCallState *state, int index);
+        VisibleTriangle &getVisibleTriangle(unsigned int id);
 
-            // Unswizzle the data
-            auto dstRow1 = dst + startOffset;
-            auto dstRow2 = dst + startOffset + dstWidth;
+        // Blocks which hold ids, the pixel is in absolute coordinates like getDepthBounds()
+        void markVisibilityBlock(int x, int y);
+        bool isVisibilityBlockMarked(int blockIdx);
 
-            // TODO: Optimize this later.
-            for (int y = 0; y < m_height; y += 2) {
+        // Shades the pixels of the visibility pass (see VisibilityBuffer.inl). This has to
+        // happen before anything else reads or writes the color buffer, and before the
+        // draw calls of the visible triangles are released.
+        void resolveVisibility();
 
-                for (int x = 0; x < m_width; x += 2, src += 4) {
+        // Called by the resolve kernel once all ids are shaded and cleared
+        void endVisibility();
 
-                    *dstRow1++ = src[0]; // (x0,y0)
-                    *dstRow1++ = src[1]; // (x1,y0)
-                    *dstRow2++ = src[2]; // (x0,y1)
-                    *dstRow2++ = src[3]; // (x1,y1)
-                }
+    public:
+        // Writes the color buffer into a linear image (see DrawBuffer.inl)
+        void unswizzleColor(unsigned int *dst, int dstWidth);
 
-                dstRow1 += rowOffset;
-                dstRow2 += rowOffset;
-            }
-        }
+        void clearColor(unsigned int value, int minX, int minY, int maxX, int maxY);
+        void clearDepth(unsigned int value, int minX, int minY, int maxX, int maxY);
 
+    private:
         template<typename T>
-        void clear(T *dst, T value, int minX, int minY, int maxX, int maxY) {
-
-            minX = std::max(minX, m_minX) - m_minX;
-            minY = std::max(minY, m_minY) - m_minY;
-            maxX = std::min(maxX, m_maxX) - m_minX;
-            maxY = std::min(maxY, m_maxY) - m_minY;
-
-            if (minX == 0 && minY == 0 && maxX == m_width && maxY == m_height) {
-
-                std::fill(dst, dst + m_size, value);
-            }
-            else {
+        void clear(T *dst, T value, int minX, int minY, int maxX, int maxY);
 
-                // TODO: Optimize this later.
-                for (int y = minY; y < maxY; y++) {
-
-                    T *p = &dst[((y & 1) << 1) + ((y & ~1) * m_width)];
-
-                    for (int x = minX; x < maxX; x++) {
-
-                        p[((x & ~1) << 1) + (x & 1)] = value;
-                    }
-                }
-            }
-        }
+        void clearDepthBounds(int value, int minX, int minY, int maxX, int maxY);
 
     private:
         int m_minY, m_maxY;
@@ -133,5 +116,16 @@ namespace SWGL {
     private:
         ColorBuffer m_color;
         DepthBuffer m_depth;
+
+    private:
+        std::vector<DepthBounds> m_depthBounds;
+        DepthBounds m_tileDepthBounds;
+        int m_numDepthBlocksX;
+        int m_numDepthBlocksY;
+
+    private:
+        BufferType<unsigned int> m_visibility;
+        std::vector<VisibleTriangle> m_visibleTriangles;
+        std::vector<unsigned char> m_visibilityBlocks;
     };
 }
@@ -0,0 +1,119 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <climits>
+#include "SIMD.h"
+#include "DrawBuffer.h"
+
+#if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2
+#include "SIMDAVX2.h"
+#endif
+
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    //
+    // Recomputes the depth bounds of a block after depth values have been written to it
+    // and widens the bounds of the tile by them (see DrawBuffer)
+    //
+    static void updateDepthBounds(DrawBuffer &drawBuffer, int blockX, int blockY) {
+
+        int width = drawBuffer.getWidth();
+        int minX = blockX - drawBuffer.getMinX();
+        int minY = blockY - drawBuffer.getMinY();
+        int maxX = SIMD::min(minX + SWGL_RASTER_BLOCK_SIZE, width);
+        int maxY = SIMD::min(minY + SWGL_RASTER_BLOCK_SIZE, drawBuffer.getHeight());
+
+        QInt minZ = _mm_set1_epi32(INT_MAX);
+        QInt maxZ = _mm_set1_epi32(INT_MIN);
+
+        for (int y = minY; y < maxY; y += 2) {
+
+            auto depthBuffer = drawBuffer.getDepth() + (minX << 1) + (y * width);
+
+            for (int x = minX; x < maxX; x += 2) {
+
+                QInt z = _mm_load_si128(reinterpret_cast<QInt *>(depthBuffer));
+                minZ = SIMD::min(minZ, z);
+                maxZ = SIMD::max(maxZ, z);
+
+                depthBuffer += 4;
+            }
+        }
+
+        // Reduce the four lanes
+        minZ = SIMD::min(minZ, _mm_shuffle_epi32(minZ, _MM_SHUFFLE(1, 0, 3, 2)));
+        minZ = SIMD::min(minZ, _mm_shuffle_epi32(minZ, _MM_SHUFFLE(2, 3, 0, 1)));
+        maxZ = SIMD::max(maxZ, _mm_shuffle_epi32(maxZ, _MM_SHUFFLE(1, 0, 3, 2)));
+        maxZ = SIMD::max(maxZ, _mm_shuffle_epi32(maxZ, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        auto &bounds = drawBuffer.getDepthBounds(blockX, blockY);
+        bounds.min = _mm_cvtsi128_si32(minZ);
+        bounds.max = _mm_cvtsi128_si32(maxZ);
+
+        auto &tileBounds = drawBuffer.getTileDepthBounds();
+        tileBounds.min = SIMD::min(tileBounds.min, bounds.min);
+        tileBounds.max = SIMD::max(tileBounds.max, bounds.max);
+    }
+
+    //
+    // Unswizzle kernel, which writes the quads of a color buffer into the rows of a
+    // linear image
+    //
+    static void unswizzleColor(DrawBuffer &drawBuffer, unsigned int *dst, int dstWidth) {
+
+        auto src = drawBuffer.getColor();
+        int width = drawBuffer.getWidth();
+        int height = drawBuffer.getHeight();
+
+        // Calculate offsets
+        auto dstRow1 = dst + drawBuffer.getMinX() + (drawBuffer.getMinY() * dstWidth);
+        auto dstRow2 = dstRow1 + dstWidth;
+
+        // Unswizzle the data. Two 2x2 quads make up four pixels of two rows.
+        for (int y = 0; y < height; y += 2) {
+
+            int x = 0;
+
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2
+            // Four quads at once, the unpacking works within 128 bit lanes, so the
+            // halves of the rows end up in the order (quad 1, quad 3, quad 2, quad 4)
+            for (; x + 8 <= width; x += 8, src += 16) {
+
+                OInt quads12 = _mm256_loadu_si256(reinterpret_cast<const OInt *>(src));
+                OInt quads34 = _mm256_loadu_si256(reinterpret_cast<const OInt *>(src + 8));
+
+                OInt row1 = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(quads12, quads34), _MM_SHUFFLE(3, 1, 2, 0));
+                OInt row2 = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(quads12, quads34), _MM_SHUFFLE(3, 1, 2, 0));
+
+                _mm256_storeu_si256(reinterpret_cast<OInt *>(dstRow1 + x), row1);
+                _mm256_storeu_si256(reinterpret_cast<OInt *>(dstRow2 + x), row2);
+            }
+        #endif
+
+            for (; x + 4 <= width; x += 4, src += 8) {
+
+                QInt quad1 = _mm_load_si128(reinterpret_cast<const QInt *>(src));
+                QInt quad2 = _mm_load_si128(reinterpret_cast<const QInt *>(src + 4));
+
+                _mm_storeu_si128(reinterpret_cast<QInt *>(dstRow1 + x), _mm_unpacklo_epi64(quad1, quad2));
+                _mm_storeu_si128(reinterpret_cast<QInt *>(dstRow2 + x), _mm_unpackhi_epi64(quad1, quad2));
+            }
+
+            // The row ends with a single quad
+            if (x < width) {
+
+                QInt quad = _mm_load_si128(reinterpret_cast<const QInt *>(src));
+
+                _mm_storel_epi64(reinterpret_cast<QInt *>(dstRow1 + x), quad);
+                _mm_storel_epi64(reinterpret_cast<QInt *>(dstRow2 + x), _mm_unpackhi_epi64(quad, quad));
+                src += 4;
+            }
+
+            dstRow1 += dstWidth << 1;
+            dstRow2 += dstWidth << 1;
+        }
+    }
+}
+}
@@ -0,0 +1,290 @@
+﻿#include <cstring>
+#include "Context.h"
+#include "Statistics.h"
+#include "Configuration.h"
+#include "DrawStateCache.h"
+
+namespace SWGL {
+
+    DrawStateCache::DrawStateCache()
+
+        : m_currentEntry(nullptr),
+          m_isDirty(true),
+          m_frame(0) {
+
+    }
+
+
+
+    DrawStateBlock *DrawStateCache::getStateBlock(Context &context) {
+
+        if (m_isDirty || m_currentEntry == nullptr) {
+
+            buildStateBlock(context);
+            buildKey();
+
+            auto it = m_entries.find(m_newKey);
+            if (it == m_entries.end()) {
+
+                // The kernel only depends on the raster operations of the block, so it
+                // is picked once when the block is built
+                auto &kernels = Kernels::get();
+                m_newStateBlock.drawTriangles = kernels.selectDrawTriangles(m_newStateBlock.rasterOps);
+                m_newStateBlock.isRasterOpsSpecialized = m_newStateBlock.drawTriangles != kernels.drawTriangles;
+                m_newStateBlock.isVisibilityPass = false;
+
+                // Opaque triangles which write all color channels can be shaded after
+                // the visibility pass
+                if (Configuration::getInstance().isVisibilityBufferEnabled() && m_newStateBlock.colorMask.getMask() == -1) {
+
+                    auto drawVisibility = kernels.selectDrawVisibility(m_newStateBlock.rasterOps);
+                    if (drawVisibility != nullptr) {
+
+                        m_newStateBlock.drawTriangles = drawVisibility;
+                        m_newStateBlock.isVisibilityPass = true;
+                    }
+                }
+
+                for (auto &texState : m_newStateBlock.textures) {
+
+                    if (texState.texData != nullptr) {
+
+                        texState.texEnvKernel = kernels.selectTexEnv(texState.texEnv, texState.format);
+                        texState.texEnvKernel8 = kernels.selectTexEnv8(texState.texEnv, texState.format);
+
+                        if (texState.texEnvKernel8 == nullptr) {
+
+                            m_newStateBlock.isPairShadingSupported = false;
+                        }
+                    }
+                }
+
+                it = m_entries.emplace(m_newKey, Entry{ m_newStateBlock, m_frame }).first;
+                STATISTICS_ADD(DRAW_STATE_BLOCKS, 1);
+            }
+
+            m_currentEntry = &it->second;
+            m_isDirty = false;
+
+            // The textures are only kept alive by the cached blocks
+            for (auto &texState : m_newStateBlock.textures) {
+
+                texState.texData = nullptr;
+            }
+        }
+
+        m_currentEntry->lastUsedFrame = m_frame;
+        return &m_currentEntry->stateBlock;
+    }
+
+    void DrawStateCache::endFrame() {
+
+        m_frame++;
+
+        // The draw calls of a frame are done once the frame has left the frames in
+        // flight, so nothing refers to the blocks of older frames anymore
+        for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+
+            if (m_frame - it->second.lastUsedFrame > SWGL_MAX_FRAMES_IN_FLIGHT) {
+
+                if (&it->second == m_currentEntry) {
+
+                    m_currentEntry = nullptr;
+                }
+
+                it = m_entries.erase(it);
+            }
+            else {
+
+                ++it;
+            }
+        }
+    }
+
+    void DrawStateCache::clear() {
+
+        m_entries.clear();
+        m_currentEntry = nullptr;
+        m_isDirty = true;
+    }
+
+
+
+    void DrawStateCache::buildStateBlock(Context &context) {
+
+        auto &texManager = context.getTextureManager();
+        auto &stateBlock = m_newStateBlock;
+
+        stateBlock.scissor = context.getScissor();
+        stateBlock.polygonOffset = context.getPolygonOffset();
+        stateBlock.depthTesting = context.getDepthTesting();
+        stateBlock.alphaTesting = context.getAlphaTesting();
+        stateBlock.blending = context.getBlending();
+        stateBlock.colorMask = context.getColorMask();
+
+        stateBlock.polygonOffsetFactor = stateBlock.polygonOffset.getFactor();
+        stateBlock.polygonOffsetRTimesUnits = stateBlock.polygonOffset.getRTimesUnits();
+        stateBlock.alphaReference = stateBlock.alphaTesting.getReferenceValue();
+
+        // Disabled raster operations are mapped to a single value each, so the states
+        // that only differ in settings without an effect share a kernel
+        auto &depthTesting = context.getDepthTesting();
+        auto &alphaTesting = context.getAlphaTesting();
+        auto &blending = context.getBlending();
+        auto &rasterOps = stateBlock.rasterOps;
+
+        if (depthTesting.isTestEnabled()) {
+
+            rasterOps.depthFunc = depthTesting.getTestFunction();
+            rasterOps.depthWrite = depthTesting.isWriteEnabled() ? GL_TRUE : GL_FALSE;
+        }
+        else {
+
+            rasterOps.depthFunc = GL_NONE;
+            rasterOps.depthWrite = GL_FALSE;
+        }
+
+        rasterOps.alphaFunc = alphaTesting.isEnabled() ? alphaTesting.getTestFunction() : GL_NONE;
+        rasterOps.blendSrc = blending.isEnabled() ? blending.getSourceFactor() : GL_ONE;
+        rasterOps.blendDst = blending.isEnabled() ? blending.getDestinationFactor() : GL_ZERO;
+        stateBlock.isPairShadingSupported = true;
+
+        for (auto i = 0U; i < SWGL_MAX_TEXTURE_UNITS; i++) {
+
+            auto &unit = texManager.getTextureUnit(i);
+            auto &texState = stateBlock.textures[i];
+
+            if (unit.currentTarget != nullptr) {
+
+                auto &texObj = unit.currentTarget->texObj;
+
+                // TODO: Implement a flag for texture completeness (texObj->isComplete or
+                //       something like that)
+                if (texObj != nullptr &&
+                    texObj->data != nullptr &&
+                    texObj->data->maxLOD > -1) {
+
+                    texState.texEnv = unit.texEnv;
+                    texState.target = texObj->target;
+                    texState.format = texObj->data->format;
+                    texState.texData = texObj->data;
+                    texState.texParams = texObj->parameter;
+
+                    if (texObj->target != GL_TEXTURE_2D) {
+
+                        stateBlock.isPairShadingSupported = false;
+                    }
+                    continue;
+                }
+            }
+
+            // Units without a texture always look the same, so they don't split
+            // otherwise equal states
+            texState = DrawStateBlock::TextureState();
+        }
+    }
+
+    void DrawStateCache::buildKey() {
+
+        auto &stateBlock = m_newStateBlock;
+
+        m_newKey.clear();
+
+        appendKey(stateBlock.scissor.isEnabled());
+        appendKey(stateBlock.scissor.getMinX());
+        appendKey(stateBlock.scissor.getMinY());
+        appendKey(stateBlock.scissor.getMaxX());
+        appendKey(stateBlock.scissor.getMaxY());
+
+        appendKey(stateBlock.polygonOffset.isFillEnabled());
+        appendKey(stateBlock.polygonOffset.getFactor());
+        appendKey(stateBlock.polygonOffset.getUnits());
+
+        appendKey(stateBlock.depthTesting.isTestEnabled());
+        appendKey(stateBlock.depthTesting.isWriteEnabled());
+        appendKey(stateBlock.depthTesting.getTestFunction());
+
+        appendKey(stateBlock.alphaTesting.isEnabled());
+        appendKey(stateBlock.alphaTesting.getTestFunction());
+        appendKey(stateBlock.alphaTesting.getReferenceValue());
+
+        appendKey(stateBlock.blending.isEnabled());
+        appendKey(stateBlock.blending.getSourceFactor());
+        appendKey(stateBlock.blending.getDestinationFactor());
+
+        appendKey(stateBlock.colorMask.getMask());
+
+        // New members of TextureEnvironment and TextureParameter have to be added
+        // here as well, otherwise different states end up in the same block
+        for (auto &texState : stateBlock.textures) {
+
+            appendKey(texState.texData.get());
+            if (texState.texData == nullptr) {
+
+                continue;
+            }
+
+            // The format is changed in place by glTexImage(), so the pointer alone
+            // doesn't tell which texture function the block needs
+            appendKey(texState.format);
+
+            auto &texEnv = texState.texEnv;
+
+            appendKey(texEnv.mode);
+            appendKey(texEnv.combineModeAlpha);
+            appendKey(texEnv.combineModeRGB);
+
+            for (int i = 0; i < 3; i++) {
+
+                appendKey(texEnv.sourceAlpha[i]);
+                appendKey(texEnv.sourceRGB[i]);
+                appendKey(texEnv.operandAlpha[i]);
+                appendKey(texEnv.operandRGB[i]);
+            }
+
+            appendKey(texEnv.numArgsAlpha);
+            appendKey(texEnv.numArgsRGB);
+            appendKey(texEnv.colorConstA);
+            appendKey(texEnv.colorConstR);
+            appendKey(texEnv.colorConstG);
+            appendKey(texEnv.colorConstB);
+            appendKey(texEnv.colorScaleA);
+            appendKey(texEnv.colorScaleRGB);
+
+            auto &texParams = texState.texParams;
+
+            appendKey(texParams.isUsingMipMapping);
+            appendKey(texParams.isUsingTrilinearFilter);
+            appendKey(texParams.minifySampler);
+            appendKey(texParams.magnifySampler);
+            appendKey(texParams.wrappingModeS);
+            appendKey(texParams.wrappingModeT);
+            appendKey(texParams.minifyFilter);
+            appendKey(texParams.magnifyFilter);
+        }
+    }
+
+    template<typename T>
+    void DrawStateCache::appendKey(T value) {
+
+        unsigned int words[(sizeof(T) + 3) / 4] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        m_newKey.insert(m_newKey.end(), std::begin(words), std::end(words));
+    }
+
+
+
+    size_t DrawStateCache::KeyHash::operator()(const Key &key) const {
+
+        // FNV-1a
+        unsigned int hash = 2166136261U;
+
+        for (auto word : key) {
+
+            hash = (hash ^ word) * 16777619U;
+        }
+
+        return hash;
+    }
+}
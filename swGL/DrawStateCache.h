@@ -0,0 +1,140 @@
+﻿#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "Defines.h"
+#include "ContextTypes.h"
+#include "TextureManager.h"
+#include "Kernels.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    class Context;
+
+    //
+    // The raster operations of a state block in the form the draw triangle kernels are
+    // specialized on (see CommandDrawTriangle.inl). A disabled test is GL_NONE, depth
+    // writes are GL_TRUE or GL_FALSE and disabled blending is GL_ONE, GL_ZERO.
+    //
+    struct RasterOps {
+
+        GLenum depthFunc;
+        GLenum depthWrite;
+        GLenum alphaFunc;
+        GLenum blendSrc;
+        GLenum blendDst;
+
+        bool operator==(const RasterOps &other) const {
+
+            return depthFunc == other.depthFunc &&
+                   depthWrite == other.depthWrite &&
+                   alphaFunc == other.alphaFunc &&
+                   blendSrc == other.blendSrc &&
+                   blendDst == other.blendDst;
+        }
+    };
+
+    //
+    // The part of the context state which is needed to rasterize and shade triangles.
+    // A state block never changes once it has been built, so the draw calls can
+    // simply refer to it.
+    //
+    struct DrawStateBlock {
+
+        Scissor scissor;
+        PolygonOffset polygonOffset;
+        DepthTesting depthTesting;
+        AlphaTesting alphaTesting;
+        Blending blending;
+        ColorMask colorMask;
+        RasterOps rasterOps = {};
+
+        // Plain copies of the float values the kernels read, as they must not call the
+        // inline getters of the state classes (see Kernels.inl)
+        float polygonOffsetFactor = 0.0f;
+        float polygonOffsetRTimesUnits = 0.0f;
+        float alphaReference = 0.0f;
+
+        // The draw triangle kernel for the raster operations, which is either one of
+        // the specialized kernels or the generic one
+        DrawTrianglesKernel drawTriangles = nullptr;
+        bool isRasterOpsSpecialized = false;
+
+        // Whether the kernel is the visibility pass, which defers the shading until the
+        // tile needs its colors (see VisibilityBuffer.inl)
+        bool isVisibilityPass = false;
+
+        // Whether the AVX2 kernels may shade the triangles two quads at a time, which
+        // only supports 2D textures with a texture function for pairs of quads
+        bool isPairShadingSupported = false;
+
+        struct TextureState {
+
+            GLenum target = GL_NONE;
+            TextureBaseFormat format = TextureBaseFormat::RGBA;
+            TextureDataPtr texData;
+            TextureParameter texParams;
+            TextureEnvironment texEnv;
+
+            // The texture function for the environment and the format, for single quads
+            // and for pairs of quads
+            TexEnvKernel texEnvKernel = nullptr;
+            TexEnvKernel8 texEnvKernel8 = nullptr;
+
+        } textures[SWGL_MAX_TEXTURE_UNITS];
+    };
+
+    //
+    // Builds the state blocks of the draw calls. A new block is only looked up when
+    // the context state has changed since the last draw call (see invalidate()). Equal
+    // states share the same block, so switching back and forth between a few states
+    // doesn't build new blocks either. Blocks which haven't been used for a while are
+    // freed at the end of a frame.
+    //
+    class DrawStateCache {
+
+    public:
+        DrawStateCache();
+        ~DrawStateCache() = default;
+
+    public:
+        void invalidate() { m_isDirty = true; }
+
+        DrawStateBlock *getStateBlock(Context &context);
+        int getNumStateBlocks() const { return static_cast<int>(m_entries.size()); }
+
+        void endFrame();
+        void clear();
+
+    private:
+        using Key = std::vector<unsigned int>;
+
+        struct KeyHash {
+
+            size_t operator()(const Key &key) const;
+        };
+
+        struct Entry {
+
+            DrawStateBlock stateBlock;
+            unsigned int lastUsedFrame;
+        };
+
+        void buildStateBlock(Context &context);
+        void buildKey();
+
+        template<typename T>
+        void appendKey(T value);
+
+    private:
+        std::unordered_map<Key, Entry, KeyHash> m_entries;
+        Entry *m_currentEntry;
+        bool m_isDirty;
+        unsigned int m_frame;
+
+    private:
+        DrawStateBlock m_newStateBlock;
+        Key m_newKey;
+    };
+}
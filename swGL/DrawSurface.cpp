@@ -1,6 +1,9 @@
 ﻿#include <memory>
 #include <algorithm>
+#include <numeric>
+#include <mutex>
 #include "Defines.h"
+#include "Configuration.h"
 #include "DrawSurface.h"
 
 namespace SWGL {
@@ -12,25 +15,15 @@ namespace SWGL {
     DrawSurface::DrawSurface()
 
         : m_width(0),
-          m_height(0) {
+          m_height(0),
+          m_numTilesInX(0),
+          m_numTilesInY(0) {
 
-        // Calculate how often the drawing buffer can be subdivided with respect
-        // to the number of drawing threads
-        int numSubDivX = 1, numSubDivY = 1;
-        for (int n = SWGL_NUM_DRAW_THREADS; n > 1; ) {
+        auto &config = Configuration::getInstance();
 
-            numSubDivX++; n >>= 1;
-            if (n == 1) break;
-            numSubDivY++; n >>= 1;
-        }
-        m_numBuffersInX = 1 << (numSubDivX - 1);
-        m_numBuffersInY = 1 << (numSubDivY - 1);
-
-        // Initialize drawing buffer
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
-
-            m_buffer[i] = std::make_shared<DrawBuffer>();
-        }
+        m_numDrawThreads = static_cast<int>(config.getNumDrawThreads());
+        m_tileSize = static_cast<int>(config.getTileSize());
+        m_frameImages.resize(config.getNumFramesInFlight());
     }
 
 
@@ -43,6 +36,15 @@ namespace SWGL {
         updateDimensions();
     }
 
+    bool DrawSurface::isResizeNeeded() {
+
+        RECT r;
+        GetClientRect(m_hWnd, &r);
+
+        return static_cast<int>(r.right - r.left) != m_width ||
+               static_cast<int>(r.bottom - r.top) != m_height;
+    }
+
     void DrawSurface::updateDimensions() {
 
         // Try to figure out the actual window size
@@ -53,77 +55,84 @@ namespace SWGL {
         int height = static_cast<int>(r.bottom - r.top);
 
         // Resize the drawing surface if needed
-        if (width != m_width || height != m_height) {
-
-            m_width = width;
-            m_height = height;
-
-            // Make sure that the surface can be evenly divided between the buffers
-            // This works if width and height (because DrawBuffer::unswizzle relies on it)
-            // and the quotient of width/height and m_numBuffersInX/m_numBuffersInY
-            // are a multiple of two (because CommandDrawTriangle::execute and maybe
-            // some other methods i can't remember rely on it).
-            width = std::max((width + 1) & ~1, m_numBuffersInX * 2);
-            while (((width / m_numBuffersInX) & 1) != 0) { width += 2; }
-            height = std::max((height + 1) & ~1, m_numBuffersInY * 2);
-            while (((height / m_numBuffersInY) & 1) != 0) { height += 2; }
-
-            // Init storage in which the unswizzled color buffer gets written into
-            m_unswizzledColor.resize(width * height);
-
-            // Setup bitmap info structure which is needed for SetDIBitsToDevice()
-            memset(&m_bmi, 0, sizeof(BITMAPINFO));
-            m_bmi.bmiHeader.biSize = sizeof(BITMAPINFO);
-            m_bmi.bmiHeader.biWidth = width;
-            m_bmi.bmiHeader.biHeight = height;
-            m_bmi.bmiHeader.biPlanes = 1;
-            m_bmi.bmiHeader.biBitCount = 32;
-            m_bmi.bmiHeader.biCompression = BI_RGB;
-
-            // Initialize the buffer for each drawing thread
-            m_bufferWidth = width / m_numBuffersInX;
-            m_bufferHeight = height / m_numBuffersInY;
-
-            for (int y = 0, idx = 0; y < m_numBuffersInY; y++) {
-
-                for (int x = 0; x < m_numBuffersInX; x++) {
-
-                    auto minX = x * m_bufferWidth;
-                    auto minY = y * m_bufferHeight;
-                    auto maxX = x < m_numBuffersInX ? minX + m_bufferWidth : width;
-                    auto maxY = y < m_numBuffersInY ? minY + m_bufferHeight : height;
-
-                    m_buffer[idx]->resize(minX, minY, maxX, maxY);
-                    m_buffer[idx]->clearColor(0, minX, minY, maxX, maxY);
-                    m_buffer[idx]->clearDepth(0, minX, minY, maxX, maxY);
-
-                    idx++;
-                }
-            }
+        if (width == m_width && height == m_height) {
+
+            return;
         }
-    }
 
+        m_width = width;
+        m_height = height;
 
+        // Make sure that the width and height of every tile is a multiple of two
+        // (because DrawBuffer::unswizzle, CommandDrawTriangle::execute and maybe
+        // some other methods i can't remember rely on it). As the tile size is
+        // even, only the surface itself has to be padded.
+        width = std::max((width + 1) & ~1, 2);
+        height = std::max((height + 1) & ~1, 2);
 
-    void DrawSurface::swap() {
+        // Init storage in which the unswizzled color buffers get written into
+        for (auto &image : m_frameImages) {
 
-        // Unswizzle color buffer
-        auto width = m_bmi.bmiHeader.biWidth;
-        auto height = m_bmi.bmiHeader.biHeight;
-        auto dst = m_unswizzledColor.data();
+            image.resize(width * height);
+        }
+
+        // Setup bitmap info structure which is needed for SetDIBitsToDevice()
+        memset(&m_bmi, 0, sizeof(BITMAPINFO));
+        m_bmi.bmiHeader.biSize = sizeof(BITMAPINFO);
+        m_bmi.bmiHeader.biWidth = width;
+        m_bmi.bmiHeader.biHeight = height;
+        m_bmi.bmiHeader.biPlanes = 1;
+        m_bmi.bmiHeader.biBitCount = 32;
+        m_bmi.bmiHeader.biCompression = BI_RGB;
+
+        // Split the surface into tiles. The tiles in the last row / column may
+        // be smaller than the others. The tiles are handed out to the drawing threads
+        // in a staggered pattern, which makes sure that neighbouring tiles (which most
+        // likely have a similar workload) are processed by different threads. Every
+        // row is shifted by a step that is coprime to the number of threads, so the
+        // tiles above each other differ as well, whatever the width of the surface.
+        std::unique_lock<std::shared_mutex> lock(m_tileLock);
+
+        auto rowStep = std::max(m_numDrawThreads / 2, 1);
+        while (std::gcd(rowStep, m_numDrawThreads) != 1) {
+
+            rowStep--;
+        }
+
+        m_numTilesInX = (width + m_tileSize - 1) / m_tileSize;
+        m_numTilesInY = (height + m_tileSize - 1) / m_tileSize;
+
+        m_tiles.clear();
+        m_tiles.reserve(m_numTilesInX * m_numTilesInY);
+
+        for (int y = 0; y < m_numTilesInY; y++) {
+
+            for (int x = 0; x < m_numTilesInX; x++) {
 
-        for (auto &buffer : m_buffer) {
+                auto minX = x * m_tileSize;
+                auto minY = y * m_tileSize;
+                auto maxX = std::min(minX + m_tileSize, width);
+                auto maxY = std::min(minY + m_tileSize, height);
 
-            buffer->unswizzleColor(dst, width);
+                // The buffers of the tile are set up later by its home thread
+                m_tiles.emplace_back(std::make_unique<Tile>(
+
+                    (x + y * rowStep) % m_numDrawThreads,
+                    minX, minY, maxX, maxY
+                ));
+            }
         }
+    }
 
-#if !SWGL_USE_HARDWARE_GAMMA
-        // Software emulated gamma correction
-        m_gammaRamp.correct(
 
-            m_unswizzledColor.data(), m_unswizzledColor.size()
-        );
-#endif
+
+    void DrawSurface::present(int frameIdx) {
+
+        // The frame image has already been unswizzled (and gamma corrected) by
+        // the drawing threads
+        auto width = m_bmi.bmiHeader.biWidth;
+        auto height = m_bmi.bmiHeader.biHeight;
+        auto dst = m_frameImages[frameIdx].data();
 
         // Blit pixels to device
         SetDIBitsToDevice(
@@ -137,8 +146,5 @@ namespace SWGL {
             &m_bmi,
             DIB_RGB_COLORS
         );
-
-        // Update hdc dimensions
-        updateDimensions();
     }
 }
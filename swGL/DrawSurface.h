@@ -1,8 +1,10 @@
 ﻿#pragma once
 
 #include <Windows.h>
-#include <array>
+#include <vector>
+#include <shared_mutex>
 #include "DrawBuffer.h"
+#include "Tile.h"
 #if !SWGL_USE_HARDWARE_GAMMA
 #include "GammaRamp.h"
 #endif
@@ -10,7 +12,7 @@
 namespace SWGL {
 
     //
-    // A drawing surface, composed of several DrawBuffer's
+    // A drawing surface, composed of several tiles
     //
     class DrawSurface {
 
@@ -25,17 +27,25 @@ namespace SWGL {
         int getHeight() const { return m_height; }
 
     public:
-        DrawBufferPtr getBuffer(int threadIdx) { return m_buffer[threadIdx]; }
-        int getBufferWidth() { return m_bufferWidth; }
-        int getBufferHeight() { return m_bufferHeight; }
-        int getNumBuffersInX() { return m_numBuffersInX; }
-        int getNumBuffersInY() { return m_numBuffersInY; }
+        Tile &getTile(int tileIdx) { return *m_tiles[tileIdx]; }
+        int getNumTiles() { return static_cast<int>(m_tiles.size()); }
+        int getTileSize() { return m_tileSize; }
+        int getNumTilesInX() { return m_numTilesInX; }
+        int getNumTilesInY() { return m_numTilesInY; }
+
+        // The drawing threads hold this lock (shared) while they work on the tiles,
+        // so the tiles can't be recreated underneath them
+        std::shared_mutex &getTileLock() { return m_tileLock; }
 
     public:
-        void swap();
+        bool isResizeNeeded();
+        void updateDimensions();
 
-	private:
-		void updateDimensions();
+        // The tiles unswizzle their color buffer into one of the frame images, which
+        // then gets presented. There is one image per frame in flight.
+        unsigned int *getFrameImage(int frameIdx) { return m_frameImages[frameIdx].data(); }
+        int getFrameImageWidth() const { return m_bmi.bmiHeader.biWidth; }
+        void present(int frameIdx);
 
     #if !SWGL_USE_HARDWARE_GAMMA
     public:
@@ -56,13 +66,14 @@ namespace SWGL {
         int m_height;
 
     private:
-        ColorBuffer m_unswizzledColor;
+        std::vector<ColorBuffer> m_frameImages;
 
     private:
-        int m_numBuffersInX;
-        int m_numBuffersInY;
-        int m_bufferWidth;
-        int m_bufferHeight;
-        std::array<DrawBufferPtr, SWGL_NUM_DRAW_THREADS> m_buffer;
+        int m_numDrawThreads;
+        int m_numTilesInX;
+        int m_numTilesInY;
+        int m_tileSize;
+        std::vector<TilePtr> m_tiles;
+        std::shared_mutex m_tileLock;
     };
 }
@@ -1,12 +1,28 @@
 ﻿#include <stdexcept>
+#include <algorithm>
+#include <shared_mutex>
+#include <chrono>
 #include "Log.h"
+#include "SIMD.h"
+#include "Configuration.h"
+#include "Statistics.h"
+#include "ThreadAffinity.h"
+#include "DrawThreadPool.h"
 #include "DrawThread.h"
 
 namespace SWGL {
 
-    DrawThread::DrawThread(DrawBufferPtr drawBuffer)
+    DrawThread::DrawThread(int index, DrawThreadPool &pool)
 
-        : m_drawBuffer(drawBuffer) {
+        : m_isWorkAvailable(false),
+          m_isStopRequested(false),
+          m_isSleeping(false),
+          m_isBusy(false),
+          m_wakeUpTime(0),
+          m_spinTime(Configuration::getInstance().getSpinTime()),
+          m_index(index),
+          m_pool(pool),
+          m_tile(nullptr) {
 
     }
 
@@ -14,12 +30,21 @@ namespace SWGL {
 
     void DrawThread::start() {
 
-        m_workloadEstimate = 0;
-        m_isWorkAvailable = false;
+        m_isWorkAvailable.store(false, std::memory_order_relaxed);
+        m_isStopRequested.store(false, std::memory_order_relaxed);
 
         m_thread = std::thread(&DrawThread::run, this);
     }
 
+    void DrawThread::stop() {
+
+        {
+            std::lock_guard<std::mutex> cs(m_mutex);
+            m_isStopRequested.store(true);
+        }
+        m_workAvailable.notify_one();
+    }
+
     void DrawThread::join() {
 
         try {
@@ -37,70 +62,243 @@ namespace SWGL {
 
 
 
-    void DrawThread::addCommand(CommandPtr command) {
+    void DrawThread::wakeUp() {
+
+        // The thread hasn't picked up the last wake up yet. The pushed command has to
+        // be visible before the flag is checked, otherwise the thread could clear the
+        // flag and miss the command while this wake up is skipped.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_isWorkAvailable.load(std::memory_order_relaxed)) {
+
+            return;
+        }
+
+        // Only a sleeping thread has to be notified, a spinning one picks up the
+        // flag by itself. The flag is set before the thread state is checked, while
+        // the thread does it the other way around, so the wake up can't get lost.
+        m_isWorkAvailable.store(true);
+
+        if (m_isSleeping.load()) {
 
-        auto isFlushingQueue = command->isFlushingQueue();
-        auto workloadEstimate = command->getWorkLoadEstimate();
+#if SWGL_ENABLE_STATISTICS
+            m_wakeUpTime.store(
 
-        // This is used to not overburden or starve the threads with too many / too few triangles.
-        // If it goes beyond a certain threshold the drawing process is forced to start. It's only
-        // a hack until something more sophisticated will replace this - but it isn't "bad" as it
-        // increases the FPS by a significant amount.
-        m_workloadEstimate += workloadEstimate;
+                std::chrono::steady_clock::now().time_since_epoch().count(),
+                std::memory_order_relaxed
+            );
+#endif
+
+            std::lock_guard<std::mutex> cs(m_mutex);
+            m_workAvailable.notify_one();
+        }
+    }
+
+
+
+    void DrawThread::run() {
+
+        ThreadAffinity::getInstance().pinCurrentThread(m_index);
 
         for (;;) {
-        
-            bool couldPush = m_commandQueue.push(command);
 
-            // Tell the draw thread that there is work to do
-            if (!couldPush || m_workloadEstimate >= 32 || isFlushingQueue) {
+            if (!waitForWork()) {
+
+                return;
+            }
+
+            // Execute the commands until there is nothing left to do
+            m_isBusy.store(true, std::memory_order_relaxed);
+            while (processClients()) { }
+            m_isBusy.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    bool DrawThread::waitForWork() {
 
-                {
-                    std::lock_guard<std::mutex> cs(m_mutex);
-                    m_isWorkAvailable = true;
-                }
-                m_workAvailable.notify_one();
+        if (spinForWork()) {
 
-                if (!couldPush) { continue; }
+            return true;
+        }
+
+        std::unique_lock<std::mutex> cs(m_mutex);
+
+        m_isSleeping.store(true);
+        m_workAvailable.wait(cs, [this] {
+
+            return m_isWorkAvailable.load() || m_isStopRequested.load();
+        });
+        m_isSleeping.store(false, std::memory_order_relaxed);
+
+        if (m_isStopRequested.load(std::memory_order_relaxed)) {
+
+            return false;
+        }
+
+        // The flag has to be cleared before the queues are looked at (see wakeUp())
+        m_isWorkAvailable.exchange(false);
+
+#if SWGL_ENABLE_STATISTICS
+        auto wakeUpTime = std::chrono::steady_clock::duration(m_wakeUpTime.load(std::memory_order_relaxed));
+        auto latency = std::chrono::steady_clock::now().time_since_epoch() - wakeUpTime;
+
+        STATISTICS_ADD(WAKE_UPS, 1);
+        STATISTICS_ADD(WAKE_UP_LATENCY_NS, std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+#endif
+
+        return true;
+    }
+
+    bool DrawThread::spinForWork() {
+
+        auto endTime = std::chrono::steady_clock::now() + m_spinTime;
+
+        for (int i = 1; ; i++) {
+
+            if (m_isWorkAvailable.load(std::memory_order_relaxed) &&
+                m_isWorkAvailable.exchange(false)) {
+
+                return true;
             }
 
-            if (couldPush) {
+            if (m_isStopRequested.load(std::memory_order_relaxed)) {
 
-                if (m_workloadEstimate >= 32) {
-                
-                    m_workloadEstimate = 0;
-                }
-                break;
+                return false;
+            }
+
+            _mm_pause();
+
+            // Reading the clock isn't free, so it's only done every now and then
+            if ((i & 63) == 0 && std::chrono::steady_clock::now() >= endTime) {
+
+                return false;
             }
         }
     }
 
+    bool DrawThread::processClients() {
 
+        auto clients = m_pool.getClients();
 
-    void DrawThread::run() {
+        // Serve the client which got the smallest share of the threads so far first.
+        // The virtual times are read once, as the other threads keep changing them.
+        m_clientOrder.clear();
+        for (auto &client : *clients) {
+
+            m_clientOrder.emplace_back(m_pool.getVirtualTime(*client), client.get());
+        }
 
-        std::unique_lock<std::mutex> cs(m_mutex, std::defer_lock);
+        std::sort(m_clientOrder.begin(), m_clientOrder.end());
 
-        CommandPtr cmd;
-        for (;;) {
+        for (auto &entry : m_clientOrder) {
+
+            auto &client = *entry.second;
+
+            // The lock makes sure that the tiles aren't recreated underneath the
+            // thread, and that the surface isn't gone (see DrawThreadPool::detach)
+            std::shared_lock<std::shared_mutex> lock(client.drawSurface.getTileLock());
+            if (!client.isDetached && processTiles(client)) {
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool DrawThread::processTiles(DrawClient &client) {
+
+        auto &drawSurface = client.drawSurface;
+
+        bool didWork = false;
+        int numTiles = drawSurface.getNumTiles();
+
+        // Work on the own tiles first
+        for (int i = 0; i < numTiles; i++) {
+
+            auto &tile = drawSurface.getTile(i);
+            if (tile.getHomeThread() == m_index) {
+
+                didWork |= executeTile(client, tile);
+            }
+        }
+
+        if (didWork) {
+
+            return true;
+        }
+
+        // Steal a pending tile from one of the other threads. Every thread starts
+        // searching at a different position so the thieves don't fight over the
+        // same tiles.
+        for (int n = 0; n < numTiles; n++) {
+
+            auto &tile = drawSurface.getTile((m_index + n) % numTiles);
+            if (executeTile(client, tile)) {
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool DrawThread::executeTile(DrawClient &client, Tile &tile) {
 
-            // Wait for work
-            cs.lock();
-            m_workAvailable.wait(cs, [this] {
+        if (!tile.hasCommands() || !tile.tryLock()) {
 
-                return m_isWorkAvailable;
-            });
-            m_isWorkAvailable = false;
-            cs.unlock();
+            return false;
+        }
 
-            // Execute the commands
-            while (m_commandQueue.pop(cmd)) {
+        // Only the home thread may set up the buffers of a new tile
+        if (!tile.isInitialized()) {
 
-                if (!cmd->execute(this)) {
+            if (tile.getHomeThread() != m_index) {
 
-                    return;
-                }
+                tile.unlock();
+                return false;
             }
+
+            tile.initialize();
         }
+
+        // Execute the commands of the tile in order
+        m_tile = &tile;
+
+        Command cmd;
+        bool didWork = false;
+        long long measuredUnits = 0;
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        while (tile.pop(cmd)) {
+
+            measuredUnits += cmd.getWorkLoadEstimate();
+
+            // Everything besides the visibility pass needs the shaded colors
+            if (!cmd.isVisibilityPass()) {
+
+                tile.getDrawBuffer().resolveVisibility();
+            }
+
+            cmd.execute(this);
+            didWork = true;
+        }
+
+        auto executionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+
+            std::chrono::steady_clock::now() - startTime
+        ).count();
+
+        tile.addExecutionTime(executionTime);
+        m_pool.addExecutionTime(client, executionTime);
+
+        // Feed the execution times back so the renderer learns how long the
+        // commands actually take
+        client.measuredUnits.fetch_add(measuredUnits, std::memory_order_relaxed);
+        client.measuredTime.fetch_add(executionTime, std::memory_order_relaxed);
+
+        tile.unlock();
+
+        return didWork;
     }
 }
@@ -4,48 +4,72 @@
 #include <thread>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <utility>
 #include "Defines.h"
 #include "DrawBuffer.h"
-#include "CommandBase.h"
-#include "LockFreeQueue.h"
+#include "Tile.h"
 
 namespace SWGL {
-    
+
     // Forward declarations
     class DrawThread;
+    class DrawThreadPool;
+    struct DrawClient;
 
     // Type aliases
     using DrawThreadPtr = std::unique_ptr<DrawThread>;
 
     //
-    // Implements the drawing thread which executes commands from the renderer
+    // Implements the drawing thread which executes the commands of the tiles. The
+    // drawing surfaces of all contexts are served in the order of their virtual time
+    // (see DrawThreadPool). Within a surface, a drawing thread first works on the
+    // tiles it is the home thread of, and steals pending tiles from the other threads
+    // once it runs out of work. An idle thread spins for a short while before it goes
+    // to sleep, as new work often arrives right after a thread ran out of it.
     //
     class DrawThread {
 
     public:
-        DrawThread(DrawBufferPtr drawBuffer);
+        DrawThread(int index, DrawThreadPool &pool);
         ~DrawThread() = default;
 
     public:
         void start();
+        void stop();
         void join();
 
     private:
         void run();
+        bool waitForWork();
+        bool spinForWork();
+        bool processClients();
+        bool processTiles(DrawClient &client);
+        bool executeTile(DrawClient &client, Tile &tile);
 
     public:
-        void addCommand(CommandPtr command);
-        DrawBuffer &getDrawBuffer() { return *m_drawBuffer; }
+        void wakeUp();
+        bool isBusy() const { return m_isBusy.load(std::memory_order_relaxed); }
+        Tile &getTile() { return *m_tile; }
+        DrawBuffer &getDrawBuffer() { return m_tile->getDrawBuffer(); }
 
     private:
-        int m_workloadEstimate;
-        bool m_isWorkAvailable;
+        std::atomic<bool> m_isWorkAvailable;
+        std::atomic<bool> m_isStopRequested;
+        std::atomic<bool> m_isSleeping;
+        std::atomic<bool> m_isBusy;
+        std::atomic<long long> m_wakeUpTime;
+        std::chrono::microseconds m_spinTime;
         std::condition_variable m_workAvailable;
         std::mutex m_mutex;
-        LockFreeQueue<CommandPtr, SWGL_COMMAND_QUEUE_SIZE> m_commandQueue;
         std::thread m_thread;
 
     private:
-        DrawBufferPtr m_drawBuffer;
+        int m_index;
+        DrawThreadPool &m_pool;
+        std::vector<std::pair<long long, DrawClient *>> m_clientOrder;
+        Tile *m_tile;
     };
 }
@@ -0,0 +1,168 @@
+﻿#include <algorithm>
+#include "Configuration.h"
+#include "DrawThreadPool.h"
+
+namespace SWGL {
+
+    DrawThreadPool::DrawThreadPool()
+
+        : m_clients(std::make_shared<DrawClientList>()),
+          m_virtualTime(0),
+          m_numThreads(static_cast<int>(Configuration::getInstance().getNumDrawThreads())),
+          m_nextThief(0) {
+
+    }
+
+
+
+    DrawThreadPool &DrawThreadPool::getInstance() {
+
+        static DrawThreadPool instance;
+        return instance;
+    }
+
+
+
+    DrawClientPtr DrawThreadPool::attach(DrawSurface &drawSurface, int priority) {
+
+        std::lock_guard<std::mutex> cs(m_mutex);
+
+        if (m_drawThreads.empty()) {
+
+            start();
+        }
+
+        // A new client starts at the current virtual time, otherwise it would get
+        // the threads for itself until it has caught up with the others
+        auto client = std::make_shared<DrawClient>(drawSurface, priority);
+        client->virtualTime.store(m_virtualTime.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        // The drawing threads work on a snapshot of the list, so it's never changed
+        // in place
+        auto clients = std::make_shared<DrawClientList>(*m_clients);
+        clients->push_back(client);
+        std::atomic_store(&m_clients, std::shared_ptr<const DrawClientList>(std::move(clients)));
+
+        return client;
+    }
+
+    void DrawThreadPool::detach(const DrawClientPtr &client) {
+
+        {
+            std::lock_guard<std::mutex> cs(m_mutex);
+
+            auto clients = std::make_shared<DrawClientList>(*m_clients);
+            clients->erase(std::remove(clients->begin(), clients->end(), client), clients->end());
+            std::atomic_store(&m_clients, std::shared_ptr<const DrawClientList>(std::move(clients)));
+        }
+
+        // A drawing thread may still work with an old snapshot of the list. Once the
+        // tile lock is released, the threads don't touch the surface anymore.
+        std::unique_lock<std::shared_mutex> lock(client->drawSurface.getTileLock());
+        client->isDetached = true;
+    }
+
+    void DrawThreadPool::start() {
+
+        for (int i = 0; i < m_numThreads; i++) {
+
+            m_drawThreads.emplace_back(std::make_unique<DrawThread>(i, *this));
+            m_drawThreads.back()->start();
+        }
+
+        // The application thread takes part in the work of the pool
+        m_threadPool.start(m_numThreads - 1);
+    }
+
+    void DrawThreadPool::stop() {
+
+        std::lock_guard<std::mutex> cs(m_mutex);
+
+        m_threadPool.stop();
+
+        for (auto &drawThread : m_drawThreads) {
+
+            drawThread->stop();
+        }
+
+        for (auto &drawThread : m_drawThreads) {
+
+            drawThread->join();
+        }
+
+        m_drawThreads.clear();
+    }
+
+
+
+    void DrawThreadPool::wakeUp(int homeThreadIdx) {
+
+        auto &homeThread = *m_drawThreads[homeThreadIdx];
+        homeThread.wakeUp();
+
+        // The home thread is already busy with other tiles, so wake up an idle
+        // thread which can steal the tile
+        if (homeThread.isBusy()) {
+
+            auto n = static_cast<unsigned int>(m_drawThreads.size());
+            auto nextThief = m_nextThief.load(std::memory_order_relaxed);
+
+            for (auto i = 0U; i < n; i++) {
+
+                auto &thief = *m_drawThreads[(nextThief + i) % n];
+                if (!thief.isBusy()) {
+
+                    thief.wakeUp();
+                    m_nextThief.store((nextThief + i + 1) % n, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+    }
+
+    void DrawThreadPool::wakeUpAll() {
+
+        for (auto &drawThread : m_drawThreads) {
+
+            drawThread->wakeUp();
+        }
+    }
+
+
+
+    long long DrawThreadPool::getVirtualTime(const DrawClient &client) const {
+
+        // A client that has been idle for a while doesn't get credit for the time it
+        // didn't need the threads
+        return std::max(
+
+            client.virtualTime.load(std::memory_order_relaxed),
+            m_virtualTime.load(std::memory_order_relaxed) - SWGL_MAX_SCHEDULING_LAG_NS
+        );
+    }
+
+    void DrawThreadPool::addExecutionTime(DrawClient &client, long long nanoseconds) {
+
+        auto priority = std::max(client.priority.load(std::memory_order_relaxed), 1);
+        auto weightedTime = nanoseconds * SWGL_DEFAULT_CONTEXT_PRIORITY / priority;
+
+        // Several drawing threads may work for the same client at once
+        auto clientTime = client.virtualTime.load(std::memory_order_relaxed);
+        long long virtualTime;
+
+        do {
+
+            virtualTime = std::max(
+
+                clientTime,
+                m_virtualTime.load(std::memory_order_relaxed) - SWGL_MAX_SCHEDULING_LAG_NS
+            ) + weightedTime;
+
+        } while (!client.virtualTime.compare_exchange_weak(clientTime, virtualTime, std::memory_order_relaxed));
+
+        // The virtual time of the pool follows the client which is furthest ahead
+        auto poolTime = m_virtualTime.load(std::memory_order_relaxed);
+        while (poolTime < virtualTime &&
+               !m_virtualTime.compare_exchange_weak(poolTime, virtualTime, std::memory_order_relaxed)) { }
+    }
+}
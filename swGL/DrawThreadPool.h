@@ -0,0 +1,103 @@
+﻿#pragma once
+
+#include <shared_mutex>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include "Defines.h"
+#include "DrawSurface.h"
+#include "DrawThread.h"
+#include "ThreadPool.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    struct DrawClient;
+
+    // Type aliases
+    using DrawClientPtr = std::shared_ptr<DrawClient>;
+    using DrawClientList = std::vector<DrawClientPtr>;
+
+    //
+    // The drawing surface of a renderer as seen by the drawing threads
+    //
+    struct DrawClient {
+
+        DrawClient(DrawSurface &drawSurface, int priority)
+
+            : drawSurface(drawSurface),
+              priority(priority),
+              virtualTime(0),
+              measuredUnits(0),
+              measuredTime(0),
+              isDetached(false) {
+
+        }
+
+        DrawSurface &drawSurface;
+
+        // The share of the drawing threads the client gets is proportional to its
+        // priority. The virtual time is the execution time of the client divided by
+        // its priority, the client which is furthest behind is served first.
+        std::atomic<int> priority;
+        std::atomic<long long> virtualTime;
+
+        // Execution times of the commands, picked up by the renderer for its cost model
+        std::atomic<long long> measuredUnits;
+        std::atomic<long long> measuredTime;
+
+        // Set (and read) while holding the tile lock of the drawing surface
+        bool isDetached;
+    };
+
+    //
+    // The drawing threads shared by all contexts of the process. Every renderer attaches
+    // its drawing surface, and the threads work on the tiles of all attached surfaces.
+    // The threads are started with the first renderer and keep running until the last
+    // context is deleted, so creating contexts and switching between them doesn't cost
+    // any threads.
+    //
+    class DrawThreadPool {
+
+    public:
+        ~DrawThreadPool() = default;
+
+        static DrawThreadPool &getInstance();
+
+    public:
+        DrawClientPtr attach(DrawSurface &drawSurface, int priority);
+        void detach(const DrawClientPtr &client);
+        void stop();
+
+    public:
+        void wakeUp(int homeThreadIdx);
+        void wakeUpAll();
+
+        int getNumThreads() const { return m_numThreads; }
+
+        // The pool for the data parallel work of the application threads (see ThreadPool)
+        ThreadPool &getThreadPool() { return m_threadPool; }
+
+    public:
+        std::shared_ptr<const DrawClientList> getClients() const { return std::atomic_load(&m_clients); }
+        long long getVirtualTime(const DrawClient &client) const;
+        void addExecutionTime(DrawClient &client, long long nanoseconds);
+
+    private:
+        DrawThreadPool();
+
+        void start();
+
+    private:
+        std::mutex m_mutex;
+        std::shared_ptr<const DrawClientList> m_clients;
+        std::atomic<long long> m_virtualTime;
+
+    private:
+        int m_numThreads;
+        std::vector<DrawThreadPtr> m_drawThreads;
+        std::atomic<unsigned int> m_nextThief;
+        ThreadPool m_threadPool;
+    };
+}
@@ -0,0 +1,36 @@
+﻿#pragma once
+
+#include <memory>
+#include <chrono>
+#include "CountDownLatch.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    class Fence;
+
+    // Type aliases
+    using FencePtr = std::shared_ptr<Fence>;
+
+    //
+    // Marks a point in the command streams of the tiles. The fence is signaled once
+    // every tile it was inserted into has executed all commands in front of it.
+    //
+    class Fence {
+
+    public:
+        Fence() = default;
+        ~Fence() = default;
+
+    public:
+        void reset(int numTiles) { m_latch.reset(numTiles); }
+        void wait() { m_latch.wait(); }
+        bool waitFor(std::chrono::nanoseconds timeout) { return m_latch.waitFor(timeout); }
+        bool isSignaled() const { return m_latch.isDone(); }
+
+        CountDownLatch &getLatch() { return m_latch; }
+
+    private:
+        CountDownLatch m_latch;
+    };
+}
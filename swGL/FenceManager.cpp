@@ -0,0 +1,86 @@
+﻿#include "FenceManager.h"
+
+namespace SWGL {
+
+    FenceManager::FenceManager()
+
+        : m_nextFenceName(1U) {
+
+    }
+
+
+
+    void FenceManager::genFences(GLsizei count, GLuint *names) {
+
+        for (int i = 0; i < count; i++) {
+
+            while (m_nextFenceName == 0U || m_fences.find(m_nextFenceName) != m_fences.end()) {
+
+                m_nextFenceName++;
+            }
+
+            // The name is reserved, but the fence isn't created until it is set
+            names[i] = m_nextFenceName++;
+            m_fences[names[i]] = nullptr;
+        }
+    }
+
+    void FenceManager::deleteFence(GLuint name) {
+
+        // Commands that still refer to the fence keep it alive
+        m_fences.erase(name);
+    }
+
+    bool FenceManager::isFenceName(GLuint name) {
+
+        return m_fences.find(name) != m_fences.end();
+    }
+
+    FencePtr FenceManager::setFence(GLuint name) {
+
+        // Setting a fence again while it is pending must not disturb the commands
+        // which are already referring to it, so there is always a new fence
+        auto fence = std::make_shared<Fence>();
+
+        m_fences[name] = fence;
+
+        return fence;
+    }
+
+    FencePtr FenceManager::getFence(GLuint name) {
+
+        auto fence = m_fences.find(name);
+        if (fence != m_fences.end()) {
+
+            return fence->second;
+        }
+        return nullptr;
+    }
+
+
+
+    GLsync FenceManager::createSync() {
+
+        auto fence = std::make_shared<Fence>();
+        auto sync = reinterpret_cast<GLsync>(fence.get());
+
+        m_syncs[sync] = fence;
+
+        return sync;
+    }
+
+    bool FenceManager::deleteSync(GLsync sync) {
+
+        return m_syncs.erase(sync) > 0;
+    }
+
+    FencePtr FenceManager::getSync(GLsync sync) {
+
+        auto fence = m_syncs.find(sync);
+        if (fence != m_syncs.end()) {
+
+            return fence->second;
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,36 @@
+﻿#pragma once
+
+#include <map>
+#include "OpenGL.h"
+#include "Fence.h"
+
+namespace SWGL {
+
+    //
+    // Manages the fence objects of GL_NV_fence (referred to by names) and
+    // GL_ARB_sync (referred to by sync handles)
+    //
+    class FenceManager {
+
+    public:
+        FenceManager();
+        ~FenceManager() = default;
+
+    public:
+        void genFences(GLsizei count, GLuint *names);
+        void deleteFence(GLuint name);
+        bool isFenceName(GLuint name);
+        FencePtr setFence(GLuint name);
+        FencePtr getFence(GLuint name);
+
+    public:
+        GLsync createSync();
+        bool deleteSync(GLsync sync);
+        FencePtr getSync(GLsync sync);
+
+    private:
+        std::map<GLuint, FencePtr> m_fences;
+        std::map<GLsync, FencePtr> m_syncs;
+        GLuint m_nextFenceName;
+    };
+}
@@ -0,0 +1,173 @@
+﻿#include <stdexcept>
+#include <chrono>
+#include "Log.h"
+#include "SIMD.h"
+#include "Configuration.h"
+#include "Frontend.h"
+
+namespace SWGL {
+
+    Frontend::Frontend()
+
+        : m_isRunning(false),
+          m_caller(nullptr),
+          m_isStopRequested(false),
+          m_isSleeping(false),
+          m_isProducerWaiting(false),
+          m_numQueuedFrames(0) {
+
+    }
+
+
+
+    void Frontend::start(const std::function<void()> &initThread) {
+
+        if (m_isRunning || !Configuration::getInstance().isFrontendThreadEnabled()) {
+
+            return;
+        }
+
+        m_isStopRequested.store(false, std::memory_order_relaxed);
+
+        // No call can be queued before the thread id is known
+        m_thread = std::thread([this, initThread] {
+
+            initThread();
+            run();
+        });
+        m_threadId = m_thread.get_id();
+        m_isRunning = true;
+    }
+
+    void Frontend::stop() {
+
+        if (!m_isRunning) {
+
+            return;
+        }
+
+        finish();
+
+        {
+            std::lock_guard<std::mutex> cs(m_mutex);
+            m_isStopRequested.store(true);
+        }
+        m_callAvailable.notify_one();
+
+        try {
+
+            if (m_thread.joinable()) {
+
+                m_thread.join();
+            }
+        }
+        catch (std::runtime_error ex) {
+
+            LOG("std::thread::join() failed: %s", ex.what());
+        }
+
+        m_isRunning = false;
+    }
+
+    void Frontend::finish() {
+
+        forwardAndWait([] { });
+    }
+
+    void Frontend::releaseCaller() {
+
+        if (m_caller != nullptr) {
+
+            auto caller = m_caller;
+            m_caller = nullptr;
+            caller->countDown();
+        }
+    }
+
+
+
+    void Frontend::push(Call &call) {
+
+        // The frontend thread is behind, so wait until it made some space
+        if (!m_queue.push(call)) {
+
+            std::unique_lock<std::mutex> cs(m_mutex);
+
+            m_isProducerWaiting.store(true);
+            while (!m_queue.push(call)) {
+
+                m_spaceAvailable.wait(cs);
+            }
+            m_isProducerWaiting.store(false, std::memory_order_relaxed);
+        }
+
+        // Only a sleeping thread has to be notified. The fence makes sure that either
+        // the thread sees the new call, or the call sees the sleeping thread.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_isSleeping.load(std::memory_order_relaxed)) {
+
+            std::lock_guard<std::mutex> cs(m_mutex);
+            m_callAvailable.notify_one();
+        }
+    }
+
+    void Frontend::run() {
+
+        Call call;
+
+        while (waitForCalls()) {
+
+            while (m_queue.pop(call)) {
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_isProducerWaiting.load(std::memory_order_relaxed)) {
+
+                    std::lock_guard<std::mutex> cs(m_mutex);
+                    m_spaceAvailable.notify_one();
+                }
+
+                call.invoke(call.data);
+            }
+        }
+    }
+
+    bool Frontend::waitForCalls() {
+
+        // The next call usually follows shortly, so spin for a while before going
+        // to sleep
+        auto endTime = std::chrono::steady_clock::now() + Configuration::getInstance().getSpinTime();
+
+        for (int i = 1; ; i++) {
+
+            if (!m_queue.isEmpty()) {
+
+                return true;
+            }
+
+            if (m_isStopRequested.load(std::memory_order_relaxed)) {
+
+                return false;
+            }
+
+            _mm_pause();
+
+            if ((i & 63) == 0 && std::chrono::steady_clock::now() >= endTime) {
+
+                break;
+            }
+        }
+
+        std::unique_lock<std::mutex> cs(m_mutex);
+
+        m_isSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        m_callAvailable.wait(cs, [this] {
+
+            return !m_queue.isEmpty() || m_isStopRequested.load();
+        });
+        m_isSleeping.store(false, std::memory_order_relaxed);
+
+        return !m_queue.isEmpty();
+    }
+}
@@ -0,0 +1,162 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <type_traits>
+#include <functional>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "Defines.h"
+#include "CountDownLatch.h"
+#include "LockFreeQueue.h"
+
+namespace SWGL {
+
+    //
+    // Executes the OpenGL calls of the application on a thread of its own (if enabled
+    // with SWGL_FRONTEND_THREAD). The entry points push their call into a queue and
+    // return right away, so the application can go on while the vertices are being
+    // transformed, clipped and binned. Calls which return something or which read
+    // application memory wait until the frontend thread has executed them.
+    //
+    class Frontend {
+
+    public:
+        Frontend();
+        ~Frontend() = default;
+
+    public:
+        // Runs initThread on the frontend thread before the first call
+        void start(const std::function<void()> &initThread);
+        void stop();
+
+        // Waits until all calls in the queue are done
+        void finish();
+
+        // Lets the application go on while the current call is still executing. Has
+        // to be called once the call doesn't access application memory anymore.
+        void releaseCaller();
+
+    public:
+        bool isForwarding() const {
+
+            return m_isRunning && std::this_thread::get_id() != m_threadId;
+        }
+
+        // Queues the call and returns true. Returns false if the call has to be
+        // executed right away by the caller (the frontend isn't running, or the
+        // call was made by the frontend thread itself).
+        template<typename Function>
+        bool forward(const Function &function) {
+
+            if (!isForwarding()) {
+
+                return false;
+            }
+
+            pushCall(function);
+            return true;
+        }
+
+        // Like forward(), but waits until the call is done (or released)
+        template<typename Function>
+        bool forwardAndWait(const Function &function) {
+
+            if (!isForwarding()) {
+
+                return false;
+            }
+
+            CountDownLatch latch;
+            latch.reset(1);
+
+            pushCall([this, &latch, function] {
+
+                m_caller = &latch;
+                function();
+                releaseCaller();
+            });
+
+            latch.wait();
+            return true;
+        }
+
+        // Like forward(), but for the end of a frame. The application may only run
+        // a limited number of frames ahead of the frontend thread.
+        template<typename Function>
+        bool forwardFrame(const Function &function) {
+
+            if (!isForwarding()) {
+
+                return false;
+            }
+
+            {
+                std::unique_lock<std::mutex> cs(m_frameMutex);
+                m_frameDone.wait(cs, [this] {
+
+                    return m_numQueuedFrames < SWGL_FRONTEND_MAX_QUEUED_FRAMES;
+                });
+                m_numQueuedFrames++;
+            }
+
+            pushCall([this, function] {
+
+                function();
+
+                std::lock_guard<std::mutex> cs(m_frameMutex);
+                m_numQueuedFrames--;
+                m_frameDone.notify_one();
+            });
+
+            return true;
+        }
+
+    private:
+        struct Call {
+
+            void (*invoke)(const void *data);
+            alignas(8) unsigned char data[SWGL_FRONTEND_CALL_SIZE];
+        };
+
+        template<typename Function>
+        void pushCall(const Function &function) {
+
+            // The arguments are copied into the queue as they are
+            static_assert(sizeof(Function) <= SWGL_FRONTEND_CALL_SIZE, "The arguments of the call don't fit into the queue");
+            static_assert(alignof(Function) <= 8, "The arguments of the call aren't aligned properly");
+            static_assert(std::is_trivially_copyable<Function>::value, "The arguments of the call can't be copied");
+
+            Call call;
+            call.invoke = [](const void *data) { (*reinterpret_cast<const Function *>(data))(); };
+            std::memcpy(call.data, &function, sizeof(Function));
+
+            push(call);
+        }
+
+        void push(Call &call);
+        void run();
+        bool waitForCalls();
+
+    private:
+        std::thread m_thread;
+        std::thread::id m_threadId;
+        bool m_isRunning;
+        CountDownLatch *m_caller;
+
+    private:
+        LockFreeQueue<Call, SWGL_FRONTEND_QUEUE_SIZE> m_queue;
+        std::atomic<bool> m_isStopRequested;
+        std::atomic<bool> m_isSleeping;
+        std::atomic<bool> m_isProducerWaiting;
+        std::condition_variable m_callAvailable;
+        std::condition_variable m_spaceAvailable;
+        std::mutex m_mutex;
+
+    private:
+        int m_numQueuedFrames;
+        std::condition_variable m_frameDone;
+        std::mutex m_frameMutex;
+    };
+}
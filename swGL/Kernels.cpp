@@ -0,0 +1,23 @@
+﻿#include "Log.h"
+#include "Configuration.h"
+#include "Kernels.h"
+
+namespace SWGL {
+
+    static const Kernels &selectKernels() {
+
+        switch (Configuration::getInstance().getSIMDLevel()) {
+
+        case SIMDLevel::AVX512: LOG("Using the AVX-512 kernels"); return KERNELS_AVX512;
+        case SIMDLevel::AVX2: LOG("Using the AVX2 kernels"); return KERNELS_AVX2;
+        case SIMDLevel::SSE41: LOG("Using the SSE4.1 kernels"); return KERNELS_SSE41;
+        default: LOG("Using the SSE2 kernels"); return KERNELS_SSE2;
+        }
+    }
+
+    const Kernels &Kernels::get() {
+
+        static const Kernels &kernels = selectKernels();
+        return kernels;
+    }
+}
@@ -0,0 +1,76 @@
+﻿#pragma once
+
+#include "Defines.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    class DrawBuffer;
+    struct TriangleDrawCallState;
+    struct RasterOps;
+    struct TextureEnvironment;
+    struct ARGBColor;
+    struct ARGBColor8;
+    enum class TextureBaseFormat : unsigned int;
+
+    // Rasterizes and shades triangles of a draw call (see CommandDrawTriangle.inl)
+    using DrawTrianglesKernel = bool (*)(TriangleDrawCallState &state, const int *indices, int numIndices, DrawBuffer &drawBuffer);
+
+    // Applies the texture function of a texture unit to a quad (see TextureEnvironment.inl)
+    using TexEnvKernel = void (*)(const TextureEnvironment &texEnv, const ARGBColor &texColor, const ARGBColor &primaryColor, ARGBColor &color);
+
+    // The same for a pair of quads (see CommandDrawTriangleAVX2.inl)
+    using TexEnvKernel8 = void (*)(const TextureEnvironment &texEnv, const ARGBColor8 &texColor, const ARGBColor8 &primaryColor, ARGBColor8 &color);
+
+    // The bounding boxes of four triangles (see Kernels::setupTriangles)
+    struct TriangleBounds {
+
+        alignas(16) int minX[4];
+        alignas(16) int minY[4];
+        alignas(16) int maxX[4];
+        alignas(16) int maxY[4];
+    };
+
+    //
+    // The SIMD kernels of swGL. They are compiled once per instruction set (see
+    // Kernels.inl), and the best set the CPU supports is picked on first use (see
+    // Configuration::getSIMDLevel()).
+    //
+    struct Kernels {
+
+        // Sets up four triangles and returns the mask of the visible ones (see Binner.inl)
+        int (*setupTriangles)(TriangleDrawCallState &state, int first, int numLanes, int clipMinX, int clipMinY, int clipMaxX, int clipMaxY, TriangleBounds &bounds);
+
+        // The generic draw triangle kernel, which handles all raster operations
+        DrawTrianglesKernel drawTriangles;
+
+        // Returns the kernel that is specialized on the raster operations, or the generic
+        // one if there is none (see CommandDrawTriangle.inl)
+        DrawTrianglesKernel (*selectDrawTriangles)(const RasterOps &rasterOps);
+
+        // Returns the kernel of the texture function of a texture unit
+        TexEnvKernel (*selectTexEnv)(const TextureEnvironment &texEnv, TextureBaseFormat format);
+
+        // Returns the kernel of the texture function for pairs of quads, or nullptr if
+        // the instruction set or the function isn't supported by the pair kernels
+        TexEnvKernel8 (*selectTexEnv8)(const TextureEnvironment &texEnv, TextureBaseFormat format);
+
+        // Returns the visibility pass kernel for the raster operations, or nullptr if the
+        // triangles have to be shaded right away (see VisibilityBuffer.inl)
+        DrawTrianglesKernel (*selectDrawVisibility)(const RasterOps &rasterOps);
+
+        // Shades the pixels of a tile which the visibility pass has left
+        void (*resolveVisibility)(DrawBuffer &drawBuffer);
+
+        // Writes the color buffer of a tile into a linear image (see DrawBuffer.inl)
+        void (*unswizzleColor)(DrawBuffer &drawBuffer, unsigned int *dst, int dstWidth);
+
+        static const Kernels &get();
+    };
+
+    // The kernels of each instruction set
+    extern const Kernels KERNELS_SSE2;
+    extern const Kernels KERNELS_SSE41;
+    extern const Kernels KERNELS_AVX2;
+    extern const Kernels KERNELS_AVX512;
+}
@@ -0,0 +1,22 @@
+﻿#pragma once
+
+//
+// Compiles all kernels for the instruction set given by SWGL_SIMD_LEVEL, which has to be
+// defined before this file is included. Everything the kernels define lives in the
+// namespace of the level (see SIMD.h), otherwise the linker could pick the copy of another
+// instruction set. For the same reason they must not call inline members of the classes
+// or the standard library which work on floats, such as std::min or the float getters of
+// the context state. The members of DrawBuffer are compiled in DrawBuffer.cpp.
+//
+#ifndef SWGL_SIMD_LEVEL
+#error "SWGL_SIMD_LEVEL has to be defined by the translation unit of the kernels"
+#endif
+
+#include "Kernels.h"
+#include "Binner.inl"
+#include "CommandDrawTriangle.inl"
+#include "TextureEnvironment.inl"
+#include "VisibilityBuffer.inl"
+#include "DrawBuffer.inl"
+
+#define SWGL_KERNELS { &setupTriangles, &drawTriangles<RASTER_OP_RUNTIME, RASTER_OP_RUNTIME, RASTER_OP_RUNTIME, RASTER_OP_RUNTIME, RASTER_OP_RUNTIME>, &selectDrawTriangles, &selectTexEnv, &selectTexEnv8, &selectDrawVisibility, &resolveVisibility, &unswizzleColor }
@@ -0,0 +1,7 @@
+﻿#define SWGL_SIMD_LEVEL SWGL_SIMD_AVX512
+#include "Kernels.inl"
+
+namespace SWGL {
+
+    const Kernels KERNELS_AVX512 = SWGL_KERNELS;
+}
@@ -0,0 +1,7 @@
+﻿#define SWGL_SIMD_LEVEL SWGL_SIMD_SSE2
+#include "Kernels.inl"
+
+namespace SWGL {
+
+    const Kernels KERNELS_SSE2 = SWGL_KERNELS;
+}
@@ -0,0 +1,7 @@
+﻿#define SWGL_SIMD_LEVEL SWGL_SIMD_SSE41
+#include "Kernels.inl"
+
+namespace SWGL {
+
+    const Kernels KERNELS_SSE41 = SWGL_KERNELS;
+}
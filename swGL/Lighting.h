@@ -228,11 +228,16 @@ namespace SWGL {
     public:
         void calculateLighting(TriangleList &triangles) {
 
+            calculateLighting(triangles.data(), triangles.data() + triangles.size());
+        }
+
+        void calculateLighting(Triangle *first, Triangle *last) {
+
             // TODO: Specular light, two sided lighting, optimization, etc...
 
-            for (auto &t : triangles) {
+            for (auto t = first; t != last; t++) {
 
-                for (auto &v : t.v) {
+                for (auto &v : t->v) {
 
                     //
                     // Calculate lighting
@@ -0,0 +1,158 @@
+﻿#include <algorithm>
+#include <numeric>
+#include "Defines.h"
+#include "Configuration.h"
+#include "Statistics.h"
+#include "LoadBalancer.h"
+
+namespace SWGL {
+
+    // Weight of the last frame in the moving average of the tile execution times
+    static constexpr float TILE_TIME_WEIGHT = 0.25f;
+
+    // Number of frames that are measured before the tiles get assigned anew
+    static constexpr int MIN_HISTORY_FRAMES = 8;
+
+    // The new assignment has to shorten the time of the slowest thread by at least
+    // this fraction, otherwise the tiles stay where they are
+    static constexpr float MIN_IMPROVEMENT = 0.1f;
+
+    // Frames which take less time (in nanoseconds) on the slowest thread aren't worth
+    // to be balanced
+    static constexpr float MIN_FRAME_TIME_NS = 500000.0f;
+
+
+
+    LoadBalancer::LoadBalancer()
+
+        : m_numFrames(0) {
+
+        auto &config = Configuration::getInstance();
+
+        m_isEnabled = config.isLoadBalancingEnabled();
+        m_numThreads = static_cast<int>(config.getNumDrawThreads());
+    }
+
+
+
+    void LoadBalancer::rebalance(DrawSurface &drawSurface) {
+
+        auto numTiles = drawSurface.getNumTiles();
+        if (!m_isEnabled || m_numThreads <= 1 || numTiles == 0) {
+
+            return;
+        }
+
+        if (static_cast<int>(m_tileTimes.size()) != numTiles) {
+
+            reset();
+            m_tileTimes.resize(numTiles, 0.0f);
+        }
+
+        // The tiles are still being drawn while the times are collected, so the
+        // measurements of a frame partially fall into the next one. This evens out
+        // over the moving average.
+        for (int i = 0; i < numTiles; i++) {
+
+            auto executionTime = static_cast<float>(drawSurface.getTile(i).takeExecutionTime());
+            m_tileTimes[i] += TILE_TIME_WEIGHT * (executionTime - m_tileTimes[i]);
+        }
+
+        if (++m_numFrames < MIN_HISTORY_FRAMES) {
+
+            return;
+        }
+
+        m_currentAssignment.resize(numTiles);
+
+        for (int i = 0; i < numTiles; i++) {
+
+            m_currentAssignment[i] = drawSurface.getTile(i).getHomeThread();
+        }
+
+        auto currentTime = getMaxThreadTime(m_currentAssignment);
+        if (currentTime < MIN_FRAME_TIME_NS) {
+
+            return;
+        }
+
+        assignTiles();
+
+        if (getMaxThreadTime(m_newAssignment) > currentTime * (1.0f - MIN_IMPROVEMENT)) {
+
+            return;
+        }
+
+        // The buffers of a tile stay where its first home thread has set them up
+        int numMigrations = 0;
+
+        for (int i = 0; i < numTiles; i++) {
+
+            if (m_newAssignment[i] != m_currentAssignment[i]) {
+
+                drawSurface.getTile(i).setHomeThread(m_newAssignment[i]);
+                numMigrations++;
+            }
+        }
+
+        STATISTICS_ADD(TILE_MIGRATIONS, numMigrations);
+    }
+
+    void LoadBalancer::reset() {
+
+        m_numFrames = 0;
+        m_tileTimes.clear();
+    }
+
+
+
+    void LoadBalancer::assignTiles() {
+
+        auto numTiles = static_cast<int>(m_tileTimes.size());
+
+        // Most expensive tiles first
+        m_order.resize(numTiles);
+        std::iota(m_order.begin(), m_order.end(), 0);
+        std::stable_sort(m_order.begin(), m_order.end(), [this](int a, int b) {
+
+            return m_tileTimes[a] > m_tileTimes[b];
+        });
+
+        m_threadTimes.assign(m_numThreads, 0.0f);
+        m_newAssignment.resize(numTiles);
+
+        for (auto tileIdx : m_order) {
+
+            // Tiles without any work don't matter, so they keep their home thread.
+            // The current home thread also wins if several threads have the same
+            // amount of work.
+            auto bestThread = m_currentAssignment[tileIdx];
+
+            if (m_tileTimes[tileIdx] > 0.0f) {
+
+                for (int i = 0; i < m_numThreads; i++) {
+
+                    if (m_threadTimes[i] < m_threadTimes[bestThread]) {
+
+                        bestThread = i;
+                    }
+                }
+            }
+
+            m_threadTimes[bestThread] += m_tileTimes[tileIdx];
+            m_newAssignment[tileIdx] = bestThread;
+        }
+    }
+
+    float LoadBalancer::getMaxThreadTime(const std::vector<int> &assignment) {
+
+        m_threadTimes.assign(m_numThreads, 0.0f);
+
+        for (int i = 0, n = static_cast<int>(assignment.size()); i < n; i++) {
+
+            m_threadTimes[assignment[i]] += m_tileTimes[i];
+        }
+
+        return *std::max_element(m_threadTimes.begin(), m_threadTimes.end());
+    }
+}
@@ -0,0 +1,40 @@
+﻿#pragma once
+
+#include <vector>
+#include "DrawSurface.h"
+
+namespace SWGL {
+
+    //
+    // Adjusts the home threads of the tiles from frame to frame. The execution times of
+    // the tiles are averaged over the last frames and the tiles are assigned anew (the
+    // most expensive one first, each to the thread with the least work so far), so the
+    // slowest thread gets done as early as possible. The new assignment is only taken
+    // over if it is noticeably better than the current one, so the tiles don't jump
+    // between the threads all the time.
+    //
+    class LoadBalancer {
+
+    public:
+        LoadBalancer();
+        ~LoadBalancer() = default;
+
+    public:
+        void rebalance(DrawSurface &drawSurface);
+        void reset();
+
+    private:
+        void assignTiles();
+        float getMaxThreadTime(const std::vector<int> &assignment);
+
+    private:
+        bool m_isEnabled;
+        int m_numThreads;
+        int m_numFrames;
+        std::vector<float> m_tileTimes;
+        std::vector<int> m_currentAssignment;
+        std::vector<int> m_newAssignment;
+        std::vector<int> m_order;
+        std::vector<float> m_threadTimes;
+    };
+}
@@ -50,6 +50,11 @@ namespace SWGL {
             return true;
         }
 
+        bool isEmpty() const {
+
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
     private:
         static constexpr size_t CAPACITY = size + 1;
         static constexpr size_t getNextIndex(size_t idx) {
@@ -58,8 +63,10 @@ namespace SWGL {
         }
 
     private:
-        std::atomic<size_t> m_head;
-        std::array<T, CAPACITY> m_elements;
-        std::atomic<size_t> m_tail;
+        // The head is written by the consumer and the tail by the producer, so both
+        // get a cache line of their own
+        alignas(64) std::atomic<size_t> m_head;
+        alignas(64) std::atomic<size_t> m_tail;
+        alignas(64) std::array<T, CAPACITY> m_elements;
     };
 }
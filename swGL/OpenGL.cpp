@@ -1,4 +1,8 @@
 ﻿#include <algorithm>
+#include <limits>
+#include <chrono>
+#include <array>
+#include <type_traits>
 #include "OpenGL.h"
 #include "Context.h"
 #include "Log.h"
@@ -46,6 +50,63 @@
 
 #define CAN_BE_CALLED_INSIDE_GL_BEGIN()
 
+// The calls are executed by the frontend thread if it is enabled (see SWGL::Frontend).
+// Calls which only take values return right away, calls which read or write memory of
+// the application or return a value wait until they are done.
+#define FORWARD_TO_FRONTEND(FUNCTION, ...)                                   \
+    do {                                                                     \
+                                                                             \
+        if (ctx->getFrontend().forward([=] { FUNCTION(__VA_ARGS__); })) {    \
+                                                                             \
+            return;                                                          \
+        }                                                                    \
+    }                                                                        \
+    while(0)
+
+#define FORWARD_TO_FRONTEND_AND_WAIT(FUNCTION, ...)                                 \
+    do {                                                                            \
+                                                                                    \
+        if (ctx->getFrontend().forwardAndWait([&] { FUNCTION(__VA_ARGS__); })) {    \
+                                                                                    \
+            return;                                                                 \
+        }                                                                           \
+    }                                                                               \
+    while(0)
+
+#define FORWARD_TO_FRONTEND_AND_RETURN(FUNCTION, ...)                                                \
+    do {                                                                                             \
+                                                                                                     \
+        decltype(FUNCTION(__VA_ARGS__)) frontendResult;                                              \
+        if (ctx->getFrontend().forwardAndWait([&] { frontendResult = FUNCTION(__VA_ARGS__); })) {    \
+                                                                                                     \
+            return frontendResult;                                                                   \
+        }                                                                                            \
+    }                                                                                                \
+    while(0)
+
+// Copies the SIZE elements the argument ARRAY points to, so the call doesn't have to wait
+#define FORWARD_TO_FRONTEND_WITH_ARRAY(ARRAY, SIZE, FUNCTION, ...)                                       \
+    do {                                                                                                 \
+                                                                                                         \
+        if (ctx->getFrontend().isForwarding()) {                                                         \
+                                                                                                         \
+            std::array<std::remove_cv_t<std::remove_pointer_t<decltype(ARRAY)>>, SIZE> frontendArray;    \
+            auto isNullArray = ARRAY == nullptr;                                                         \
+            if (!isNullArray) {                                                                          \
+                                                                                                         \
+                std::copy(ARRAY, ARRAY + SIZE, frontendArray.begin());                                   \
+            }                                                                                            \
+                                                                                                         \
+            ctx->getFrontend().forward([=] {                                                             \
+                                                                                                         \
+                auto ARRAY = isNullArray ? nullptr : frontendArray.data();                               \
+                FUNCTION(__VA_ARGS__);                                                                   \
+            });                                                                                          \
+            return;                                                                                      \
+        }                                                                                                \
+    }                                                                                                    \
+    while(0)
+
 #pragma region OpenGL 1.0
 
 SWGLAPI void STDCALL glDrv_glAccum(GLenum op, GLfloat value) {
@@ -53,6 +114,7 @@ SWGLAPI void STDCALL glDrv_glAccum(GLenum op, GLfloat value) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glAccum, op, value);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -63,6 +125,7 @@ SWGLAPI void STDCALL glDrv_glAlphaFunc(GLenum func, GLclampf ref) {
     LOG("Alpha Func: %04X, Ref: %f", func, ref);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glAlphaFunc, func, ref);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (func) {
@@ -76,6 +139,7 @@ SWGLAPI void STDCALL glDrv_glAlphaFunc(GLenum func, GLclampf ref) {
     case GL_GEQUAL:
     case GL_ALWAYS:
         ctx->getAlphaTesting().setAlphaFunc(func, ref);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     default:
@@ -89,6 +153,7 @@ SWGLAPI void STDCALL glDrv_glBegin(GLenum mode) {
     LOG("Mode: %04x", mode);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glBegin, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (mode) {
@@ -117,6 +182,7 @@ SWGLAPI void STDCALL glDrv_glBitmap(GLsizei width, GLsizei height, GLfloat xOrig
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glBitmap, width, height, xOrig, yOrig, xMove, yMove, bitmap);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -127,6 +193,7 @@ SWGLAPI void STDCALL glDrv_glBlendFunc(GLenum srcFactor, GLenum dstFactor) {
     LOG("Source Factor: %04X, Destination Factor: %04X", srcFactor, dstFactor);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glBlendFunc, srcFactor, dstFactor);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // Validate the source factor
@@ -167,6 +234,7 @@ SWGLAPI void STDCALL glDrv_glBlendFunc(GLenum srcFactor, GLenum dstFactor) {
     }
 
     ctx->getBlending().setFactors(srcFactor, dstFactor);
+    ctx->getRenderer().invalidateDrawState();
 }
 
 SWGLAPI void STDCALL glDrv_glCallList(GLuint list) {
@@ -174,6 +242,7 @@ SWGLAPI void STDCALL glDrv_glCallList(GLuint list) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCallList, list);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -184,6 +253,7 @@ SWGLAPI void STDCALL glDrv_glCallLists(GLsizei n, GLenum type, const GLvoid *lis
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glCallLists, n, type, lists);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -194,6 +264,7 @@ SWGLAPI void STDCALL glDrv_glClear(GLbitfield mask) {
     LOG("Mask: %04x", mask);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glClear, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if ((mask & GL_COLOR_BUFFER_BIT) != 0) {
@@ -211,6 +282,7 @@ SWGLAPI void STDCALL glDrv_glClearAccum(GLfloat red, GLfloat green, GLfloat blue
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glClearAccum, red, green, blue, alpha);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -221,6 +293,7 @@ SWGLAPI void STDCALL glDrv_glClearColor(GLclampf red, GLclampf green, GLclampf b
     LOG("Alpha = %f, Red = %f, Green = %f, Blue = %f", alpha, red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glClearColor, red, green, blue, alpha);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getClearValues().setClearColor(
@@ -237,6 +310,7 @@ SWGLAPI void STDCALL glDrv_glClearDepth(GLclampd depth) {
     LOG("Depth = %f", depth);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glClearDepth, depth);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getClearValues().setClearDepth(depth);
@@ -247,6 +321,7 @@ SWGLAPI void STDCALL glDrv_glClearIndex(GLfloat c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glClearIndex, c);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -257,6 +332,7 @@ SWGLAPI void STDCALL glDrv_glClearStencil(GLint s) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glClearStencil, s);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -267,6 +343,7 @@ SWGLAPI void STDCALL glDrv_glClipPlane(GLenum plane, const GLdouble *equation) {
     LOG("Plane: %d, A: %f, B: %f, C: %f, D: %f", plane - GL_CLIP_PLANE0, equation[0], equation[1], equation[2], equation[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glClipPlane, plane, equation);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (equation != nullptr) {
@@ -308,6 +385,7 @@ SWGLAPI void STDCALL glDrv_glColor3b(GLbyte red, GLbyte green, GLbyte blue) {
     LOG("Red: %d, Green: %d, Blue: %d", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3b, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -327,6 +405,7 @@ SWGLAPI void STDCALL glDrv_glColor3bv(const GLbyte *v) {
     LOG("Red: %d, Green: %d, Blue: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3bv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -349,6 +428,7 @@ SWGLAPI void STDCALL glDrv_glColor3d(GLdouble red, GLdouble green, GLdouble blue
     LOG("Red: %f, Green: %f, Blue: %f", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3d, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -368,6 +448,7 @@ SWGLAPI void STDCALL glDrv_glColor3dv(const GLdouble *v) {
     LOG("Red: %f, Green: %f, Blue: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -390,6 +471,7 @@ SWGLAPI void STDCALL glDrv_glColor3f(GLfloat red, GLfloat green, GLfloat blue) {
     LOG("Red: %f, Green: %f, Blue: %f", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3f, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -403,6 +485,7 @@ SWGLAPI void STDCALL glDrv_glColor3fv(const GLfloat *v) {
     LOG("Red: %f, Green: %f, Blue: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -419,6 +502,7 @@ SWGLAPI void STDCALL glDrv_glColor3i(GLint red, GLint green, GLint blue) {
     LOG("Red: %d, Green: %d, Blue: %d", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3i, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -438,6 +522,7 @@ SWGLAPI void STDCALL glDrv_glColor3iv(const GLint *v) {
     LOG("Red: %d, Green: %d, Blue: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -460,6 +545,7 @@ SWGLAPI void STDCALL glDrv_glColor3s(GLshort red, GLshort green, GLshort blue) {
     LOG("Red: %d, Green: %d, Blue: %d", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3s, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -479,6 +565,7 @@ SWGLAPI void STDCALL glDrv_glColor3sv(const GLshort *v) {
     LOG("Red: %d, Green: %d, Blue: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -501,6 +588,7 @@ SWGLAPI void STDCALL glDrv_glColor3ub(GLubyte red, GLubyte green, GLubyte blue)
     LOG("Red: %d, Green: %d, Blue: %d", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3ub, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -520,6 +608,7 @@ SWGLAPI void STDCALL glDrv_glColor3ubv(const GLubyte *v) {
     LOG("Red: %d, Green: %d, Blue: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3ubv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -542,6 +631,7 @@ SWGLAPI void STDCALL glDrv_glColor3ui(GLuint red, GLuint green, GLuint blue) {
     LOG("Red: %d, Green: %d, Blue: %d", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3ui, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -561,6 +651,7 @@ SWGLAPI void STDCALL glDrv_glColor3uiv(const GLuint *v) {
     LOG("Red: %d, Green: %d, Blue: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3uiv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -583,6 +674,7 @@ SWGLAPI void STDCALL glDrv_glColor3us(GLushort red, GLushort green, GLushort blu
     LOG("Red: %d, Green: %d, Blue: %d", red, green, blue);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor3us, red, green, blue);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -602,6 +694,7 @@ SWGLAPI void STDCALL glDrv_glColor3usv(const GLushort *v) {
     LOG("Red: %d, Green: %d, Blue: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glColor3usv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -624,6 +717,7 @@ SWGLAPI void STDCALL glDrv_glColor4b(GLbyte red, GLbyte green, GLbyte blue, GLby
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4b, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -643,6 +737,7 @@ SWGLAPI void STDCALL glDrv_glColor4bv(const GLbyte *v) {
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4bv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -665,6 +760,7 @@ SWGLAPI void STDCALL glDrv_glColor4d(GLdouble red, GLdouble green, GLdouble blue
     LOG("Red: %f, Green: %f, Blue: %f, Alpha: %f", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4d, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -684,6 +780,7 @@ SWGLAPI void STDCALL glDrv_glColor4dv(const GLdouble *v) {
     LOG("Red: %f, Green: %f, Blue: %f, Alpha: %f", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -706,6 +803,7 @@ SWGLAPI void STDCALL glDrv_glColor4f(GLfloat red, GLfloat green, GLfloat blue, G
     LOG("Red: %f, Green: %f, Blue: %f, Alpha: %f", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4f, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -719,6 +817,7 @@ SWGLAPI void STDCALL glDrv_glColor4fv(const GLfloat *v) {
     LOG("Red: %f, Green: %f, Blue: %f, Alpha: %f", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -735,6 +834,7 @@ SWGLAPI void STDCALL glDrv_glColor4i(GLint red, GLint green, GLint blue, GLint a
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4i, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -754,6 +854,7 @@ SWGLAPI void STDCALL glDrv_glColor4iv(const GLint *v) {
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -776,6 +877,7 @@ SWGLAPI void STDCALL glDrv_glColor4s(GLshort red, GLshort green, GLshort blue, G
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4s, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -795,6 +897,7 @@ SWGLAPI void STDCALL glDrv_glColor4sv(const GLshort *v) {
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -817,6 +920,7 @@ SWGLAPI void STDCALL glDrv_glColor4ub(GLubyte red, GLubyte green, GLubyte blue,
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4ub, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -836,6 +940,7 @@ SWGLAPI void STDCALL glDrv_glColor4ubv(const GLubyte *v) {
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4ubv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -858,6 +963,7 @@ SWGLAPI void STDCALL glDrv_glColor4ui(GLuint red, GLuint green, GLuint blue, GLu
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4ui, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -877,6 +983,7 @@ SWGLAPI void STDCALL glDrv_glColor4uiv(const GLuint *v) {
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4uiv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -899,6 +1006,7 @@ SWGLAPI void STDCALL glDrv_glColor4us(GLushort red, GLushort green, GLushort blu
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColor4us, red, green, blue, alpha);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setPrimaryColor(
@@ -918,6 +1026,7 @@ SWGLAPI void STDCALL glDrv_glColor4usv(const GLushort *v) {
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glColor4usv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -940,6 +1049,7 @@ SWGLAPI void STDCALL glDrv_glColorMask(GLboolean red, GLboolean green, GLboolean
     LOG("Red: %d, Green: %d, Blue: %d, Alpha: %d", red, green, blue, alpha);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColorMask, red, green, blue, alpha);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getColorMask().setMask(
@@ -949,6 +1059,7 @@ SWGLAPI void STDCALL glDrv_glColorMask(GLboolean red, GLboolean green, GLboolean
         green == GL_TRUE,
         blue == GL_TRUE
     );
+    ctx->getRenderer().invalidateDrawState();
 }
 
 SWGLAPI void STDCALL glDrv_glColorMaterial(GLenum face, GLenum mode) {
@@ -956,6 +1067,7 @@ SWGLAPI void STDCALL glDrv_glColorMaterial(GLenum face, GLenum mode) {
     LOG("Face: %04x, Mode: %04x", face, mode);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColorMaterial, face, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     bool isFront = face == GL_FRONT || face == GL_FRONT_AND_BACK;
@@ -988,6 +1100,7 @@ SWGLAPI void STDCALL glDrv_glCopyPixels(GLint x, GLint y, GLsizei width, GLsizei
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCopyPixels, x, y, width, height, type);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -998,6 +1111,7 @@ SWGLAPI void STDCALL glDrv_glCullFace(GLenum mode) {
     LOG("Mode: %04x", mode);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCullFace, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (mode) {
@@ -1019,6 +1133,7 @@ SWGLAPI void STDCALL glDrv_glDeleteLists(GLuint list, GLsizei range) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDeleteLists, list, range);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1029,6 +1144,7 @@ SWGLAPI void STDCALL glDrv_glDepthFunc(GLenum func) {
     LOG("Function: %04x", func);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDepthFunc, func);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (func) {
@@ -1042,6 +1158,7 @@ SWGLAPI void STDCALL glDrv_glDepthFunc(GLenum func) {
     case GL_GEQUAL:
     case GL_ALWAYS:
         ctx->getDepthTesting().setTestFunction(func);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     default:
@@ -1055,9 +1172,11 @@ SWGLAPI void STDCALL glDrv_glDepthMask(GLboolean flag) {
     LOG("Depth Write Enable: %d", flag == GL_TRUE);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDepthMask, flag);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getDepthTesting().setWriteEnable(flag == GL_TRUE);
+    ctx->getRenderer().invalidateDrawState();
 }
 
 SWGLAPI void STDCALL glDrv_glDepthRange(GLclampd zNear, GLclampd zFar) {
@@ -1065,6 +1184,7 @@ SWGLAPI void STDCALL glDrv_glDepthRange(GLclampd zNear, GLclampd zFar) {
     LOG("Near: %f, Far: %f", zNear, zFar);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDepthRange, zNear, zFar);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().getViewport().setDepthRange(zNear, zFar);
@@ -1075,6 +1195,7 @@ SWGLAPI void STDCALL glDrv_glDisable(GLenum cap) {
     LOG("Capability: %04x", cap);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDisable, cap);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (cap) {
@@ -1111,14 +1232,17 @@ SWGLAPI void STDCALL glDrv_glDisable(GLenum cap) {
 
     case GL_DEPTH_TEST:
         ctx->getDepthTesting().setTestEnable(false);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_BLEND:
         ctx->getBlending().setEnable(false);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_ALPHA_TEST:
         ctx->getAlphaTesting().setEnable(false);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_TEXTURE_1D:
@@ -1130,10 +1254,12 @@ SWGLAPI void STDCALL glDrv_glDisable(GLenum cap) {
 
     case GL_SCISSOR_TEST:
         ctx->getScissor().setEnable(false);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_POLYGON_OFFSET_FILL:
         ctx->getPolygonOffset().setFillEnable(false);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_CLIP_PLANE0:
@@ -1156,6 +1282,7 @@ SWGLAPI void STDCALL glDrv_glDrawBuffer(GLenum mode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDrawBuffer, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1166,6 +1293,7 @@ SWGLAPI void STDCALL glDrv_glDrawPixels(GLsizei width, GLsizei height, GLenum fo
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glDrawPixels, width, height, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1176,6 +1304,7 @@ SWGLAPI void STDCALL glDrv_glEdgeFlag(GLboolean flag) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEdgeFlag, flag);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1186,6 +1315,7 @@ SWGLAPI void STDCALL glDrv_glEdgeFlagv(const GLboolean *flag) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(flag, 1, glDrv_glEdgeFlagv, flag);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1196,6 +1326,7 @@ SWGLAPI void STDCALL glDrv_glEnable(GLenum cap) {
     LOG("Capability: %04x", cap);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEnable, cap);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (cap) {
@@ -1232,14 +1363,17 @@ SWGLAPI void STDCALL glDrv_glEnable(GLenum cap) {
 
     case GL_DEPTH_TEST:
         ctx->getDepthTesting().setTestEnable(true);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_BLEND:
         ctx->getBlending().setEnable(true);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_ALPHA_TEST:
         ctx->getAlphaTesting().setEnable(true);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_TEXTURE_1D:
@@ -1251,10 +1385,12 @@ SWGLAPI void STDCALL glDrv_glEnable(GLenum cap) {
 
     case GL_SCISSOR_TEST:
         ctx->getScissor().setEnable(true);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_POLYGON_OFFSET_FILL:
         ctx->getPolygonOffset().setFillEnable(true);
+        ctx->getRenderer().invalidateDrawState();
         break;
 
     case GL_CLIP_PLANE0:
@@ -1277,6 +1413,7 @@ SWGLAPI void STDCALL glDrv_glEnd(void) {
     LOG("");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEnd);
     MUST_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().end();
@@ -1287,6 +1424,7 @@ SWGLAPI void STDCALL glDrv_glEndList(void) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEndList);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1297,6 +1435,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord1d(GLdouble u) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalCoord1d, u);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1307,6 +1446,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord1dv(const GLdouble *u) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(u, 1, glDrv_glEvalCoord1dv, u);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1317,6 +1457,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord1f(GLfloat u) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalCoord1f, u);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1327,6 +1468,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord1fv(const GLfloat *u) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(u, 1, glDrv_glEvalCoord1fv, u);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1337,6 +1479,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord2d(GLdouble u, GLdouble v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalCoord2d, u, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1347,6 +1490,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord2dv(const GLdouble *u) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(u, 2, glDrv_glEvalCoord2dv, u);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1357,6 +1501,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord2f(GLfloat u, GLfloat v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalCoord2f, u, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1367,6 +1512,7 @@ SWGLAPI void STDCALL glDrv_glEvalCoord2fv(const GLfloat *u) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(u, 2, glDrv_glEvalCoord2fv, u);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1377,6 +1523,7 @@ SWGLAPI void STDCALL glDrv_glEvalMesh1(GLenum mode, GLint i1, GLint i2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalMesh1, mode, i1, i2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1387,6 +1534,7 @@ SWGLAPI void STDCALL glDrv_glEvalMesh2(GLenum mode, GLint i1, GLint i2, GLint j1
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalMesh2, mode, i1, i2, j1, j2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1397,6 +1545,7 @@ SWGLAPI void STDCALL glDrv_glEvalPoint1(GLint i) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalPoint1, i);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1407,6 +1556,7 @@ SWGLAPI void STDCALL glDrv_glEvalPoint2(GLint i, GLint j) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEvalPoint2, i, j);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1417,6 +1567,7 @@ SWGLAPI void STDCALL glDrv_glFeedbackBuffer(GLsizei size, GLenum type, GLfloat *
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glFeedbackBuffer, size, type, buffer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1427,6 +1578,7 @@ SWGLAPI void STDCALL glDrv_glFinish(void) {
     LOG("");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glFinish);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getRenderer().finish();
@@ -1434,12 +1586,13 @@ SWGLAPI void STDCALL glDrv_glFinish(void) {
 
 SWGLAPI void STDCALL glDrv_glFlush(void) {
 
-    LOG("Unimplemented");
+    LOG("");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glFlush);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
-    // ...
+    ctx->getRenderer().flush();
 }
 
 SWGLAPI void STDCALL glDrv_glFogf(GLenum pname, GLfloat param) {
@@ -1447,6 +1600,7 @@ SWGLAPI void STDCALL glDrv_glFogf(GLenum pname, GLfloat param) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glFogf, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1457,6 +1611,7 @@ SWGLAPI void STDCALL glDrv_glFogfv(GLenum pname, const GLfloat *params) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glFogfv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1467,6 +1622,7 @@ SWGLAPI void STDCALL glDrv_glFogi(GLenum pname, GLint param) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glFogi, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1477,6 +1633,7 @@ SWGLAPI void STDCALL glDrv_glFogiv(GLenum pname, const GLint *params) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glFogiv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1487,6 +1644,7 @@ SWGLAPI void STDCALL glDrv_glFrontFace(GLenum mode) {
     LOG("Mode: %04x", mode);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glFrontFace, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (mode) {
@@ -1507,6 +1665,7 @@ SWGLAPI void STDCALL glDrv_glFrustum(GLdouble left, GLdouble right, GLdouble bot
     LOG("Left: %f, Right: %f, Bottom: %f, Top: %f, Near: %f, Far: %f", left, right, bottom, top, zNear, zFar);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glFrustum, left, right, bottom, top, zNear, zFar);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (zNear < 0.0 || zFar < 0.0 || left == right || bottom == top || zNear == zFar) {
@@ -1537,6 +1696,7 @@ SWGLAPI GLuint STDCALL glDrv_glGenLists(GLsizei range) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN(0U);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glGenLists, range);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(0U);
 
     // ...
@@ -1548,6 +1708,7 @@ SWGLAPI void STDCALL glDrv_glGetBooleanv(GLenum pname, GLboolean *params) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetBooleanv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1558,6 +1719,7 @@ SWGLAPI void STDCALL glDrv_glGetClipPlane(GLenum plane, GLdouble *equation) {
     LOG("Plane: %d, Equation Address: %p", plane - GL_CLIP_PLANE0, equation);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetClipPlane, plane, equation);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (equation != nullptr) {
@@ -1593,6 +1755,7 @@ SWGLAPI void STDCALL glDrv_glGetDoublev(GLenum pname, GLdouble *params) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetDoublev, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1601,6 +1764,7 @@ SWGLAPI void STDCALL glDrv_glGetDoublev(GLenum pname, GLdouble *params) {
 SWGLAPI GLenum STDCALL glDrv_glGetError(void) {
 
     GET_CONTEXT_OR_RETURN(GL_INVALID_OPERATION);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glGetError);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_INVALID_OPERATION);
 
     GLenum error = ctx->getError().getState();
@@ -1614,6 +1778,7 @@ SWGLAPI void STDCALL glDrv_glGetFloatv(GLenum pname, GLfloat *params) {
     LOG("Parameter name: %04x, Address: %p", pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetFloatv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -1668,6 +1833,7 @@ SWGLAPI void STDCALL glDrv_glGetIntegerv(GLenum pname, GLint *params) {
     LOG("Param: %04x, Address: %p", pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetIntegerv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -1727,6 +1893,7 @@ SWGLAPI void STDCALL glDrv_glGetLightfv(GLenum light, GLenum pname, GLfloat *par
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetLightfv, light, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1737,6 +1904,7 @@ SWGLAPI void STDCALL glDrv_glGetLightiv(GLenum light, GLenum pname, GLint *param
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetLightiv, light, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1747,6 +1915,7 @@ SWGLAPI void STDCALL glDrv_glGetMapdv(GLenum target, GLenum query, GLdouble *v)
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetMapdv, target, query, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1757,6 +1926,7 @@ SWGLAPI void STDCALL glDrv_glGetMapfv(GLenum target, GLenum query, GLfloat *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetMapfv, target, query, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1767,6 +1937,7 @@ SWGLAPI void STDCALL glDrv_glGetMapiv(GLenum target, GLenum query, GLint *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetMapiv, target, query, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1777,6 +1948,7 @@ SWGLAPI void STDCALL glDrv_glGetMaterialfv(GLenum face, GLenum pname, GLfloat *p
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetMaterialfv, face, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1787,6 +1959,7 @@ SWGLAPI void STDCALL glDrv_glGetMaterialiv(GLenum face, GLenum pname, GLint *par
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetMaterialiv, face, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1797,6 +1970,7 @@ SWGLAPI void STDCALL glDrv_glGetPixelMapfv(GLenum map, GLfloat *values) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetPixelMapfv, map, values);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1807,6 +1981,7 @@ SWGLAPI void STDCALL glDrv_glGetPixelMapuiv(GLenum map, GLuint *values) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetPixelMapuiv, map, values);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1817,6 +1992,7 @@ SWGLAPI void STDCALL glDrv_glGetPixelMapusv(GLenum map, GLushort *values) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetPixelMapusv, map, values);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1827,6 +2003,7 @@ SWGLAPI void STDCALL glDrv_glGetPolygonStipple(GLubyte *mask) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetPolygonStipple, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1837,6 +2014,7 @@ SWGLAPI const GLubyte * STDCALL glDrv_glGetString(GLenum name) {
     LOG("String name: %04x", name);
 
     GET_CONTEXT_OR_RETURN(nullptr);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glGetString, name);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(nullptr);
 
     switch (name) {
@@ -1857,6 +2035,7 @@ SWGLAPI void STDCALL glDrv_glGetTexEnvfv(GLenum target, GLenum pname, GLfloat *p
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexEnvfv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1867,6 +2046,7 @@ SWGLAPI void STDCALL glDrv_glGetTexEnviv(GLenum target, GLenum pname, GLint *par
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexEnviv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1877,6 +2057,7 @@ SWGLAPI void STDCALL glDrv_glGetTexGendv(GLenum coord, GLenum pname, GLdouble *p
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexGendv, coord, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1887,6 +2068,7 @@ SWGLAPI void STDCALL glDrv_glGetTexGenfv(GLenum coord, GLenum pname, GLfloat *pa
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexGenfv, coord, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1897,6 +2079,7 @@ SWGLAPI void STDCALL glDrv_glGetTexGeniv(GLenum coord, GLenum pname, GLint *para
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexGeniv, coord, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1907,6 +2090,7 @@ SWGLAPI void STDCALL glDrv_glGetTexImage(GLenum target, GLint level, GLenum form
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexImage, target, level, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1917,6 +2101,7 @@ SWGLAPI void STDCALL glDrv_glGetTexLevelParameterfv(GLenum target, GLint level,
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexLevelParameterfv, target, level, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1927,6 +2112,7 @@ SWGLAPI void STDCALL glDrv_glGetTexLevelParameteriv(GLenum target, GLint level,
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexLevelParameteriv, target, level, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1937,6 +2123,7 @@ SWGLAPI void STDCALL glDrv_glGetTexParameterfv(GLenum target, GLenum pname, GLfl
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexParameterfv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1947,6 +2134,7 @@ SWGLAPI void STDCALL glDrv_glGetTexParameteriv(GLenum target, GLenum pname, GLin
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetTexParameteriv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1957,6 +2145,7 @@ SWGLAPI void STDCALL glDrv_glHint(GLenum target, GLenum mode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glHint, target, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1967,6 +2156,7 @@ SWGLAPI void STDCALL glDrv_glIndexMask(GLuint mask) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glIndexMask, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -1977,6 +2167,7 @@ SWGLAPI void STDCALL glDrv_glIndexd(GLdouble c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glIndexd, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1987,6 +2178,7 @@ SWGLAPI void STDCALL glDrv_glIndexdv(const GLdouble *c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(c, 1, glDrv_glIndexdv, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -1997,6 +2189,7 @@ SWGLAPI void STDCALL glDrv_glIndexf(GLfloat c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glIndexf, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -2007,6 +2200,7 @@ SWGLAPI void STDCALL glDrv_glIndexfv(const GLfloat *c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(c, 1, glDrv_glIndexfv, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -2017,6 +2211,7 @@ SWGLAPI void STDCALL glDrv_glIndexi(GLint c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glIndexi, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -2027,6 +2222,7 @@ SWGLAPI void STDCALL glDrv_glIndexiv(const GLint *c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(c, 1, glDrv_glIndexiv, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -2037,6 +2233,7 @@ SWGLAPI void STDCALL glDrv_glIndexs(GLshort c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glIndexs, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -2047,6 +2244,7 @@ SWGLAPI void STDCALL glDrv_glIndexsv(const GLshort *c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(c, 1, glDrv_glIndexsv, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -2057,6 +2255,7 @@ SWGLAPI void STDCALL glDrv_glInitNames(void) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glInitNames);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2067,6 +2266,7 @@ SWGLAPI GLboolean STDCALL glDrv_glIsEnabled(GLenum cap) {
     LOG("Capability: %04x", cap);
 
     GET_CONTEXT_OR_RETURN(GL_FALSE);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glIsEnabled, cap);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_FALSE);
 
     bool result = false;
@@ -2101,6 +2301,7 @@ SWGLAPI GLboolean STDCALL glDrv_glIsList(GLuint list) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN(GL_FALSE);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glIsList, list);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_FALSE);
 
     // ...
@@ -2112,6 +2313,7 @@ SWGLAPI void STDCALL glDrv_glLightModelf(GLenum pname, GLfloat param) {
     LOG("Parameter: %04x, Value: %f", pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLightModelf, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &lighting = ctx->getVertexPipeline().getLighting();
@@ -2167,6 +2369,7 @@ SWGLAPI void STDCALL glDrv_glLightModelfv(GLenum pname, const GLfloat *params) {
     LOG("Parameter: %04x, Value Address: %p", pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glLightModelfv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &lighting = ctx->getVertexPipeline().getLighting();
@@ -2225,6 +2428,7 @@ SWGLAPI void STDCALL glDrv_glLightModeli(GLenum pname, GLint param) {
     LOG("Parameter: %04x, Value: %d", pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLightModeli, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     float paramF;
@@ -2259,6 +2463,7 @@ SWGLAPI void STDCALL glDrv_glLightModeliv(GLenum pname, const GLint *params) {
     LOG("Parameter: %04x, Value Address: %p", pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glLightModeliv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -2389,6 +2594,7 @@ SWGLAPI void STDCALL glDrv_glLightf(GLenum light, GLenum pname, GLfloat param) {
     LOG("Light: %d, Parameter: %04x, Value: %f", light - GL_LIGHT0, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLightf, light, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto lightIdx = light - GL_LIGHT0;
@@ -2412,6 +2618,7 @@ SWGLAPI void STDCALL glDrv_glLightfv(GLenum light, GLenum pname, const GLfloat *
     LOG("Light: %d, Parameter: %04x, Value Address: %p", light - GL_LIGHT0, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glLightfv, light, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -2444,6 +2651,7 @@ SWGLAPI void STDCALL glDrv_glLighti(GLenum light, GLenum pname, GLint param) {
     LOG("Light: %d, Parameter: %04x, Value: %d", light - GL_LIGHT0, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLighti, light, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto lightIdx = light - GL_LIGHT0;
@@ -2467,6 +2675,7 @@ SWGLAPI void STDCALL glDrv_glLightiv(GLenum light, GLenum pname, const GLint *pa
     LOG("Light: %d, Parameter: %04x, Value Address: %p", light - GL_LIGHT0, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glLightiv, light, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -2499,6 +2708,7 @@ SWGLAPI void STDCALL glDrv_glLineStipple(GLint factor, GLushort pattern) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLineStipple, factor, pattern);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2509,6 +2719,7 @@ SWGLAPI void STDCALL glDrv_glLineWidth(GLfloat width) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLineWidth, width);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2519,6 +2730,7 @@ SWGLAPI void STDCALL glDrv_glListBase(GLuint base) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glListBase, base);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2529,6 +2741,7 @@ SWGLAPI void STDCALL glDrv_glLoadIdentity(void) {
     LOG("");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLoadIdentity);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -2541,6 +2754,7 @@ SWGLAPI void STDCALL glDrv_glLoadMatrixd(const GLdouble *m) {
     LOG("Address: %p", m);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glLoadMatrixd, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (m != nullptr) {
@@ -2559,6 +2773,7 @@ SWGLAPI void STDCALL glDrv_glLoadMatrixf(const GLfloat *m) {
     LOG("Address: %p", m);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(m, 16, glDrv_glLoadMatrixf, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (m != nullptr) {
@@ -2577,6 +2792,7 @@ SWGLAPI void STDCALL glDrv_glLoadName(GLuint name) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLoadName, name);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2587,6 +2803,7 @@ SWGLAPI void STDCALL glDrv_glLogicOp(GLenum opcode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLogicOp, opcode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2597,6 +2814,7 @@ SWGLAPI void STDCALL glDrv_glMap1d(GLenum target, GLdouble u1, GLdouble u2, GLin
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMap1d, target, u1, u2, stride, order, points);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2607,6 +2825,7 @@ SWGLAPI void STDCALL glDrv_glMap1f(GLenum target, GLfloat u1, GLfloat u2, GLint
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMap1f, target, u1, u2, stride, order, points);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2617,6 +2836,7 @@ SWGLAPI void STDCALL glDrv_glMap2d(GLenum target, GLdouble u1, GLdouble u2, GLin
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMap2d, target, u1, u2, ustride, uorder, v1, v2, vstride, vorder, points);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2627,6 +2847,7 @@ SWGLAPI void STDCALL glDrv_glMap2f(GLenum target, GLfloat u1, GLfloat u2, GLint
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMap2f, target, u1, u2, ustride, uorder, v1, v2, vstride, vorder, points);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2637,6 +2858,7 @@ SWGLAPI void STDCALL glDrv_glMapGrid1d(GLint un, GLdouble u1, GLdouble u2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMapGrid1d, un, u1, u2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2647,6 +2869,7 @@ SWGLAPI void STDCALL glDrv_glMapGrid1f(GLint un, GLfloat u1, GLfloat u2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMapGrid1f, un, u1, u2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2657,6 +2880,7 @@ SWGLAPI void STDCALL glDrv_glMapGrid2d(GLint un, GLdouble u1, GLdouble u2, GLint
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMapGrid2d, un, u1, u2, vn, v1, v2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2667,6 +2891,7 @@ SWGLAPI void STDCALL glDrv_glMapGrid2f(GLint un, GLfloat u1, GLfloat u2, GLint v
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMapGrid2f, un, u1, u2, vn, v1, v2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2717,6 +2942,7 @@ SWGLAPI void STDCALL glDrv_glMaterialf(GLenum face, GLenum pname, GLfloat param)
     LOG("Face: %04x, Parameter: %04x, Value: %f", face, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMaterialf, face, pname, param);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     bool isFront = face == GL_FRONT || face == GL_FRONT_AND_BACK;
@@ -2754,6 +2980,7 @@ SWGLAPI void STDCALL glDrv_glMaterialfv(GLenum face, GLenum pname, const GLfloat
     LOG("Face: %04x, Parameter: %04x, Value Address: %p", face, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMaterialfv, face, pname, params);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -2794,6 +3021,7 @@ SWGLAPI void STDCALL glDrv_glMateriali(GLenum face, GLenum pname, GLint param) {
     LOG("Face: %04x, Parameter: %04x, Value: %d", face, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMateriali, face, pname, param);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     bool isFront = face == GL_FRONT || face == GL_FRONT_AND_BACK;
@@ -2833,6 +3061,7 @@ SWGLAPI void STDCALL glDrv_glMaterialiv(GLenum face, GLenum pname, const GLint *
     LOG("Face: %04x, Parameter: %04x, Value Address: %p", face, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMaterialiv, face, pname, params);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -2879,6 +3108,7 @@ SWGLAPI void STDCALL glDrv_glMatrixMode(GLenum mode) {
     LOG("Mode: %04x", mode);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMatrixMode, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (mode) {
@@ -2901,6 +3131,7 @@ SWGLAPI void STDCALL glDrv_glMultMatrixd(const GLdouble *m) {
     LOG("Matrix data address: %p", m);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMultMatrixd, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (m != nullptr) {
@@ -2920,6 +3151,7 @@ SWGLAPI void STDCALL glDrv_glMultMatrixf(const GLfloat *m) {
     LOG("Matrix data address: %p", m);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(m, 16, glDrv_glMultMatrixf, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (m != nullptr) {
@@ -2939,6 +3171,7 @@ SWGLAPI void STDCALL glDrv_glNewList(GLuint list, GLenum mode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glNewList, list, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -2949,6 +3182,7 @@ SWGLAPI void STDCALL glDrv_glNormal3b(GLbyte nx, GLbyte ny, GLbyte nz) {
     LOG("X: %d, Y: %d, Z: %d", nx, ny, nz);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glNormal3b, nx, ny, nz);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setNormal(
@@ -2968,6 +3202,7 @@ SWGLAPI void STDCALL glDrv_glNormal3bv(const GLbyte *v) {
     LOG("X: %d, Y: %d, Z: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glNormal3bv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -2990,6 +3225,7 @@ SWGLAPI void STDCALL glDrv_glNormal3d(GLdouble nx, GLdouble ny, GLdouble nz) {
     LOG("X: %f, Y: %f, Z: %f", nx, ny, nz);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glNormal3d, nx, ny, nz);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setNormal(
@@ -3009,6 +3245,7 @@ SWGLAPI void STDCALL glDrv_glNormal3dv(const GLdouble *v) {
     LOG("X: %f, Y: %f, Z: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glNormal3dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -3031,6 +3268,7 @@ SWGLAPI void STDCALL glDrv_glNormal3f(GLfloat nx, GLfloat ny, GLfloat nz) {
     LOG("X: %f, Y: %f, Z: %f", nx, ny, nz);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glNormal3f, nx, ny, nz);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setNormal(
@@ -3044,6 +3282,7 @@ SWGLAPI void STDCALL glDrv_glNormal3fv(const GLfloat *v) {
     LOG("X: %f, Y: %f, Z: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glNormal3fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -3060,6 +3299,7 @@ SWGLAPI void STDCALL glDrv_glNormal3i(GLint nx, GLint ny, GLint nz) {
     LOG("X: %d, Y: %d, Z: %d", nx, ny, nz);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glNormal3i, nx, ny, nz);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setNormal(
@@ -3079,6 +3319,7 @@ SWGLAPI void STDCALL glDrv_glNormal3iv(const GLint *v) {
     LOG("X: %d, Y: %d, Z: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glNormal3iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -3101,6 +3342,7 @@ SWGLAPI void STDCALL glDrv_glNormal3s(GLshort nx, GLshort ny, GLshort nz) {
     LOG("X: %d, Y: %d, Z: %d", nx, ny, nz);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glNormal3s, nx, ny, nz);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setNormal(
@@ -3120,6 +3362,7 @@ SWGLAPI void STDCALL glDrv_glNormal3sv(const GLshort *v) {
     LOG("X: %d, Y: %d, Z: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glNormal3sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -3142,6 +3385,7 @@ SWGLAPI void STDCALL glDrv_glOrtho(GLdouble left, GLdouble right, GLdouble botto
     LOG("Left: %f, Right: %f, Bottom: %f, Top: %f, Near: %f, Far: %f", left, right, bottom, top, zNear, zFar);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glOrtho, left, right, bottom, top, zNear, zFar);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -3166,6 +3410,7 @@ SWGLAPI void STDCALL glDrv_glPassThrough(GLfloat token) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPassThrough, token);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3176,6 +3421,7 @@ SWGLAPI void STDCALL glDrv_glPixelMapfv(GLenum map, GLsizei mapsize, const GLflo
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glPixelMapfv, map, mapsize, values);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3186,6 +3432,7 @@ SWGLAPI void STDCALL glDrv_glPixelMapuiv(GLenum map, GLsizei mapsize, const GLui
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glPixelMapuiv, map, mapsize, values);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3196,6 +3443,7 @@ SWGLAPI void STDCALL glDrv_glPixelMapusv(GLenum map, GLsizei mapsize, const GLus
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glPixelMapusv, map, mapsize, values);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3206,6 +3454,7 @@ SWGLAPI void STDCALL glDrv_glPixelStoref(GLenum pname, GLfloat param) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPixelStoref, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3216,6 +3465,7 @@ SWGLAPI void STDCALL glDrv_glPixelStorei(GLenum pname, GLint param) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPixelStorei, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3226,6 +3476,7 @@ SWGLAPI void STDCALL glDrv_glPixelTransferf(GLenum pname, GLfloat param) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPixelTransferf, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3236,6 +3487,7 @@ SWGLAPI void STDCALL glDrv_glPixelTransferi(GLenum pname, GLint param) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPixelTransferi, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3246,6 +3498,7 @@ SWGLAPI void STDCALL glDrv_glPixelZoom(GLfloat xfactor, GLfloat yfactor) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPixelZoom, xfactor, yfactor);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3256,6 +3509,7 @@ SWGLAPI void STDCALL glDrv_glPointSize(GLfloat size) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPointSize, size);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3266,6 +3520,7 @@ SWGLAPI void STDCALL glDrv_glPolygonMode(GLenum face, GLenum mode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPolygonMode, face, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3276,6 +3531,7 @@ SWGLAPI void STDCALL glDrv_glPolygonStipple(const GLubyte *mask) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glPolygonStipple, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3286,6 +3542,7 @@ SWGLAPI void STDCALL glDrv_glPopAttrib(void) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPopAttrib);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3296,6 +3553,7 @@ SWGLAPI void STDCALL glDrv_glPopMatrix(void) {
     LOG("");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPopMatrix);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -3311,6 +3569,7 @@ SWGLAPI void STDCALL glDrv_glPopName(void) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPopName);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3321,6 +3580,7 @@ SWGLAPI void STDCALL glDrv_glPushAttrib(GLbitfield mask) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPushAttrib, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3331,6 +3591,7 @@ SWGLAPI void STDCALL glDrv_glPushMatrix(void) {
     LOG("");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPushMatrix);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -3346,6 +3607,7 @@ SWGLAPI void STDCALL glDrv_glPushName(GLuint name) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPushName, name);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3356,6 +3618,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2d(GLdouble x, GLdouble y) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos2d, x, y);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3366,6 +3629,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2dv(const GLdouble *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glRasterPos2dv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3376,6 +3640,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2f(GLfloat x, GLfloat y) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos2f, x, y);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3386,6 +3651,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2fv(const GLfloat *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glRasterPos2fv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3396,6 +3662,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2i(GLint x, GLint y) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos2i, x, y);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3406,6 +3673,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2iv(const GLint *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glRasterPos2iv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3416,6 +3684,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2s(GLshort x, GLshort y) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos2s, x, y);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3426,6 +3695,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos2sv(const GLshort *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glRasterPos2sv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3436,6 +3706,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3d(GLdouble x, GLdouble y, GLdouble z) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos3d, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3446,6 +3717,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3dv(const GLdouble *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glRasterPos3dv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3456,6 +3728,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3f(GLfloat x, GLfloat y, GLfloat z) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos3f, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3466,6 +3739,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3fv(const GLfloat *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glRasterPos3fv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3476,6 +3750,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3i(GLint x, GLint y, GLint z) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos3i, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3486,6 +3761,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3iv(const GLint *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glRasterPos3iv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3496,6 +3772,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3s(GLshort x, GLshort y, GLshort z) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos3s, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3506,6 +3783,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos3sv(const GLshort *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glRasterPos3sv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3516,6 +3794,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4d(GLdouble x, GLdouble y, GLdouble z, GLd
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos4d, x, y, z, w);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3526,6 +3805,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4dv(const GLdouble *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glRasterPos4dv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3536,6 +3816,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4f(GLfloat x, GLfloat y, GLfloat z, GLfloa
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos4f, x, y, z, w);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3546,6 +3827,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4fv(const GLfloat *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glRasterPos4fv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3556,6 +3838,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4i(GLint x, GLint y, GLint z, GLint w) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos4i, x, y, z, w);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3566,6 +3849,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4iv(const GLint *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glRasterPos4iv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3576,6 +3860,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4s(GLshort x, GLshort y, GLshort z, GLshor
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRasterPos4s, x, y, z, w);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3586,6 +3871,7 @@ SWGLAPI void STDCALL glDrv_glRasterPos4sv(const GLshort *v) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glRasterPos4sv, v);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3596,6 +3882,7 @@ SWGLAPI void STDCALL glDrv_glReadBuffer(GLenum mode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glReadBuffer, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3606,6 +3893,7 @@ SWGLAPI void STDCALL glDrv_glReadPixels(GLint x, GLint y, GLsizei width, GLsizei
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glReadPixels, x, y, width, height, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3616,6 +3904,7 @@ SWGLAPI void STDCALL glDrv_glRectd(GLdouble x1, GLdouble y1, GLdouble x2, GLdoub
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRectd, x1, y1, x2, y2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3626,6 +3915,7 @@ SWGLAPI void STDCALL glDrv_glRectdv(const GLdouble *v1, const GLdouble *v2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glRectdv, v1, v2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3636,6 +3926,7 @@ SWGLAPI void STDCALL glDrv_glRectf(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRectf, x1, y1, x2, y2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3646,6 +3937,7 @@ SWGLAPI void STDCALL glDrv_glRectfv(const GLfloat *v1, const GLfloat *v2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glRectfv, v1, v2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3656,6 +3948,7 @@ SWGLAPI void STDCALL glDrv_glRecti(GLint x1, GLint y1, GLint x2, GLint y2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRecti, x1, y1, x2, y2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3666,6 +3959,7 @@ SWGLAPI void STDCALL glDrv_glRectiv(const GLint *v1, const GLint *v2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glRectiv, v1, v2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3676,6 +3970,7 @@ SWGLAPI void STDCALL glDrv_glRects(GLshort x1, GLshort y1, GLshort x2, GLshort y
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRects, x1, y1, x2, y2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3686,6 +3981,7 @@ SWGLAPI void STDCALL glDrv_glRectsv(const GLshort *v1, const GLshort *v2) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glRectsv, v1, v2);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3696,6 +3992,7 @@ SWGLAPI GLint STDCALL glDrv_glRenderMode(GLenum mode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN(0);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glRenderMode, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(0);
 
     // ...
@@ -3707,6 +4004,7 @@ SWGLAPI void STDCALL glDrv_glRotated(GLdouble angle, GLdouble x, GLdouble y, GLd
     LOG("Angle: %f, Axis: (%f, %f, %f)", angle, x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRotated, angle, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -3729,6 +4027,7 @@ SWGLAPI void STDCALL glDrv_glRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloa
     LOG("Angle: %f, Axis: (%f, %f, %f)", angle, x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glRotatef, angle, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -3751,6 +4050,7 @@ SWGLAPI void STDCALL glDrv_glScaled(GLdouble x, GLdouble y, GLdouble z) {
     LOG("Axis: (%f, %f, %f)", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glScaled, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -3772,6 +4072,7 @@ SWGLAPI void STDCALL glDrv_glScalef(GLfloat x, GLfloat y, GLfloat z) {
     LOG("Axis: (%f, %f, %f)", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glScalef, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -3788,6 +4089,7 @@ SWGLAPI void STDCALL glDrv_glScissor(GLint x, GLint y, GLsizei width, GLsizei he
     LOG("X: %d, Y: %d, Width: %d, Height: %d", x, y, width, height);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glScissor, x, y, width, height);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (width < 0 || height < 0) {
@@ -3797,6 +4099,7 @@ SWGLAPI void STDCALL glDrv_glScissor(GLint x, GLint y, GLsizei width, GLsizei he
     }
 
     ctx->getScissor().setDimensions(x, y, width, height);
+    ctx->getRenderer().invalidateDrawState();
 }
 
 SWGLAPI void STDCALL glDrv_glSelectBuffer(GLsizei size, GLuint *buffer) {
@@ -3804,6 +4107,7 @@ SWGLAPI void STDCALL glDrv_glSelectBuffer(GLsizei size, GLuint *buffer) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glSelectBuffer, size, buffer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3814,6 +4118,7 @@ SWGLAPI void STDCALL glDrv_glShadeModel(GLenum mode) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glShadeModel, mode);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3824,6 +4129,7 @@ SWGLAPI void STDCALL glDrv_glStencilFunc(GLenum func, GLint ref, GLuint mask) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glStencilFunc, func, ref, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3834,6 +4140,7 @@ SWGLAPI void STDCALL glDrv_glStencilMask(GLuint mask) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glStencilMask, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3844,6 +4151,7 @@ SWGLAPI void STDCALL glDrv_glStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glStencilOp, fail, zfail, zpass);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -3854,6 +4162,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1d(GLdouble s) {
     LOG("S: %f", s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord1d, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -3874,6 +4183,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1dv(const GLdouble *v) {
     LOG("S: %f", v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glTexCoord1dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -3897,6 +4207,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1f(GLfloat s) {
     LOG("S: %f", s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord1f, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -3911,6 +4222,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1fv(const GLfloat *v) {
     LOG("S: %f", v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glTexCoord1fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -3928,6 +4240,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1i(GLint s) {
     LOG("S: %d", s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord1i, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -3948,6 +4261,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1iv(const GLint *v) {
     LOG("S: %d", v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glTexCoord1iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -3971,6 +4285,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1s(GLshort s) {
     LOG("S: %d", s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord1s, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -3991,6 +4306,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord1sv(const GLshort *v) {
     LOG("S: %d", v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glTexCoord1sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4014,6 +4330,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2d(GLdouble s, GLdouble t) {
     LOG("S: %f, T: %f", s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord2d, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4034,6 +4351,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2dv(const GLdouble *v) {
     LOG("S: %f, T: %f", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glTexCoord2dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4057,6 +4375,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2f(GLfloat s, GLfloat t) {
     LOG("S: %f, T: %f", s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord2f, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4071,6 +4390,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2fv(const GLfloat *v) {
     LOG("S: %f, T: %f", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glTexCoord2fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4088,6 +4408,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2i(GLint s, GLint t) {
     LOG("S: %d, T: %d", s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord2i, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4108,6 +4429,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2iv(const GLint *v) {
     LOG("S: %d, T: %d", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glTexCoord2iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4131,6 +4453,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2s(GLshort s, GLshort t) {
     LOG("S: %d, T: %d", s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord2s, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4151,6 +4474,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord2sv(const GLshort *v) {
     LOG("S: %d, T: %d", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glTexCoord2sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4174,6 +4498,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3d(GLdouble s, GLdouble t, GLdouble r) {
     LOG("S: %f, T: %f, R: %f", s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord3d, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4194,6 +4519,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3dv(const GLdouble *v) {
     LOG("S: %f, T: %f, R: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glTexCoord3dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4217,6 +4543,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3f(GLfloat s, GLfloat t, GLfloat r) {
     LOG("S: %f, T: %f, R: %f", s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord3f, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4231,6 +4558,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3fv(const GLfloat *v) {
     LOG("S: %f, T: %f, R: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glTexCoord3fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4248,6 +4576,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3i(GLint s, GLint t, GLint r) {
     LOG("S: %d, T: %d, R: %d", s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord3i, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4268,6 +4597,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3iv(const GLint *v) {
     LOG("S: %d, T: %d, R: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glTexCoord3iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4291,6 +4621,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3s(GLshort s, GLshort t, GLshort r) {
     LOG("S: %d, T: %d, R: %d", s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord3s, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4311,6 +4642,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord3sv(const GLshort *v) {
     LOG("S: %d, T: %d, R: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glTexCoord3sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4334,6 +4666,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4d(GLdouble s, GLdouble t, GLdouble r, GLdo
     LOG("S: %f, T: %f, R: %f, Q: %f", s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord4d, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4354,6 +4687,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4dv(const GLdouble *v) {
     LOG("S: %f, T: %f, R: %f, Q: %f", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glTexCoord4dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4377,6 +4711,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4f(GLfloat s, GLfloat t, GLfloat r, GLfloat
     LOG("S: %f, T: %f, R: %f, Q: %f", s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord4f, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4391,6 +4726,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4fv(const GLfloat *v) {
     LOG("S: %f, T: %f, R: %f, Q: %f", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glTexCoord4fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4408,6 +4744,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4i(GLint s, GLint t, GLint r, GLint q) {
     LOG("S: %d, T: %d, R: %d, Q: %d", s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord4i, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4428,6 +4765,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4iv(const GLint *v) {
     LOG("S: %d, T: %d, R: %d, Q: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glTexCoord4iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4451,6 +4789,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4s(GLshort s, GLshort t, GLshort r, GLshort
     LOG("S: %d, T: %d, R: %d, Q: %d", s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoord4s, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().setTexCoord(
@@ -4471,6 +4810,7 @@ SWGLAPI void STDCALL glDrv_glTexCoord4sv(const GLshort *v) {
     LOG("S: %d, T: %d, R: %d, Q: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glTexCoord4sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -4679,6 +5019,7 @@ SWGLAPI void STDCALL glDrv_glTexEnvf(GLenum target, GLenum pname, GLfloat param)
     LOG("Target: %04x, Parameter: %04x, Data: %f", target, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexEnvf, target, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (target != GL_TEXTURE_ENV) {
@@ -4748,6 +5089,7 @@ SWGLAPI void STDCALL glDrv_glTexEnvfv(GLenum target, GLenum pname, const GLfloat
     LOG("Target: %04x, Parameter: %04x, Data Address: %p", target, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexEnvfv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (target != GL_TEXTURE_ENV) {
@@ -4820,6 +5162,7 @@ SWGLAPI void STDCALL glDrv_glTexEnvi(GLenum target, GLenum pname, GLint param) {
     LOG("Target: %04x, Parameter: %04x, Data: %d", target, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexEnvi, target, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (target != GL_TEXTURE_ENV) {
@@ -4896,6 +5239,7 @@ SWGLAPI void STDCALL glDrv_glTexEnviv(GLenum target, GLenum pname, const GLint *
     LOG("Target: %04x, Parameter: %04x, Data Address: %p", target, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexEnviv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (target != GL_TEXTURE_ENV) {
@@ -5059,6 +5403,7 @@ SWGLAPI void STDCALL glDrv_glTexGend(GLenum coord, GLenum pname, GLdouble param)
     LOG("Coord: %04x, Parameter: %04x, Value: %f", coord, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexGend, coord, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (pname != GL_TEXTURE_GEN_MODE) {
@@ -5076,6 +5421,7 @@ SWGLAPI void STDCALL glDrv_glTexGendv(GLenum coord, GLenum pname, const GLdouble
     LOG("Coord: %04x, Parameter: %04x, Value Address: %p", coord, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexGendv, coord, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -5128,6 +5474,7 @@ SWGLAPI void STDCALL glDrv_glTexGenf(GLenum coord, GLenum pname, GLfloat param)
     LOG("Coord: %04x, Parameter: %04x, Value: %f", coord, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexGenf, coord, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (pname != GL_TEXTURE_GEN_MODE) {
@@ -5145,6 +5492,7 @@ SWGLAPI void STDCALL glDrv_glTexGenfv(GLenum coord, GLenum pname, const GLfloat
     LOG("Coord: %04x, Parameter: %04x, Addr: %p", coord, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexGenfv, coord, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -5197,6 +5545,7 @@ SWGLAPI void STDCALL glDrv_glTexGeni(GLenum coord, GLenum pname, GLint param) {
     LOG("Coord: %04x, Parameter: %04x, Value: %04x", coord, pname, param);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexGeni, coord, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (pname != GL_TEXTURE_GEN_MODE) {
@@ -5214,6 +5563,7 @@ SWGLAPI void STDCALL glDrv_glTexGeniv(GLenum coord, GLenum pname, const GLint *p
     LOG("Coord: %04x, Parameter: %04x, Value Address: %p", coord, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexGeniv, coord, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -5266,6 +5616,7 @@ SWGLAPI void STDCALL glDrv_glTexImage1D(GLenum target, GLint level, GLint intern
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexImage1D, target, level, internalFormat, width, border, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -5276,6 +5627,7 @@ SWGLAPI void STDCALL glDrv_glTexImage2D(GLenum target, GLint level, GLint intern
     LOG("Target: %04x, Level: %d, InternalFormat: %04x, Dimensions: %d x %d pixels, Border: %d, Format: %04x, Type: %04x, Address: %p", target, level, internalFormat, width, height, border, format, type, pixels);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexImage2D, target, level, internalFormat, width, height, border, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (level < 0 || level > static_cast<GLint>(SWGL_MAX_TEXTURE_LOD)) {
@@ -5342,6 +5694,7 @@ SWGLAPI void STDCALL glDrv_glTexImage2D(GLenum target, GLint level, GLint intern
 SWGLAPI void STDCALL glDrv_glTexParameterCommon(GLenum target, GLenum pname, GLenum param) {
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexParameterCommon, target, pname, param);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (target) {
@@ -5505,6 +5858,7 @@ SWGLAPI void STDCALL glDrv_glTexParameterfv(GLenum target, GLenum pname, const G
     LOG("Target: %04x, Parameter: %04x, Data Address: %p", target, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexParameterfv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -5532,6 +5886,7 @@ SWGLAPI void STDCALL glDrv_glTexParameteriv(GLenum target, GLenum pname, const G
     LOG("Target: %04x, Parameter: %04x, Data Address: %p", target, pname, params);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexParameteriv, target, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (params != nullptr) {
@@ -5552,6 +5907,7 @@ SWGLAPI void STDCALL glDrv_glTranslated(GLdouble x, GLdouble y, GLdouble z) {
     LOG("Vector: (%f, %f, %f)", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTranslated, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -5573,6 +5929,7 @@ SWGLAPI void STDCALL glDrv_glTranslatef(GLfloat x, GLfloat y, GLfloat z) {
     LOG("Vector: (%f, %f, %f)", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTranslatef, x, y, z);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto &stack = ctx->getVertexPipeline().getMatrixStack();
@@ -5589,6 +5946,7 @@ SWGLAPI void STDCALL glDrv_glVertex2d(GLdouble x, GLdouble y) {
     LOG("X: %f, Y: %f", x, y);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex2d, x, y);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5610,6 +5968,7 @@ SWGLAPI void STDCALL glDrv_glVertex2dv(const GLdouble *v) {
     LOG("X: %f, Y: %f", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glVertex2dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5634,6 +5993,7 @@ SWGLAPI void STDCALL glDrv_glVertex2f(GLfloat x, GLfloat y) {
     LOG("X: %f, Y: %f", x, y);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex2f, x, y);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5649,6 +6009,7 @@ SWGLAPI void STDCALL glDrv_glVertex2fv(const GLfloat *v) {
     LOG("X: %f, Y: %f", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glVertex2fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5667,6 +6028,7 @@ SWGLAPI void STDCALL glDrv_glVertex2i(GLint x, GLint y) {
     LOG("X: %d, Y: %d", x, y);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex2i, x, y);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5688,6 +6050,7 @@ SWGLAPI void STDCALL glDrv_glVertex2iv(const GLint *v) {
     LOG("X: %d, Y: %d", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glVertex2iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5711,6 +6074,7 @@ SWGLAPI void STDCALL glDrv_glVertex2s(GLshort x, GLshort y) {
     LOG("X: %d, Y: %d", x, y);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex2s, x, y);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5732,6 +6096,7 @@ SWGLAPI void STDCALL glDrv_glVertex2sv(const GLshort *v) {
     LOG("X: %d, Y: %d", v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glVertex2sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5756,6 +6121,7 @@ SWGLAPI void STDCALL glDrv_glVertex3d(GLdouble x, GLdouble y, GLdouble z) {
     LOG("X: %f, Y: %f, Z: %f", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex3d, x, y, z);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5777,6 +6143,7 @@ SWGLAPI void STDCALL glDrv_glVertex3dv(const GLdouble *v) {
     LOG("X: %f, Y: %f, Z: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glVertex3dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5801,6 +6168,7 @@ SWGLAPI void STDCALL glDrv_glVertex3f(GLfloat x, GLfloat y, GLfloat z) {
     LOG("X: %f, Y: %f, Z: %f", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex3f, x, y, z);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5816,6 +6184,7 @@ SWGLAPI void STDCALL glDrv_glVertex3fv(const GLfloat *v) {
     LOG("X: %f, Y: %f, Z: %f", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glVertex3fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5834,6 +6203,7 @@ SWGLAPI void STDCALL glDrv_glVertex3i(GLint x, GLint y, GLint z) {
     LOG("X: %d, Y: %d, Z: %d", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex3i, x, y, z);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5855,6 +6225,7 @@ SWGLAPI void STDCALL glDrv_glVertex3iv(const GLint *v) {
     LOG("X: %d, Y: %d, Z: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glVertex3iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5879,6 +6250,7 @@ SWGLAPI void STDCALL glDrv_glVertex3s(GLshort x, GLshort y, GLshort z) {
     LOG("X: %d, Y: %d, Z: %d", x, y, z);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex3s, x, y, z);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5900,6 +6272,7 @@ SWGLAPI void STDCALL glDrv_glVertex3sv(const GLshort *v) {
     LOG("X: %d, Y: %d, Z: %d", v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glVertex3sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5924,6 +6297,7 @@ SWGLAPI void STDCALL glDrv_glVertex4d(GLdouble x, GLdouble y, GLdouble z, GLdoub
     LOG("X: %f, Y: %f, Z: %f, W: %f", x, y, z, w);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex4d, x, y, z, w);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5945,6 +6319,7 @@ SWGLAPI void STDCALL glDrv_glVertex4dv(const GLdouble *v) {
     LOG("X: %f, Y: %f, Z: %f, W: %f", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glVertex4dv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -5969,6 +6344,7 @@ SWGLAPI void STDCALL glDrv_glVertex4f(GLfloat x, GLfloat y, GLfloat z, GLfloat w
     LOG("X: %f, Y: %f, Z: %f, W: %f", x, y, z, w);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex4f, x, y, z, w);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -5984,6 +6360,7 @@ SWGLAPI void STDCALL glDrv_glVertex4fv(const GLfloat *v) {
     LOG("X: %f, Y: %f, Z: %f, W: %f", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glVertex4fv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -6002,6 +6379,7 @@ SWGLAPI void STDCALL glDrv_glVertex4i(GLint x, GLint y, GLint z, GLint w) {
     LOG("X: %d, Y: %d, Z: %d, W: %d", x, y, z, w);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex4i, x, y, z, w);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -6023,6 +6401,7 @@ SWGLAPI void STDCALL glDrv_glVertex4iv(const GLint *v) {
     LOG("X: %d, Y: %d, Z: %d, W: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glVertex4iv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -6047,6 +6426,7 @@ SWGLAPI void STDCALL glDrv_glVertex4s(GLshort x, GLshort y, GLshort z, GLshort w
     LOG("X: %d, Y: %d, Z: %d, W: %d", x, y, z, w);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertex4s, x, y, z, w);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto &vp = ctx->getVertexPipeline();
@@ -6068,6 +6448,7 @@ SWGLAPI void STDCALL glDrv_glVertex4sv(const GLshort *v) {
     LOG("X: %d, Y: %d, Z: %d, W: %d", v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glVertex4sv, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (v != nullptr) {
@@ -6092,6 +6473,7 @@ SWGLAPI void STDCALL glDrv_glViewport(GLint x, GLint y, GLsizei width, GLsizei h
     LOG("X: %d, Y: %d, Width: %d, Height: %d", x, y, width, height);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glViewport, x, y, width, height);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().getViewport().setDimensions(
@@ -6108,6 +6490,7 @@ SWGLAPI GLboolean STDCALL glDrv_glAreTexturesResident(GLsizei n, const GLuint *t
     LOG("Number of textures: %d, Texture name data: %p, Residences data: %p", n, textures, residences);
 
     GET_CONTEXT_OR_RETURN(GL_FALSE);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glAreTexturesResident, n, textures, residences);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_FALSE);
 
     if (n < 0) {
@@ -6136,6 +6519,7 @@ SWGLAPI void STDCALL glDrv_glArrayElement(GLint i) {
     LOG("Element: %d", i);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glArrayElement, i);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     if (i < 0) {
@@ -6152,6 +6536,7 @@ SWGLAPI void STDCALL glDrv_glBindTexture(GLenum target, GLuint texture) {
     LOG("Target: %04x, Texture: %d", target, texture);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glBindTexture, target, texture);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (target) {
@@ -6182,6 +6567,7 @@ SWGLAPI void STDCALL glDrv_glColorPointer(GLint size, GLenum type, GLsizei strid
     LOG("Size: %d, Type: %04x, Stride: %d byte, Address: %p", size, type, stride, pointer);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glColorPointer, size, type, stride, pointer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().getVertexDataArray().setSourcePointer(
@@ -6199,6 +6585,7 @@ SWGLAPI void STDCALL glDrv_glCopyTexImage1D(GLenum target, GLint level, GLenum i
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCopyTexImage1D, target, level, internalFormat, x, y, width, border);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6209,6 +6596,7 @@ SWGLAPI void STDCALL glDrv_glCopyTexImage2D(GLenum target, GLint level, GLenum i
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCopyTexImage2D, target, level, internalFormat, x, y, width, height, border);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6219,6 +6607,7 @@ SWGLAPI void STDCALL glDrv_glCopyTexSubImage1D(GLenum target, GLint level, GLint
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCopyTexSubImage1D, target, level, xoffset, x, y, width);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6229,6 +6618,7 @@ SWGLAPI void STDCALL glDrv_glCopyTexSubImage2D(GLenum target, GLint level, GLint
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCopyTexSubImage2D, target, level, xoffset, yoffset, x, y, width, height);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6239,6 +6629,7 @@ SWGLAPI void STDCALL glDrv_glDeleteTextures(GLsizei n, const GLuint *textures) {
     LOG("Number of textures: %d, List Address: %p", n, textures);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glDeleteTextures, n, textures);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (textures != nullptr) {
@@ -6266,6 +6657,7 @@ SWGLAPI void STDCALL glDrv_glDisableClientState(GLenum cap) {
     LOG("Capability: %04x", cap);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDisableClientState, cap);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (cap) {
@@ -6288,6 +6680,7 @@ SWGLAPI void STDCALL glDrv_glDrawArrays(GLenum mode, GLint first, GLsizei count)
     LOG("Mode: %04x, First: %d, Count: %d", mode, first, count);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glDrawArrays, mode, first, count);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // Check mode
@@ -6330,6 +6723,7 @@ SWGLAPI void STDCALL glDrv_glDrawElements(GLenum mode, GLsizei count, GLenum typ
     LOG("Mode: %04x, Count: %d, Type: %04x, Indices Address: %p", mode, count, type, indices);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glDrawElements, mode, count, type, indices);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (indices != nullptr) {
@@ -6388,6 +6782,7 @@ SWGLAPI void STDCALL glDrv_glEdgeFlagPointer(GLsizei stride, const GLvoid *point
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEdgeFlagPointer, stride, pointer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6398,6 +6793,7 @@ SWGLAPI void STDCALL glDrv_glEnableClientState(GLenum cap) {
     LOG("Capability: %04x", cap);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glEnableClientState, cap);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     switch (cap) {
@@ -6420,6 +6816,7 @@ SWGLAPI void STDCALL glDrv_glGenTextures(GLsizei n, GLuint *textures) {
     LOG("Number of textures: %d, Address: %p", n, textures);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGenTextures, n, textures);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (textures != nullptr) {
@@ -6439,6 +6836,7 @@ SWGLAPI void STDCALL glDrv_glGetPointerv(GLenum pname, GLvoid **params) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetPointerv, pname, params);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6449,6 +6847,7 @@ SWGLAPI GLboolean STDCALL glDrv_glIsTexture(GLuint texture) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN(GL_FALSE);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glIsTexture, texture);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_FALSE);
 
     // ...
@@ -6460,6 +6859,7 @@ SWGLAPI void STDCALL glDrv_glIndexPointer(GLenum type, GLsizei stride, const GLv
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glIndexPointer, type, stride, pointer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6470,6 +6870,7 @@ SWGLAPI void STDCALL glDrv_glIndexub(GLubyte c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glIndexub, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -6480,6 +6881,7 @@ SWGLAPI void STDCALL glDrv_glIndexubv(const GLubyte *c) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(c, 1, glDrv_glIndexubv, c);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     // ...
@@ -6490,6 +6892,7 @@ SWGLAPI void STDCALL glDrv_glInterleavedArrays(GLenum format, GLsizei stride, co
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glInterleavedArrays, format, stride, pointer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6500,6 +6903,7 @@ SWGLAPI void STDCALL glDrv_glNormalPointer(GLenum type, GLsizei stride, const GL
     LOG("Type: %04x, Stride: %d byte, Address: %p", type, stride, pointer);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glNormalPointer, type, stride, pointer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (pointer != nullptr) {
@@ -6520,9 +6924,11 @@ SWGLAPI void STDCALL glDrv_glPolygonOffset(GLfloat factor, GLfloat units) {
     LOG("Factor: %f, Units: %f", factor, units);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPolygonOffset, factor, units);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getPolygonOffset().setOffset(factor, units);
+    ctx->getRenderer().invalidateDrawState();
 }
 
 SWGLAPI void STDCALL glDrv_glPopClientAttrib(void) {
@@ -6530,6 +6936,7 @@ SWGLAPI void STDCALL glDrv_glPopClientAttrib(void) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPopClientAttrib);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6540,6 +6947,7 @@ SWGLAPI void STDCALL glDrv_glPrioritizeTextures(GLsizei n, const GLuint *texture
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glPrioritizeTextures, n, textures, priorities);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6550,6 +6958,7 @@ SWGLAPI void STDCALL glDrv_glPushClientAttrib(GLbitfield mask) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glPushClientAttrib, mask);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6560,6 +6969,7 @@ SWGLAPI void STDCALL glDrv_glTexCoordPointer(GLint size, GLenum type, GLsizei st
     LOG("Size: %d, Type: %04x, Stride: %d byte, Address: %p", size, type, stride, pointer);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glTexCoordPointer, size, type, stride, pointer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().getVertexDataArray().setSourcePointer(
@@ -6577,6 +6987,7 @@ SWGLAPI void STDCALL glDrv_glTexSubImage1D(GLenum target, GLint level, GLint xof
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexSubImage1D, target, level, xoffset, width, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6587,6 +6998,7 @@ SWGLAPI void STDCALL glDrv_glTexSubImage2D(GLenum target, GLint level, GLint xof
     LOG("Target: %04x, Level: %d, X-Offset: %d, Y-Offset: %d, Width: %d, Height: %d, Format: %04x, Type: %04x, Pixels: %p", target, level, xoffset, yoffset, width, height, format, type, pixels);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (level < 0 || level > static_cast<GLint>(SWGL_MAX_TEXTURE_LOD)) {
@@ -6633,6 +7045,7 @@ SWGLAPI void STDCALL glDrv_glVertexPointer(GLint size, GLenum type, GLsizei stri
     LOG("Size: %d, Type: %04x, Stride: %d byte, Address: %p", size, type, stride, pointer);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glVertexPointer, size, type, stride, pointer);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     ctx->getVertexPipeline().getVertexDataArray().setSourcePointer(
@@ -6653,6 +7066,7 @@ SWGLAPI void STDCALL glDrv_glDrawRangeElements(GLenum mode, GLuint start, GLuint
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glDrawRangeElements, mode, start, end, count, type, indices);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6663,6 +7077,7 @@ SWGLAPI void STDCALL glDrv_glTexImage3D(GLenum target, GLint level, GLint intern
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexImage3D, target, level, internalFormat, width, height, depth, border, format, type, data);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6673,6 +7088,7 @@ SWGLAPI void STDCALL glDrv_glTexSubImage3D(GLenum target, GLint level, GLint xof
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glTexSubImage3D, target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6683,6 +7099,7 @@ SWGLAPI void STDCALL glDrv_glCopyTexSubImage3D(GLenum target, GLint level, GLint
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glCopyTexSubImage3D, target, level, xoffset, yoffset, zoffset, x, y, width, height);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6696,6 +7113,7 @@ SWGLAPI void STDCALL glDrv_glActiveTexture(GLenum texture) {
     LOG("Active Texture: %d", texture - GL_TEXTURE0);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glActiveTexture, texture);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto texIdx = texture - GL_TEXTURE0;
@@ -6717,6 +7135,7 @@ SWGLAPI void STDCALL glDrv_glSampleCoverage(GLfloat value, GLboolean invert) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glSampleCoverage, value, invert);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6727,6 +7146,7 @@ SWGLAPI void STDCALL glDrv_glCompressedTexImage3D(GLenum target, GLint level, GL
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glCompressedTexImage3D, target, level, internalformat, width, height, depth, border, imageSize, data);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6737,6 +7157,7 @@ SWGLAPI void STDCALL glDrv_glCompressedTexImage2D(GLenum target, GLint level, GL
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glCompressedTexImage2D, target, level, internalformat, width, height, border, imageSize, data);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6747,6 +7168,7 @@ SWGLAPI void STDCALL glDrv_glCompressedTexImage1D(GLenum target, GLint level, GL
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glCompressedTexImage1D, target, level, internalformat, width, border, imageSize, data);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6757,6 +7179,7 @@ SWGLAPI void STDCALL glDrv_glCompressedTexSubImage3D(GLenum target, GLint level,
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glCompressedTexSubImage3D, target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6767,6 +7190,7 @@ SWGLAPI void STDCALL glDrv_glCompressedTexSubImage2D(GLenum target, GLint level,
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glCompressedTexSubImage2D, target, level, xoffset, yoffset, width, height, format, imageSize, data);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6777,6 +7201,7 @@ SWGLAPI void STDCALL glDrv_glCompressedTexSubImage1D(GLenum target, GLint level,
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glCompressedTexSubImage1D, target, level, xoffset, width, format, imageSize, data);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6787,6 +7212,7 @@ SWGLAPI void STDCALL glDrv_glGetCompressedTexImage(GLenum target, GLint level, G
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetCompressedTexImage, target, level, pixels);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -6797,6 +7223,7 @@ SWGLAPI void STDCALL glDrv_glClientActiveTexture(GLenum texture) {
     LOG("Texture: %d", texture - GL_TEXTURE0);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glClientActiveTexture, texture);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     auto texIdx = texture - GL_TEXTURE0;
@@ -6818,6 +7245,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1d(GLenum target, GLdouble s) {
     LOG("Target: %04x, S: %f", target, s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord1d, target, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6842,6 +7270,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1dv(GLenum target, const GLdouble *v)
     LOG("Target: %04x, S: %f", target, v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glMultiTexCoord1dv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6866,6 +7295,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1f(GLenum target, GLfloat s) {
     LOG("Target: %04x, S: %f", target, s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord1f, target, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6884,6 +7314,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1fv(GLenum target, const GLfloat *v) {
     LOG("Target: %04x, S: %f", target, v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glMultiTexCoord1fv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6902,6 +7333,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1i(GLenum target, GLint s) {
     LOG("Target: %04x, S: %d", target, s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord1i, target, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6926,6 +7358,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1iv(GLenum target, const GLint *v) {
     LOG("Target: %04x, S: %d", target, v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glMultiTexCoord1iv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6950,6 +7383,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1s(GLenum target, GLshort s) {
     LOG("Target: %04x, S: %d", target, s);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord1s, target, s);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6974,6 +7408,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord1sv(GLenum target, const GLshort *v) {
     LOG("Target: %04x, S: %d", target, v[0]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 1, glDrv_glMultiTexCoord1sv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -6998,6 +7433,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2d(GLenum target, GLdouble s, GLdouble
     LOG("Target: %04x, S: %f, T: %f", target, s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord2d, target, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7022,6 +7458,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2dv(GLenum target, const GLdouble *v)
     LOG("Target: %04x, S: %f, T: %f", target, v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glMultiTexCoord2dv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7046,6 +7483,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2f(GLenum target, GLfloat s, GLfloat t
     LOG("Target: %04x, S: %f, T: %f", target, s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord2f, target, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7064,6 +7502,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2fv(GLenum target, const GLfloat *v) {
     LOG("Target: %04x, S: %f, T: %f", target, v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glMultiTexCoord2fv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7082,6 +7521,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2i(GLenum target, GLint s, GLint t) {
     LOG("Target: %04x, S: %d, T: %d", target, s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord2i, target, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7106,6 +7546,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2iv(GLenum target, const GLint *v) {
     LOG("Target: %04x, S: %d, T: %d", target, v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glMultiTexCoord2iv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7130,6 +7571,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2s(GLenum target, GLshort s, GLshort t
     LOG("Target: %04x, S: %d, T: %d", target, s, t);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord2s, target, s, t);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7154,6 +7596,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord2sv(GLenum target, const GLshort *v) {
     LOG("Target: %04x, S: %d, T: %d", target, v[0], v[1]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 2, glDrv_glMultiTexCoord2sv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7178,6 +7621,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3d(GLenum target, GLdouble s, GLdouble
     LOG("Target: %04x, S: %f, T: %f, R: %f", target, s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord3d, target, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7202,6 +7646,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3dv(GLenum target, const GLdouble *v)
     LOG("Target: %04x, S: %f, T: %f, R: %f", target, v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glMultiTexCoord3dv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7226,6 +7671,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3f(GLenum target, GLfloat s, GLfloat t
     LOG("Target: %04x, S: %f, T: %f, R: %f", target, s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord3f, target, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7244,6 +7690,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3fv(GLenum target, const GLfloat *v) {
     LOG("Target: %04x, S: %f, T: %f, R: %f", target, v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glMultiTexCoord3fv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7262,6 +7709,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3i(GLenum target, GLint s, GLint t, GL
     LOG("Target: %04x, S: %d, T: %d, R: %d", target, s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord3i, target, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7286,6 +7734,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3iv(GLenum target, const GLint *v) {
     LOG("Target: %04x, S: %d, T: %d, R: %d", target, v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glMultiTexCoord3iv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7310,6 +7759,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3s(GLenum target, GLshort s, GLshort t
     LOG("Target: %04x, S: %d, T: %d, R: %d", target, s, t, r);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord3s, target, s, t, r);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7334,6 +7784,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord3sv(GLenum target, const GLshort *v) {
     LOG("Target: %04x, S: %d, T: %d, R: %d", target, v[0], v[1], v[2]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 3, glDrv_glMultiTexCoord3sv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7358,6 +7809,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4d(GLenum target, GLdouble s, GLdouble
     LOG("Target: %04x, S: %f, T: %f, R: %f, Q: %f", target, s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord4d, target, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7382,6 +7834,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4dv(GLenum target, const GLdouble *v)
     LOG("Target: %04x, S: %f, T: %f, R: %f, Q: %f", target, v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glMultiTexCoord4dv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7406,6 +7859,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4f(GLenum target, GLfloat s, GLfloat t
     LOG("Target: %04x, S: %f, T: %f, R: %f, Q: %f", target, s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord4f, target, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7424,6 +7878,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4fv(GLenum target, const GLfloat *v) {
     LOG("Target: %04x, S: %f, T: %f, R: %f, Q: %f", target, v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glMultiTexCoord4fv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7442,6 +7897,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4i(GLenum target, GLint s, GLint t, GL
     LOG("Target: %04x, S: %d, T: %d, R: %d, Q: %d", target, s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord4i, target, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7466,6 +7922,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4iv(GLenum target, const GLint *v) {
     LOG("Target: %04x, S: %d, T: %d, R: %d, Q: %d", target, v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glMultiTexCoord4iv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7490,6 +7947,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4s(GLenum target, GLshort s, GLshort t
     LOG("Target: %04x, S: %d, T: %d, R: %d, Q: %d", target, s, t, r, q);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glMultiTexCoord4s, target, s, t, r, q);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7514,6 +7972,7 @@ SWGLAPI void STDCALL glDrv_glMultiTexCoord4sv(GLenum target, const GLshort *v) {
     LOG("Target: %04x, S: %d, T: %d, R: %d, Q: %d", target, v[0], v[1], v[2], v[3]);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(v, 4, glDrv_glMultiTexCoord4sv, target, v);
     CAN_BE_CALLED_INSIDE_GL_BEGIN();
 
     auto texIdx = target - GL_TEXTURE0;
@@ -7538,6 +7997,7 @@ SWGLAPI void STDCALL glDrv_glLoadTransposeMatrixf(const GLfloat *m) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(m, 16, glDrv_glLoadTransposeMatrixf, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -7548,6 +8008,7 @@ SWGLAPI void STDCALL glDrv_glLoadTransposeMatrixd(const GLdouble *m) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glLoadTransposeMatrixd, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -7558,6 +8019,7 @@ SWGLAPI void STDCALL glDrv_glMultTransposeMatrixf(const GLfloat *m) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_WITH_ARRAY(m, 16, glDrv_glMultTransposeMatrixf, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -7568,6 +8030,7 @@ SWGLAPI void STDCALL glDrv_glMultTransposeMatrixd(const GLdouble *m) {
     LOG("Unimplemented");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glMultTransposeMatrixd, m);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // ...
@@ -7584,6 +8047,7 @@ SWGLAPI void STDCALL glDrv_glLockArrays(GLint start, GLsizei count) {
     LOG("Lock Arrays: First = %d, Count = %d", start, count);
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glLockArrays, start, count);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     if (start < 0 || count <= 0) {
@@ -7600,9 +8064,348 @@ SWGLAPI void STDCALL glDrv_glUnlockArrays() {
     LOG("");
 
     GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glUnlockArrays);
     MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
 
     // Just do nothing!
 }
 
 #pragma endregion
+
+
+#pragma region Extension: GL_NV_fence
+
+SWGLAPI void STDCALL glDrv_glGenFencesNV(GLsizei n, GLuint *fences) {
+
+    LOG("Number of fences: %d, Address: %p", n, fences);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGenFencesNV, n, fences);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    if (fences != nullptr) {
+
+        if (n < 0) {
+
+            ctx->getError().setState(GL_INVALID_VALUE);
+            return;
+        }
+
+        ctx->getFenceManager().genFences(n, fences);
+    }
+}
+
+SWGLAPI void STDCALL glDrv_glDeleteFencesNV(GLsizei n, const GLuint *fences) {
+
+    LOG("Number of fences: %d, List Address: %p", n, fences);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glDeleteFencesNV, n, fences);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    if (fences != nullptr) {
+
+        if (n < 0) {
+
+            ctx->getError().setState(GL_INVALID_VALUE);
+            return;
+        }
+
+        auto &fenceManager = ctx->getFenceManager();
+        for (int i = 0; i < n; i++) {
+
+            fenceManager.deleteFence(fences[i]);
+        }
+    }
+}
+
+SWGLAPI void STDCALL glDrv_glSetFenceNV(GLuint fence, GLenum condition) {
+
+    LOG("Fence: %d, Condition: %04x", fence, condition);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glSetFenceNV, fence, condition);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    if (condition != GL_ALL_COMPLETED_NV) {
+
+        ctx->getError().setState(GL_INVALID_ENUM);
+        return;
+    }
+
+    auto &fenceManager = ctx->getFenceManager();
+    if (!fenceManager.isFenceName(fence)) {
+
+        ctx->getError().setState(GL_INVALID_OPERATION);
+        return;
+    }
+
+    ctx->getRenderer().setFence(fenceManager.setFence(fence));
+}
+
+SWGLAPI GLboolean STDCALL glDrv_glTestFenceNV(GLuint fence) {
+
+    LOG("Fence: %d", fence);
+
+    GET_CONTEXT_OR_RETURN(GL_TRUE);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glTestFenceNV, fence);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_TRUE);
+
+    auto fenceObj = ctx->getFenceManager().getFence(fence);
+    if (fenceObj == nullptr) {
+
+        ctx->getError().setState(GL_INVALID_OPERATION);
+        return GL_TRUE;
+    }
+
+    return fenceObj->isSignaled() ? GL_TRUE : GL_FALSE;
+}
+
+SWGLAPI void STDCALL glDrv_glFinishFenceNV(GLuint fence) {
+
+    LOG("Fence: %d", fence);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glFinishFenceNV, fence);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    auto fenceObj = ctx->getFenceManager().getFence(fence);
+    if (fenceObj == nullptr) {
+
+        ctx->getError().setState(GL_INVALID_OPERATION);
+        return;
+    }
+
+    fenceObj->wait();
+}
+
+SWGLAPI GLboolean STDCALL glDrv_glIsFenceNV(GLuint fence) {
+
+    LOG("Fence: %d", fence);
+
+    GET_CONTEXT_OR_RETURN(GL_FALSE);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glIsFenceNV, fence);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_FALSE);
+
+    // A name only becomes a fence once it was set
+    return ctx->getFenceManager().getFence(fence) != nullptr ? GL_TRUE : GL_FALSE;
+}
+
+SWGLAPI void STDCALL glDrv_glGetFenceivNV(GLuint fence, GLenum pname, GLint *params) {
+
+    LOG("Fence: %d, Name: %04x, Params: %p", fence, pname, params);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetFenceivNV, fence, pname, params);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    auto fenceObj = ctx->getFenceManager().getFence(fence);
+    if (fenceObj == nullptr) {
+
+        ctx->getError().setState(GL_INVALID_OPERATION);
+        return;
+    }
+
+    switch (pname) {
+
+    case GL_FENCE_STATUS_NV:
+        *params = fenceObj->isSignaled() ? GL_TRUE : GL_FALSE;
+        break;
+
+    case GL_FENCE_CONDITION_NV:
+        *params = GL_ALL_COMPLETED_NV;
+        break;
+
+    default:
+        ctx->getError().setState(GL_INVALID_ENUM);
+        break;
+    }
+}
+
+#pragma endregion
+
+
+
+#pragma region Extension: GL_ARB_sync
+
+SWGLAPI GLsync STDCALL glDrv_glFenceSync(GLenum condition, GLbitfield flags) {
+
+    LOG("Condition: %04x, Flags: %04x", condition, flags);
+
+    GET_CONTEXT_OR_RETURN(nullptr);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glFenceSync, condition, flags);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN(nullptr);
+
+    if (condition != GL_SYNC_GPU_COMMANDS_COMPLETE) {
+
+        ctx->getError().setState(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    if (flags != 0) {
+
+        ctx->getError().setState(GL_INVALID_VALUE);
+        return nullptr;
+    }
+
+    auto &fenceManager = ctx->getFenceManager();
+    auto sync = fenceManager.createSync();
+
+    ctx->getRenderer().setFence(fenceManager.getSync(sync));
+
+    return sync;
+}
+
+SWGLAPI GLboolean STDCALL glDrv_glIsSync(GLsync sync) {
+
+    LOG("Sync: %p", sync);
+
+    GET_CONTEXT_OR_RETURN(GL_FALSE);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glIsSync, sync);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_FALSE);
+
+    return ctx->getFenceManager().getSync(sync) != nullptr ? GL_TRUE : GL_FALSE;
+}
+
+SWGLAPI void STDCALL glDrv_glDeleteSync(GLsync sync) {
+
+    LOG("Sync: %p", sync);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glDeleteSync, sync);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    if (sync != nullptr && !ctx->getFenceManager().deleteSync(sync)) {
+
+        ctx->getError().setState(GL_INVALID_VALUE);
+    }
+}
+
+SWGLAPI GLenum STDCALL glDrv_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+
+    LOG("Sync: %p, Flags: %04x, Timeout: %llu", sync, flags, timeout);
+
+    GET_CONTEXT_OR_RETURN(GL_WAIT_FAILED);
+    FORWARD_TO_FRONTEND_AND_RETURN(glDrv_glClientWaitSync, sync, flags, timeout);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN(GL_WAIT_FAILED);
+
+    auto fence = ctx->getFenceManager().getSync(sync);
+    if (fence == nullptr || (flags & ~GL_SYNC_FLUSH_COMMANDS_BIT) != 0) {
+
+        ctx->getError().setState(GL_INVALID_VALUE);
+        return GL_WAIT_FAILED;
+    }
+
+    // The commands are handed to the drawing threads right away, so there is
+    // nothing to flush
+    if (fence->isSignaled()) {
+
+        return GL_ALREADY_SIGNALED;
+    }
+
+    if (timeout == 0) {
+
+        return GL_TIMEOUT_EXPIRED;
+    }
+
+    // Timeouts that don't fit into the clock are as good as infinite
+    if (timeout >= static_cast<GLuint64>(std::numeric_limits<long long>::max() / 2)) {
+
+        fence->wait();
+        return GL_CONDITION_SATISFIED;
+    }
+
+    return fence->waitFor(std::chrono::nanoseconds(timeout)) ? GL_CONDITION_SATISFIED : GL_TIMEOUT_EXPIRED;
+}
+
+SWGLAPI void STDCALL glDrv_glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+
+    LOG("Sync: %p, Flags: %04x, Timeout: %llu", sync, flags, timeout);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND(glDrv_glWaitSync, sync, flags, timeout);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    if (ctx->getFenceManager().getSync(sync) == nullptr || flags != 0 || timeout != GL_TIMEOUT_IGNORED) {
+
+        ctx->getError().setState(GL_INVALID_VALUE);
+        return;
+    }
+
+    // Nothing to do! Every tile executes its commands in order and there is no
+    // other context that could signal the fence.
+}
+
+SWGLAPI void STDCALL glDrv_glGetInteger64v(GLenum pname, GLint64 *params) {
+
+    LOG("Name: %04x, Params: %p", pname, params);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetInteger64v, pname, params);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    switch (pname) {
+
+    case GL_MAX_SERVER_WAIT_TIMEOUT:
+        *params = 0;
+        break;
+
+    default:
+        LOG("Unimplemented");
+        ctx->getError().setState(GL_INVALID_ENUM);
+        break;
+    }
+}
+
+SWGLAPI void STDCALL glDrv_glGetSynciv(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values) {
+
+    LOG("Sync: %p, Name: %04x, Size: %d, Length: %p, Values: %p", sync, pname, bufSize, length, values);
+
+    GET_CONTEXT_OR_RETURN();
+    FORWARD_TO_FRONTEND_AND_WAIT(glDrv_glGetSynciv, sync, pname, bufSize, length, values);
+    MUST_BE_CALLED_OUTSIDE_GL_BEGIN();
+
+    auto fence = ctx->getFenceManager().getSync(sync);
+    if (fence == nullptr) {
+
+        ctx->getError().setState(GL_INVALID_VALUE);
+        return;
+    }
+
+    GLint value;
+
+    switch (pname) {
+
+    case GL_OBJECT_TYPE:
+        value = GL_SYNC_FENCE;
+        break;
+
+    case GL_SYNC_STATUS:
+        value = fence->isSignaled() ? GL_SIGNALED : GL_UNSIGNALED;
+        break;
+
+    case GL_SYNC_CONDITION:
+        value = GL_SYNC_GPU_COMMANDS_COMPLETE;
+        break;
+
+    case GL_SYNC_FLAGS:
+        value = 0;
+        break;
+
+    default:
+        ctx->getError().setState(GL_INVALID_ENUM);
+        return;
+    }
+
+    if (bufSize > 0) {
+
+        *values = value;
+    }
+
+    if (length != nullptr) {
+
+        *length = bufSize > 0 ? 1 : 0;
+    }
+}
+
+#pragma endregion
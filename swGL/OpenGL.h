@@ -18,6 +18,9 @@ typedef float GLfloat;
 typedef float GLclampf;
 typedef double GLdouble;
 typedef double GLclampd;
+typedef long long GLint64;
+typedef unsigned long long GLuint64;
+typedef struct __GLsync *GLsync;
 
 // Boolean values
 #define GL_FALSE                                0x0
@@ -833,6 +836,32 @@ typedef double GLclampd;
 #define GL_DOT3_RGBA                            0x86AF
 // -------------------------------------------------------
 
+// GL_NV_fence
+// -------------------------------------------------------
+#define GL_ALL_COMPLETED_NV                     0x84F2
+#define GL_FENCE_STATUS_NV                      0x84F3
+#define GL_FENCE_CONDITION_NV                   0x84F4
+// -------------------------------------------------------
+
+// GL_ARB_sync
+// -------------------------------------------------------
+#define GL_MAX_SERVER_WAIT_TIMEOUT              0x9111
+#define GL_OBJECT_TYPE                          0x9112
+#define GL_SYNC_CONDITION                       0x9113
+#define GL_SYNC_STATUS                          0x9114
+#define GL_SYNC_FLAGS                           0x9115
+#define GL_SYNC_FENCE                           0x9116
+#define GL_SYNC_GPU_COMMANDS_COMPLETE           0x9117
+#define GL_UNSIGNALED                           0x9118
+#define GL_SIGNALED                             0x9119
+#define GL_ALREADY_SIGNALED                     0x911A
+#define GL_TIMEOUT_EXPIRED                      0x911B
+#define GL_CONDITION_SATISFIED                  0x911C
+#define GL_WAIT_FAILED                          0x911D
+#define GL_SYNC_FLUSH_COMMANDS_BIT              0x00000001
+#define GL_TIMEOUT_IGNORED                      0xFFFFFFFFFFFFFFFFull
+// -------------------------------------------------------
+
 
 
 // Open GL 1.0
@@ -1241,4 +1270,18 @@ SWGLAPI void STDCALL glDrv_glMultTransposeMatrixd(const GLdouble *m);
 // -------------------------------------------------------
 SWGLAPI void STDCALL glDrv_glLockArrays(GLint first, GLsizei count);
 SWGLAPI void STDCALL glDrv_glUnlockArrays();
+SWGLAPI void STDCALL glDrv_glGenFencesNV(GLsizei n, GLuint *fences);
+SWGLAPI void STDCALL glDrv_glDeleteFencesNV(GLsizei n, const GLuint *fences);
+SWGLAPI void STDCALL glDrv_glSetFenceNV(GLuint fence, GLenum condition);
+SWGLAPI GLboolean STDCALL glDrv_glTestFenceNV(GLuint fence);
+SWGLAPI void STDCALL glDrv_glFinishFenceNV(GLuint fence);
+SWGLAPI GLboolean STDCALL glDrv_glIsFenceNV(GLuint fence);
+SWGLAPI void STDCALL glDrv_glGetFenceivNV(GLuint fence, GLenum pname, GLint *params);
+SWGLAPI GLsync STDCALL glDrv_glFenceSync(GLenum condition, GLbitfield flags);
+SWGLAPI GLboolean STDCALL glDrv_glIsSync(GLsync sync);
+SWGLAPI void STDCALL glDrv_glDeleteSync(GLsync sync);
+SWGLAPI GLenum STDCALL glDrv_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
+SWGLAPI void STDCALL glDrv_glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
+SWGLAPI void STDCALL glDrv_glGetInteger64v(GLenum pname, GLint64 *params);
+SWGLAPI void STDCALL glDrv_glGetSynciv(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values);
 // -------------------------------------------------------
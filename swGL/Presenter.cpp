@@ -0,0 +1,114 @@
+﻿#include <stdexcept>
+#include "Log.h"
+#include "Configuration.h"
+#include "Presenter.h"
+
+namespace SWGL {
+
+    Presenter::Presenter(DrawSurface &drawSurface)
+
+        : m_drawSurface(drawSurface),
+          m_currentFrame(0),
+          m_isStopRequested(false) {
+
+        m_numFrames = static_cast<int>(Configuration::getInstance().getNumFramesInFlight());
+
+        for (auto i = 0U; i < SWGL_MAX_FRAMES_IN_FLIGHT; i++) {
+
+            m_isFrameInUse[i] = false;
+        }
+        m_isFrameInUse[m_currentFrame] = true;
+    }
+
+
+
+    void Presenter::start() {
+
+        m_isStopRequested = false;
+
+        m_thread = std::thread(&Presenter::run, this);
+    }
+
+    void Presenter::stop() {
+
+        {
+            std::lock_guard<std::mutex> cs(m_mutex);
+            m_isStopRequested = true;
+        }
+        m_frameQueued.notify_one();
+
+        try {
+
+            if (m_thread.joinable()) {
+
+                m_thread.join();
+            }
+        }
+        catch (std::runtime_error ex) {
+
+            LOG("std::thread::join() failed: %s", ex.what());
+        }
+    }
+
+
+
+    void Presenter::presentFrame() {
+
+        std::unique_lock<std::mutex> cs(m_mutex);
+
+        m_pendingFrames.push_back(m_currentFrame);
+        m_frameQueued.notify_one();
+
+        // Wait until the next frame image isn't presented anymore. This bounds the
+        // number of frames the application can run ahead.
+        m_currentFrame = (m_currentFrame + 1) % m_numFrames;
+        m_frameDone.wait(cs, [this] {
+
+            return !m_isFrameInUse[m_currentFrame];
+        });
+
+        m_isFrameInUse[m_currentFrame] = true;
+    }
+
+    void Presenter::waitIdle() {
+
+        std::unique_lock<std::mutex> cs(m_mutex);
+        m_frameDone.wait(cs, [this] {
+
+            return m_pendingFrames.empty();
+        });
+    }
+
+
+
+
+    void Presenter::run() {
+
+        std::unique_lock<std::mutex> cs(m_mutex);
+
+        for (;;) {
+
+            m_frameQueued.wait(cs, [this] {
+
+                return m_isStopRequested || !m_pendingFrames.empty();
+            });
+
+            // Frames that are already queued are still presented before stopping
+            if (m_pendingFrames.empty()) {
+
+                return;
+            }
+
+            auto frameIdx = m_pendingFrames.front();
+            cs.unlock();
+
+            m_frameLatches[frameIdx].wait();
+            m_drawSurface.present(frameIdx);
+
+            cs.lock();
+            m_pendingFrames.pop_front();
+            m_isFrameInUse[frameIdx] = false;
+            m_frameDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include "Defines.h"
+#include "DrawSurface.h"
+#include "CountDownLatch.h"
+
+namespace SWGL {
+
+    //
+    // Presents the finished frames on its own thread, so the application can go on
+    // with the next frame while the previous one is being blitted. Every frame in
+    // flight has its own frame image (see DrawSurface).
+    //
+    class Presenter {
+
+    public:
+        Presenter(DrawSurface &drawSurface);
+        ~Presenter() = default;
+
+    public:
+        void start();
+        void stop();
+
+    public:
+        int getCurrentFrame() const { return m_currentFrame; }
+        CountDownLatch &getFrameLatch() { return m_frameLatches[m_currentFrame]; }
+
+        void presentFrame();
+        void waitIdle();
+
+    private:
+        void run();
+
+    private:
+        DrawSurface &m_drawSurface;
+        int m_numFrames;
+        int m_currentFrame;
+        CountDownLatch m_frameLatches[SWGL_MAX_FRAMES_IN_FLIGHT];
+        bool m_isFrameInUse[SWGL_MAX_FRAMES_IN_FLIGHT];
+        std::deque<int> m_pendingFrames;
+
+    private:
+        bool m_isStopRequested;
+        std::condition_variable m_frameQueued;
+        std::condition_variable m_frameDone;
+        std::mutex m_mutex;
+        std::thread m_thread;
+    };
+}
@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include "SIMD.h"
+#include "OpenGL.h"
+#include "DrawBuffer.h"
+
+//
+// The helpers the draw triangle kernels share. Like the kernels they are compiled once
+// per instruction set, so they live in the namespace of the level (see Kernels.inl).
+//
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    //
+    // Edge equation of a triangle, relative to the top left corner of the bounding box.
+    // A pixel is covered if the values of all three edges are positive.
+    //
+    struct EdgeEquation {
+
+        EdgeEquation() = default;
+        INLINED EdgeEquation(int edge, int dx, int dy, int minX, int minY) {
+
+            // The constant part of the edge equation comes from the triangle setup
+            dedx = -dy << 4;
+            dedy = dx << 4;
+            value = edge + (dedx * minX) + (dedy * minY);
+        }
+
+        INLINED int evaluate(int x, int y) const { return value + (dedx * x) + (dedy * y); }
+
+        int value;
+        int dedx;
+        int dedy;
+    };
+
+    // A raster operation which the draw triangle kernel isn't specialized on, so it is
+    // read from the state block instead (see CommandDrawTriangle.inl)
+    constexpr GLenum RASTER_OP_RUNTIME = 0xffffffff;
+
+    template<GLenum Value>
+    INLINED GLenum resolveRasterOp(GLenum value) {
+
+        return (Value == RASTER_OP_RUNTIME) ? value : Value;
+    }
+
+    enum class BlockCoverage {
+
+        Empty,
+        Partial,
+        Full
+    };
+
+    // Tests a block of pixels (given relative to the bounding box) against the edges
+    INLINED BlockCoverage testBlockCoverage(const EdgeEquation (&edges)[3], int x0, int y0, int x1, int y1) {
+
+        bool isFull = true;
+
+        for (auto &edge : edges) {
+
+            // The edge equations are linear, so the smallest and the largest value
+            // within the block are found at two of its corners
+            int minValue = edge.evaluate(edge.dedx > 0 ? x0 : x1, edge.dedy > 0 ? y0 : y1);
+            int maxValue = edge.evaluate(edge.dedx > 0 ? x1 : x0, edge.dedy > 0 ? y1 : y0);
+
+            if (maxValue <= 0) {
+
+                return BlockCoverage::Empty;
+            }
+
+            isFull &= minValue > 0;
+        }
+
+        return isFull ? BlockCoverage::Full : BlockCoverage::Partial;
+    }
+
+    //
+    // Depth equation of a triangle, the depth of the pixel (x, y) is
+    // value + (x * dzdx) + (y * dzdy)
+    //
+    struct DepthPlane {
+
+        // The range of the depth values within a rectangle of pixels (given as the first
+        // and the last pixel). It is widened by the rounding errors of the kernels, which
+        // evaluate the equation in a different order.
+        INLINED DepthBounds getBounds(int x0, int y0, int x1, int y1) const {
+
+            float zx0 = dzdx * static_cast<float>(x0), zx1 = dzdx * static_cast<float>(x1);
+            float zy0 = dzdy * static_cast<float>(y0), zy1 = dzdy * static_cast<float>(y1);
+
+            float magnitude = SIMD::absolute(value) + SIMD::max(SIMD::absolute(zx0), SIMD::absolute(zx1)) + SIMD::max(SIMD::absolute(zy0), SIMD::absolute(zy1));
+            float error = magnitude * 1.0e-6f;
+
+            float minZ = value + SIMD::min(zx0, zx1) + SIMD::min(zy0, zy1) - error;
+            float maxZ = value + SIMD::max(zx0, zx1) + SIMD::max(zy0, zy1) + error;
+
+            // Clamp like the kernels do, a NaN gives the full range
+            minZ = (minZ > 0.0f) ? SIMD::min(minZ, 1.0f) : 0.0f;
+            maxZ = (maxZ < 1.0f) ? SIMD::max(maxZ, 0.0f) : 1.0f;
+
+            return {
+
+                static_cast<int>(minZ * 16777215.0f),
+                static_cast<int>(maxZ * 16777215.0f) + 1
+            };
+        }
+
+        float value;
+        float dzdx;
+        float dzdy;
+    };
+
+    // Tests if the depth test fails for every depth value of a triangle within a part of
+    // the depth buffer, so the part can be skipped
+    INLINED bool isDepthTestFailing(GLenum depthFunc, const DepthBounds &triangle, const DepthBounds &buffer) {
+
+        switch (depthFunc) {
+
+        case GL_NEVER: return true;
+        case GL_LESS: return triangle.min >= buffer.max;
+        case GL_EQUAL: return triangle.min > buffer.max || triangle.max < buffer.min;
+        case GL_LEQUAL: return triangle.min > buffer.max;
+        case GL_GREATER: return triangle.max <= buffer.min;
+        case GL_GEQUAL: return triangle.max < buffer.min;
+        }
+
+        return false;
+    }
+}
+}
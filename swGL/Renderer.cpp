@@ -1,34 +1,38 @@
-﻿#include <array>
-#include <vector>
+﻿#include <vector>
+#include <limits>
+#include <chrono>
+#include <thread>
 #include "Defines.h"
+#include "Configuration.h"
 #include "Context.h"
 #include "Log.h"
-#include "CommandClearColor.h"
-#include "CommandClearDepth.h"
-#include "CommandDrawTriangle.h"
-#include "CommandPoisonPill.h"
-#include "CommandSynchronize.h"
+#include "Statistics.h"
+#include "Command.h"
 #include "Renderer.h"
 
 namespace SWGL {
 
-    Renderer::Renderer() {
+    Renderer::Renderer()
+
+        : m_drawThreadPool(DrawThreadPool::getInstance()),
+          m_batchStateBlock(nullptr),
+          m_priority(SWGL_DEFAULT_CONTEXT_PRIORITY),
+          m_pendingWorkload(0),
+          m_binner(m_drawThreadPool.getThreadPool()),
+          m_presenter(m_drawSurface) {
 
-        m_drawThreads.resize(SWGL_NUM_DRAW_THREADS);
     }
 
 
 
     void Renderer::init() {
         
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
-
-            m_drawThreads[i] = std::make_unique<DrawThread>(
-
-                m_drawSurface.getBuffer(i)
-            );
-            m_drawThreads[i]->start();
+        {
+            std::lock_guard<std::mutex> cs(m_drawClientMutex);
+            m_drawClient = m_drawThreadPool.attach(m_drawSurface, m_priority.load(std::memory_order_relaxed));
         }
+
+        m_presenter.start();
     }
 
 
@@ -40,20 +44,34 @@ namespace SWGL {
         auto &scissor = ctx->getScissor();
         auto clearColor = ctx->getClearValues().getClearColor();
 
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
+        flushBatch();
+
+        forEachTile(scissor.getMinX(), scissor.getMinY(), scissor.getMaxX(), scissor.getMaxY(), [&](int tileIdx) {
+
+            addCommand(
+
+                m_drawSurface.getTile(tileIdx),
+                Command(
 
-            m_drawThreads[i]->addCommand(
+                    CommandClearColor(
 
-                std::make_unique<CommandClearColor>(
+                        clearColor,
+                        scissor.getMinX(),
+                        scissor.getMinY(),
+                        scissor.getMaxX(),
+                        scissor.getMaxY()
+                    ),
+                    CostModel::getClearCost(getCoveredArea(
 
-                    clearColor,
-                    scissor.getMinX(),
-                    scissor.getMinY(),
-                    scissor.getMaxX(),
-                    scissor.getMaxY()
+                        tileIdx,
+                        scissor.getMinX(),
+                        scissor.getMinY(),
+                        scissor.getMaxX(),
+                        scissor.getMaxY()
+                    ))
                 )
             );
-        }
+        });
     }
 
     void Renderer::clearDepthBuffer() {
@@ -63,141 +81,168 @@ namespace SWGL {
         auto &scissor = ctx->getScissor();
         auto clearDepth = ctx->getClearValues().getClearDepth();
 
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
+        flushBatch();
+
+        forEachTile(scissor.getMinX(), scissor.getMinY(), scissor.getMaxX(), scissor.getMaxY(), [&](int tileIdx) {
+
+            addCommand(
+
+                m_drawSurface.getTile(tileIdx),
+                Command(
 
-            m_drawThreads[i]->addCommand(
+                    CommandClearDepth(
 
-                std::make_unique<CommandClearDepth>(
+                        clearDepth,
+                        scissor.getMinX(),
+                        scissor.getMinY(),
+                        scissor.getMaxX(),
+                        scissor.getMaxY()
+                    ),
+                    CostModel::getClearCost(getCoveredArea(
 
-                    clearDepth,
-                    scissor.getMinX(),
-                    scissor.getMinY(),
-                    scissor.getMaxX(),
-                    scissor.getMaxY()
-                 )
+                        tileIdx,
+                        scissor.getMinX(),
+                        scissor.getMinY(),
+                        scissor.getMaxX(),
+                        scissor.getMaxY()
+                    ))
+                )
             );
-        }
+        });
     }
 
     void Renderer::drawTriangles(TriangleList &triangles) {
 
         auto &context = *Context::getCurrentContext();
-        auto &scissor = context.getScissor();
-        auto &texManager = context.getTextureManager();
 
+        // Too many different states within the frames in flight. The blocks can only
+        // be freed once no draw call refers to them anymore.
+        if (m_drawStateCache.getNumStateBlocks() >= SWGL_MAX_DRAW_STATE_BLOCKS) {
 
-        // Create the data that is shared by different drawing threads
-        // and is used to draw the triangles
-        auto drawState = std::make_shared<TriangleDrawCallState>();
-
-        drawState->triangles = std::move(triangles);
-        drawState->scissor = scissor;
-        drawState->polygonOffset = context.getPolygonOffset();
-        drawState->depthTesting = context.getDepthTesting();
-        drawState->alphaTesting = context.getAlphaTesting();
-        drawState->blending = context.getBlending();
-        drawState->colorMask = context.getColorMask();
-        drawState->deferedDepthWrite = context.getAlphaTesting().isEnabled() &&
-                                       context.getDepthTesting().isWriteEnabled() &&
-                                       context.getDepthTesting().isTestEnabled();
-
-        for (auto i = 0U; i < SWGL_MAX_TEXTURE_UNITS; i++) {
-
-            auto &unit = texManager.getTextureUnit(i);
-            auto &texState = drawState->textures[i];
-
-            if (unit.currentTarget != nullptr) {
-
-                auto &texObj = unit.currentTarget->texObj;
-
-                // TODO: Implement a flag for texture completeness (texObj->isComplete or
-                //       something like that)
-                if (texObj != nullptr &&
-                    texObj->data != nullptr &&
-                    texObj->data->maxLOD > -1) {
-
-                    texState.texEnv = unit.texEnv;
-                    texState.texData = texObj->data;
-                    texState.texParams = texObj->parameter;
-                    continue;
-                }
-            }
+            synchronize();
+            m_drawStateCache.clear();
+        }
 
-            texState.texData = nullptr;
+        // The state block is only rebuilt if the state has changed since the last
+        // draw call. Equal states share the same block, so the triangles can be
+        // appended to the current batch as long as the block stays the same.
+        auto stateBlock = m_drawStateCache.getStateBlock(context);
+        if (stateBlock != m_batchStateBlock) {
+
+            flushBatch();
         }
 
+        STATISTICS_ADD(DRAW_CALLS, 1);
 
-        // Figure out which triangle must be rendered by which thread
-        std::array<std::vector<int>, SWGL_NUM_DRAW_THREADS> bins;
+        if (!stateBlock->isRasterOpsSpecialized) {
 
-        auto binWidth = m_drawSurface.getBufferWidth();
-        auto binHeight = m_drawSurface.getBufferHeight();
-        auto numBinsX = m_drawSurface.getNumBuffersInX();
-        auto numBinsY = m_drawSurface.getNumBuffersInY();
+            STATISTICS_ADD(GENERIC_DRAW_CALLS, 1);
+        }
 
-        for (auto i = 0u, n = drawState->triangles.size(); i < n; i++) {
+        if (m_batchTriangles.empty()) {
 
-            auto &t = drawState->triangles[i];
+            m_batchTriangles = std::move(triangles);
+            m_batchStateBlock = stateBlock;
+        }
+        else {
 
-            auto &v1 = t.v[0].posObj;
-            auto &v2 = t.v[1].posObj;
-            auto &v3 = t.v[2].posObj;
+            m_batchTriangles.insert(m_batchTriangles.end(), triangles.begin(), triangles.end());
+            STATISTICS_ADD(MERGED_DRAW_CALLS, 1);
+        }
 
-            // Determine the triangles bounding box
-            float y1 = v1.y(), y2 = v2.y(), y3 = v3.y();
-            float x1 = v1.x(), x2 = v2.x(), x3 = v3.x();
+        if (m_batchTriangles.size() >= SWGL_MAX_BATCH_TRIANGLES) {
 
-            int minY = (static_cast<int>(16.0f * std::min({ y1, y2, y3 })) + 0x0f) >> 4;
-            int maxY = (static_cast<int>(16.0f * std::max({ y1, y2, y3 })) + 0x0f) >> 4;
-            int minX = (static_cast<int>(16.0f * std::min({ x1, x2, x3 })) + 0x0f) >> 4;
-            int maxX = (static_cast<int>(16.0f * std::max({ x1, x2, x3 })) + 0x0f) >> 4;
+            flushBatch();
+        }
+    }
 
-            // Perform scissoring
-            if (scissor.isEnabled()) {
+    void Renderer::flushBatch() {
 
-                scissor.cut(minX, minY, maxX, maxY);
-            }
+        if (m_batchTriangles.empty()) {
 
-            // Don't bother to bin triangles that have a zero sized bounding box
-            if (minX >= maxX || minY >= maxY) {
+            m_batchStateBlock = nullptr;
+            return;
+        }
 
-                continue;
-            }
+        // Create the data that is shared by different drawing threads
+        // and is used to draw the triangles
+        auto &arena = getCommandArena();
+        auto drawState = arena.create<TriangleDrawCallState>();
 
-            //
-            // Add the triangle into the corresponding bin(s)
-            //
-            int binStartY = std::max(minY / binHeight, 0);
-            int binEndY = std::min((maxY + binHeight - 1) / binHeight, numBinsY);
-            int binStartX = std::max(minX / binWidth, 0);
-            int binEndX = std::min((maxX + binWidth - 1) / binWidth, numBinsX);
+        drawState->triangles = std::move(m_batchTriangles);
+        drawState->stateBlock = m_batchStateBlock;
+        drawState->setup.allocate(arena, *drawState->stateBlock, static_cast<int>(drawState->triangles.size()));
 
-            for (int y = binStartY; y < binEndY; y++) {
+        m_batchTriangles.clear();
+        m_batchStateBlock = nullptr;
 
-                int idxStart = binStartX + (y * numBinsX);
-                int idxEnd = binEndX + (y * numBinsX);
 
-                for (int idx = idxStart; idx < idxEnd; idx++) {
+        // Figure out which triangle must be rendered by which tile and estimate how
+        // much work that is for every tile
+        m_binner.binTriangles(
 
-                    bins[idx].emplace_back(i);
-                }
-            }
-        }
+            *drawState,
+            m_drawSurface.getNumTilesInX(),
+            m_drawSurface.getNumTilesInY(),
+            m_drawSurface.getTileSize()
+        );
 
         // Add draw command
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
+        auto tileSize = m_drawSurface.getTileSize();
+        auto numTilesX = m_drawSurface.getNumTilesInX();
+        auto drawMinX = std::numeric_limits<int>::max(), drawMinY = std::numeric_limits<int>::max();
+        auto drawMaxX = 0, drawMaxY = 0;
 
-            if (!bins[i].empty()) {
+        for (int i = 0, n = m_drawSurface.getNumTiles(); i < n; i++) {
 
-                m_drawThreads[i]->addCommand(
+            auto &indices = m_binner.getIndices(i);
+            if (!indices.empty()) {
 
-                    std::make_unique<CommandDrawTriangle>(
+                auto tileX = (i % numTilesX) * tileSize;
+                auto tileY = (i / numTilesX) * tileSize;
 
-                        drawState, bins[i]
+                drawMinX = std::min(drawMinX, tileX);
+                drawMinY = std::min(drawMinY, tileY);
+                drawMaxX = std::max(drawMaxX, tileX + tileSize);
+                drawMaxY = std::max(drawMaxY, tileY + tileSize);
+
+                auto numIndices = static_cast<int>(indices.size());
+                auto arenaIndices = arena.allocateArray<int>(numIndices);
+                std::copy(indices.begin(), indices.end(), arenaIndices);
+
+                addCommand(
+
+                    m_drawSurface.getTile(i),
+                    Command(
+
+                        CommandDrawTriangle(drawState, arenaIndices, numIndices),
+                        m_binner.getCost(i)
                     )
                 );
             }
         }
+
+        // Remember where the textures are used, so updating them later only has to
+        // wait for these tiles
+        for (auto &texState : drawState->stateBlock->textures) {
+
+            if (texState.texData != nullptr) {
+
+                auto &texData = *texState.texData;
+
+                texData.drawMinX = std::min(texData.drawMinX, drawMinX);
+                texData.drawMinY = std::min(texData.drawMinY, drawMinY);
+                texData.drawMaxX = std::max(texData.drawMaxX, drawMaxX);
+                texData.drawMaxY = std::max(texData.drawMaxY, drawMaxY);
+            }
+        }
+    }
+
+    void Renderer::flush() {
+
+        // Get the drawing threads going on everything that has been issued so far
+        flushBatch();
+        kickPendingTiles();
     }
 
     void Renderer::finish() {
@@ -207,40 +252,237 @@ namespace SWGL {
 
     void Renderer::swapBuffers() {
 
-        synchronize();
-        m_drawSurface.swap();
-    }
+        flushBatch();
 
-    void Renderer::shutdown() {
+        // Every tile copies its part of the frame into the frame image. The presenter
+        // takes over once all tiles are done, in the meantime the next frame can
+        // already be drawn.
+        auto &frameLatch = m_presenter.getFrameLatch();
+        auto frameImage = m_drawSurface.getFrameImage(m_presenter.getCurrentFrame());
+        auto frameImageWidth = m_drawSurface.getFrameImageWidth();
+        auto numTiles = m_drawSurface.getNumTiles();
 
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
+        frameLatch.reset(numTiles);
 
-            m_drawThreads[i]->addCommand(
+        for (int i = 0; i < numTiles; i++) {
 
-                std::make_unique<CommandPoisonPill>()
+            addCommand(
+
+                m_drawSurface.getTile(i),
+                Command(CommandPresent(frameLatch, frameImage, frameImageWidth))
             );
         }
 
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
+        m_presenter.presentFrame();
+        m_loadBalancer.rebalance(m_drawSurface);
+        updateCostModel();
+
+        // The commands of the frame that was drawn the last time into the current
+        // frame image are done, so its arena can be reused
+        getCommandArena().reset();
+        m_drawStateCache.endFrame();
+        STATISTICS_END_FRAME();
+
+        // Resizing recreates the tiles, so all frames in flight have to be
+        // presented before
+        if (m_drawSurface.isResizeNeeded()) {
+
+            m_presenter.waitIdle();
+            m_drawSurface.updateDimensions();
+            m_loadBalancer.reset();
+        }
+    }
+
+    void Renderer::shutdown() {
+
+        drain();
+        m_presenter.stop();
+
+        std::lock_guard<std::mutex> cs(m_drawClientMutex);
+        m_drawThreadPool.detach(m_drawClient);
+        m_drawClient = nullptr;
+    }
+
+
+
+    void Renderer::setHDC(HDC hdc) {
+
+        drain();
+        m_drawSurface.setHDC(hdc);
+        m_loadBalancer.reset();
+    }
+
+    void Renderer::setPriority(int priority) {
+
+        priority = std::clamp(priority, 1, SWGL_MAX_CONTEXT_PRIORITY);
+        m_priority.store(priority, std::memory_order_relaxed);
+
+        // A client which is attached later on picks up the new priority
+        std::lock_guard<std::mutex> cs(m_drawClientMutex);
+        if (m_drawClient != nullptr) {
 
-            m_drawThreads[i]->join();
+            m_drawClient->priority.store(priority, std::memory_order_relaxed);
         }
     }
 
 
 
+    void Renderer::drain() {
+
+        synchronize();
+        m_presenter.waitIdle();
+    }
+
     void Renderer::synchronize() {
 
-        m_latch.reset(SWGL_NUM_DRAW_THREADS);
+        insertFence(m_fence, 0, 0, m_drawSurface.getWidth(), m_drawSurface.getHeight());
+        m_fence.wait();
 
-        for (auto i = 0U; i < SWGL_NUM_DRAW_THREADS; i++) {
+        updateCostModel();
+    }
+
+    void Renderer::setFence(const FencePtr &fence) {
+
+        // The commands refer to the fence, so the arena keeps it alive until they
+        // are executed, even if the application deletes it in the meantime
+        getCommandArena().create<FencePtr>(fence);
+
+        insertFence(*fence, 0, 0, m_drawSurface.getWidth(), m_drawSurface.getHeight());
+    }
+
+    void Renderer::waitForTexture(TextureData &texData) {
 
-            m_drawThreads[i]->addCommand(
+        // The open batch may use the texture as well, and its draw rectangle is only
+        // known once it has been flushed
+        flushBatch();
 
-                std::make_unique<CommandSynchronize>(m_latch)
+        if (texData.drawMinX >= texData.drawMaxX ||
+            texData.drawMinY >= texData.drawMaxY) {
+
+            return;
+        }
+
+        // Only the tiles that have drawn with the texture have to be done
+        insertFence(m_fence, texData.drawMinX, texData.drawMinY, texData.drawMaxX, texData.drawMaxY);
+        m_fence.wait();
+
+        texData.drawMinX = texData.drawMinY = std::numeric_limits<int>::max();
+        texData.drawMaxX = texData.drawMaxY = 0;
+    }
+
+    void Renderer::insertFence(Fence &fence, int minX, int minY, int maxX, int maxY) {
+
+        // The fence has to come after the draw calls that have been issued so far
+        flushBatch();
+
+        // All tiles must be counted before the first one can signal the fence
+        auto numTiles = 0;
+        forEachTile(minX, minY, maxX, maxY, [&](int tileIdx) {
+
+            numTiles++;
+        });
+
+        fence.reset(numTiles);
+
+        forEachTile(minX, minY, maxX, maxY, [&](int tileIdx) {
+
+            addCommand(
+
+                m_drawSurface.getTile(tileIdx),
+                Command(CommandSynchronize(fence.getLatch()))
             );
+        });
+    }
+
+
+
+    void Renderer::addCommand(Tile &tile, Command command) {
+
+        auto isFlushingQueue = command.isFlushingQueue();
+        auto &workloadEstimate = tile.getWorkloadEstimate();
+        auto commandEstimate = command.getWorkLoadEstimate();
+
+        STATISTICS_ADD(COMMANDS, 1);
+
+        // The work of a tile is batched up until it pays off to wake up a drawing thread,
+        // so the threads neither get woken up for every tiny command nor sit idle while a
+        // huge draw call is waiting in the queue.
+        workloadEstimate += commandEstimate;
+        m_pendingWorkload += commandEstimate;
+
+        // Make sure that somebody works on the tile while its queue is full and wait
+        // until there is space again
+        if (!tile.push(command)) {
+
+#if SWGL_ENABLE_STATISTICS
+            auto stallStartTime = std::chrono::steady_clock::now();
+#endif
+
+            kickTile(tile);
+            tile.pushWaiting(command);
+
+#if SWGL_ENABLE_STATISTICS
+            auto stallTime = std::chrono::steady_clock::now() - stallStartTime;
+
+            STATISTICS_ADD(PRODUCER_STALLS, 1);
+            STATISTICS_ADD(PRODUCER_STALL_NS, std::chrono::duration_cast<std::chrono::nanoseconds>(stallTime).count());
+#endif
         }
 
-        m_latch.wait();
+        if (isFlushingQueue || m_costModel.isWorthWakeUp(workloadEstimate)) {
+
+            m_pendingWorkload -= workloadEstimate;
+            workloadEstimate = 0;
+            kickTile(tile);
+        }
+        else if (m_costModel.isWorthWakeUp(m_pendingWorkload / m_drawThreadPool.getNumThreads())) {
+
+            // Many tiles with a little bit of work each add up as well. Start all
+            // threads once there is enough work pending to keep every one of them busy.
+            kickPendingTiles();
+        }
+    }
+
+    void Renderer::kickTile(Tile &tile) {
+
+        m_drawThreadPool.wakeUp(tile.getHomeThread());
+    }
+
+    void Renderer::kickPendingTiles() {
+
+        for (int i = 0, n = m_drawSurface.getNumTiles(); i < n; i++) {
+
+            m_drawSurface.getTile(i).getWorkloadEstimate() = 0;
+        }
+        m_pendingWorkload = 0;
+
+        // The threads pick up the pending tiles of the others once they are done
+        // with their own ones
+        m_drawThreadPool.wakeUpAll();
+    }
+
+    void Renderer::updateCostModel() {
+
+        // Feed the execution times back so the cost model learns how long the
+        // commands actually take
+        m_costModel.addMeasurement(
+
+            m_drawClient->measuredUnits.exchange(0, std::memory_order_relaxed),
+            m_drawClient->measuredTime.exchange(0, std::memory_order_relaxed)
+        );
+    }
+
+    int Renderer::getCoveredArea(int tileIdx, int minX, int minY, int maxX, int maxY) {
+
+        auto tileSize = m_drawSurface.getTileSize();
+        auto numTilesX = m_drawSurface.getNumTilesInX();
+
+        int tileMinX = (tileIdx % numTilesX) * tileSize;
+        int tileMinY = (tileIdx / numTilesX) * tileSize;
+
+        int width = std::min(maxX, tileMinX + tileSize) - std::max(minX, tileMinX);
+        int height = std::min(maxY, tileMinY + tileSize) - std::max(minY, tileMinY);
+
+        return std::max(width, 0) * std::max(height, 0);
     }
 }
@@ -1,17 +1,32 @@
 ﻿#pragma once
 
 #include <Windows.h>
+#include <algorithm>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <mutex>
 #include "Triangle.h"
 #include "DrawSurface.h"
-#include "DrawThread.h"
-#include "CountDownLatch.h"
+#include "DrawThreadPool.h"
+#include "Command.h"
+#include "CommandArena.h"
+#include "CostModel.h"
+#include "Binner.h"
+#include "DrawStateCache.h"
+#include "LoadBalancer.h"
+#include "Presenter.h"
+#include "Fence.h"
 
 namespace SWGL {
 
+    // Forward declarations
+    struct TextureData;
+
     //
-    // Implements the renderer which feeds the drawing threads with commands
+    // Implements the renderer which feeds the drawing threads with commands. The
+    // drawing threads are shared with the renderers of the other contexts (see
+    // DrawThreadPool).
     //
     class Renderer {
 
@@ -24,19 +39,88 @@ namespace SWGL {
         void clearColorBuffer();
         void clearDepthBuffer();
         void drawTriangles(TriangleList &triangles);
+        void flush();
         void finish();
         void swapBuffers();
         void shutdown();
+        void setHDC(HDC hdc);
+
+    public:
+        void setFence(const FencePtr &fence);
+        void waitForTexture(TextureData &texData);
 
     public:
         DrawSurface &getDrawSurface() { return m_drawSurface; }
+        ThreadPool &getThreadPool() { return m_drawThreadPool.getThreadPool(); }
+
+        // The share of the drawing threads the context gets compared to other contexts.
+        // Unlike the other members this may be called from any thread.
+        void setPriority(int priority);
+
+        // Has to be called whenever state that ends up in a DrawStateBlock changes
+        void invalidateDrawState() { m_drawStateCache.invalidate(); }
+
+    private:
+        void flushBatch();
+        TriangleList m_batchTriangles;
+        DrawStateBlock *m_batchStateBlock;
 
     private:
         void synchronize();
-        CountDownLatch m_latch;
+        void drain();
+        void insertFence(Fence &fence, int minX, int minY, int maxX, int maxY);
+        Fence m_fence;
+
+    private:
+        void addCommand(Tile &tile, Command command);
+        void kickTile(Tile &tile);
+        void kickPendingTiles();
+        void updateCostModel();
+        int getCoveredArea(int tileIdx, int minX, int minY, int maxX, int maxY);
+
+        template<typename Function>
+        void forEachTile(int minX, int minY, int maxX, int maxY, Function function) {
+
+            auto tileSize = m_drawSurface.getTileSize();
+            auto numTilesX = m_drawSurface.getNumTilesInX();
+
+            int tileStartY = std::max(minY / tileSize, 0);
+            int tileEndY = std::min((maxY + tileSize - 1) / tileSize, m_drawSurface.getNumTilesInY());
+            int tileStartX = std::max(minX / tileSize, 0);
+            int tileEndX = std::min((maxX + tileSize - 1) / tileSize, numTilesX);
+
+            for (int y = tileStartY; y < tileEndY; y++) {
+
+                for (int x = tileStartX; x < tileEndX; x++) {
+
+                    function(x + (y * numTilesX));
+                }
+            }
+        }
 
     private:
-        std::vector<DrawThreadPtr> m_drawThreads;
+        DrawThreadPool &m_drawThreadPool;
+        DrawClientPtr m_drawClient;
+        std::atomic<int> m_priority;
+
+        // The priority may be set by any thread (see wglSetContextPrioritySWGL), so the
+        // draw client is only attached and detached while this is locked
+        std::mutex m_drawClientMutex;
         DrawSurface m_drawSurface;
+
+    private:
+        CostModel m_costModel;
+        LoadBalancer m_loadBalancer;
+        long long m_pendingWorkload;
+
+    private:
+        Binner m_binner;
+        Presenter m_presenter;
+        DrawStateCache m_drawStateCache;
+
+    private:
+        // Every frame in flight has its own arena
+        CommandArena &getCommandArena() { return m_commandArenas[m_presenter.getCurrentFrame()]; }
+        CommandArena m_commandArenas[SWGL_MAX_FRAMES_IN_FLIGHT];
     };
 }
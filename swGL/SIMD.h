@@ -12,13 +12,37 @@
 #define _mm_cmpneq_epi32(a, b) \
     _mm_xor_si128(_mm_cmpeq_epi32(a, b), _mm_setallones_si128())
 
+// The instruction set the helpers are compiled for. Only the kernels (see Kernels.inl)
+// define a higher level, everything else must run on any CPU with SSE2.
+#ifndef SWGL_SIMD_LEVEL
+#define SWGL_SIMD_LEVEL SWGL_SIMD_SSE2
+#endif
+
+// The helpers of each level live in their own namespace, so the linker never mixes
+// up the copies of different translation units
+#if SWGL_SIMD_LEVEL == SWGL_SIMD_SSE2
+#define SWGL_SIMD_NAMESPACE SSE2
+#elif SWGL_SIMD_LEVEL == SWGL_SIMD_SSE41
+#define SWGL_SIMD_NAMESPACE SSE41
+#elif SWGL_SIMD_LEVEL == SWGL_SIMD_AVX2
+#define SWGL_SIMD_NAMESPACE AVX2
+#else
+#define SWGL_SIMD_NAMESPACE AVX512
+#endif
+
 namespace SWGL {
 
     using QFloat = __m128;
     using QInt = __m128i;
 
+    // Two quads side by side (see SIMDAVX2.h)
+    using OFloat = __m256;
+    using OInt = __m256i;
+
     namespace SIMD {
 
+    inline namespace SWGL_SIMD_NAMESPACE {
+
         template<int idx>
         INLINED float extract(QFloat value) {
 
@@ -34,8 +58,11 @@ namespace SWGL {
         template<int idx>
         INLINED int extract(QInt value) {
 
-            //return _mm_cvtsi128_si32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 0, 0, idx)));
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
             return _mm_extract_epi32(value, idx);
+        #else
+            return _mm_cvtsi128_si32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 0, 0, idx)));
+        #endif
         }
 
         template<>
@@ -59,9 +86,27 @@ namespace SWGL {
             return _mm_max_ps(_mm_min_ps(value, max), min);
         }
 
+        INLINED QInt min(QInt valueA, QInt valueB) {
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
+            return _mm_min_epi32(valueA, valueB);
+        #else
+            QInt mask = _mm_cmpgt_epi32(valueA, valueB);
+            return _mm_or_si128(_mm_and_si128(mask, valueB), _mm_andnot_si128(mask, valueA));
+        #endif
+        }
+
+        INLINED QInt max(QInt valueA, QInt valueB) {
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
+            return _mm_max_epi32(valueA, valueB);
+        #else
+            QInt mask = _mm_cmpgt_epi32(valueA, valueB);
+            return _mm_or_si128(_mm_and_si128(mask, valueA), _mm_andnot_si128(mask, valueB));
+        #endif
+        }
+
         INLINED QInt clamp(QInt value, QInt min, QInt max) {
 
-            return _mm_max_epi32(_mm_min_epi32(value, max), min);
+            return SIMD::max(SIMD::min(value, max), min);
         }
 
         INLINED QFloat clamp01(QFloat value) {
@@ -72,16 +117,20 @@ namespace SWGL {
             return _mm_max_ps(_mm_min_ps(value, one), zero);
         }
 
+        // The mask must be all zeros or all ones per lane (SSE2 has no variable blend)
         INLINED QFloat blend(QFloat valueA, QFloat valueB, QFloat mask) {
-
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
             return _mm_blendv_ps(valueA, valueB, mask);
+        #else
+            return _mm_or_ps(_mm_and_ps(mask, valueB), _mm_andnot_ps(mask, valueA));
+        #endif
         }
 
         INLINED QInt blend(QInt valueA, QInt valueB, QInt mask) {
 
             return _mm_castps_si128(
 
-                _mm_blendv_ps(
+                blend(
             
                     _mm_castsi128_ps(valueA),
                     _mm_castsi128_ps(valueB),
@@ -99,9 +148,34 @@ namespace SWGL {
             );
         }
 
+        // Returns true if all bits of the value are zero
+        INLINED bool isZero(QInt value) {
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
+            return _mm_testz_si128(value, value) != 0;
+        #else
+            return _mm_movemask_epi8(_mm_cmpeq_epi32(value, _mm_setzero_si128())) == 0xffff;
+        #endif
+        }
+
+        // Multiplies the lanes and keeps the lower 32 bits of the products
+        INLINED QInt multiply(QInt valueA, QInt valueB) {
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
+            return _mm_mullo_epi32(valueA, valueB);
+        #else
+            QInt even = _mm_mul_epu32(valueA, valueB);
+            QInt odd = _mm_mul_epu32(_mm_srli_epi64(valueA, 32), _mm_srli_epi64(valueB, 32));
+
+            return _mm_unpacklo_epi32(
+
+                _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+            );
+        #endif
+        }
+
         INLINED QInt multiplyAdd(QInt valueA, QInt valueB, QInt valueC) {
 
-            return _mm_add_epi32(_mm_mullo_epi32(valueA, valueB), valueC);
+            return _mm_add_epi32(multiply(valueA, valueB), valueC);
         }
 
         INLINED QFloat multiplyAdd(QFloat valueA, QFloat valueB, QFloat valueC) {
@@ -111,7 +185,7 @@ namespace SWGL {
 
         INLINED QInt multiplySub(QInt valueA, QInt valueB, QInt valueC) {
 
-            return _mm_sub_epi32(_mm_mullo_epi32(valueA, valueB), valueC);
+            return _mm_sub_epi32(multiply(valueA, valueB), valueC);
         }
 
         INLINED QFloat multiplySub(QFloat valueA, QFloat valueB, QFloat valueC) {
@@ -125,8 +199,8 @@ namespace SWGL {
         }
 
         INLINED QInt gather(const int *base, QInt index) {
-        #if defined(__AVX2__) && SWGL_USE_AVX2_GATHER
-            return _mm_i32gather_epi32(base, index, 1);
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2 && SWGL_USE_AVX2_GATHER
+            return _mm_i32gather_epi32(base, index, 4);
         #else
             return _mm_set_epi32(
 
@@ -138,14 +212,23 @@ namespace SWGL {
         #endif
         }
 
+        // Without SSE4.1 the value must fit into an int
         INLINED QFloat floor(QFloat value) {
-
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
             return _mm_round_ps(value, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        #else
+            QFloat truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
+            return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, value), _mm_set1_ps(1.0f)));
+        #endif
         }
 
         INLINED QFloat ceil(QFloat value) {
-
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_SSE41
             return _mm_round_ps(value, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+        #else
+            QFloat truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
+            return _mm_add_ps(truncated, _mm_and_ps(_mm_cmplt_ps(truncated, value), _mm_set1_ps(1.0f)));
+        #endif
         }
 
         INLINED QFloat dot3(QFloat x1, QFloat x2, QFloat y1, QFloat y2, QFloat z1, QFloat z2) {
@@ -166,5 +249,46 @@ namespace SWGL {
 
             return _mm_mul_ps(four, _mm_add_ps(_mm_add_ps(d1, d2), d3));
         }
+
+        //
+        // Scalar helpers for the kernels, which must not instantiate std::min, std::floor
+        // and the like. The linker would keep only one copy of those for all instruction
+        // sets (see Kernels.inl).
+        //
+        INLINED int min(int valueA, int valueB) {
+
+            return (valueB < valueA) ? valueB : valueA;
+        }
+
+        INLINED int max(int valueA, int valueB) {
+
+            return (valueA < valueB) ? valueB : valueA;
+        }
+
+        INLINED float min(float valueA, float valueB) {
+
+            return (valueB < valueA) ? valueB : valueA;
+        }
+
+        INLINED float max(float valueA, float valueB) {
+
+            return (valueA < valueB) ? valueB : valueA;
+        }
+
+        INLINED float absolute(float value) {
+
+            return _mm_cvtss_f32(absolute(_mm_set_ss(value)));
+        }
+
+        INLINED float floor(float value) {
+
+            return _mm_cvtss_f32(floor(_mm_set_ss(value)));
+        }
+
+        INLINED float ceil(float value) {
+
+            return _mm_cvtss_f32(ceil(_mm_set_ss(value)));
+        }
+    }
     }
 }
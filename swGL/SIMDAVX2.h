@@ -0,0 +1,132 @@
+﻿#pragma once
+
+#include "SIMD.h"
+
+//
+// The AVX2 counterparts of the SIMD helpers, which work on two 2x2 quads at once.
+// This header must only be included by the kernels that are compiled with AVX2 or
+// AVX-512 enabled, and those are only entered if the CPU supports it (see
+// Configuration::getSIMDLevel()).
+//
+#define _mm256_setallones_si256() \
+    _mm256_cmpeq_epi32(_mm256_setzero_si256(), _mm256_setzero_si256())
+#define _mm256_cmplt_epi32(a, b) \
+    _mm256_cmpgt_epi32(b, a)
+
+namespace SWGL {
+
+    namespace SIMD {
+
+    inline namespace SWGL_SIMD_NAMESPACE {
+
+        INLINED QFloat lower(OFloat value) {
+
+            return _mm256_castps256_ps128(value);
+        }
+
+        INLINED QFloat upper(OFloat value) {
+
+            return _mm256_extractf128_ps(value, 1);
+        }
+
+        INLINED OFloat combine(QFloat lower, QFloat upper) {
+
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(lower), upper, 1);
+        }
+
+        INLINED OFloat absolute(OFloat value) {
+
+            return _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_set1_epi32(0x80000000)), value);
+        }
+
+        INLINED OFloat clamp(OFloat value, OFloat min, OFloat max) {
+
+            return _mm256_max_ps(_mm256_min_ps(value, max), min);
+        }
+
+        INLINED OInt clamp(OInt value, OInt min, OInt max) {
+
+            return _mm256_max_epi32(_mm256_min_epi32(value, max), min);
+        }
+
+        INLINED OFloat clamp01(OFloat value) {
+
+            const OFloat zero = _mm256_setzero_ps();
+            const OFloat one = _mm256_set1_ps(1.0f);
+
+            return _mm256_max_ps(_mm256_min_ps(value, one), zero);
+        }
+
+        INLINED OFloat blend(OFloat valueA, OFloat valueB, OFloat mask) {
+
+            return _mm256_blendv_ps(valueA, valueB, mask);
+        }
+
+        INLINED OInt blend(OInt valueA, OInt valueB, OInt mask) {
+
+            return _mm256_castps_si256(
+
+                _mm256_blendv_ps(
+
+                    _mm256_castsi256_ps(valueA),
+                    _mm256_castsi256_ps(valueB),
+                    _mm256_castsi256_ps(mask)
+                )
+            );
+        }
+
+        INLINED OInt mask(OInt valueA, OInt valueB, OInt mask) {
+        #if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX512
+            return _mm256_ternarylogic_epi32(mask, valueA, valueB, 0xca);
+        #else
+            return _mm256_or_si256(
+
+                _mm256_and_si256(mask, valueA),
+                _mm256_andnot_si256(mask, valueB)
+            );
+        #endif
+        }
+
+        INLINED OInt multiplyAdd(OInt valueA, OInt valueB, OInt valueC) {
+
+            return _mm256_add_epi32(_mm256_mullo_epi32(valueA, valueB), valueC);
+        }
+
+        INLINED OFloat multiplyAdd(OFloat valueA, OFloat valueB, OFloat valueC) {
+
+            return _mm256_add_ps(_mm256_mul_ps(valueA, valueB), valueC);
+        }
+
+        INLINED OFloat lerp(OFloat t, OFloat valueA, OFloat valueB) {
+
+            return multiplyAdd(t, _mm256_sub_ps(valueB, valueA), valueA);
+        }
+
+        INLINED OInt gather(const int *base, OInt index) {
+        #if SWGL_USE_AVX2_GATHER
+            return _mm256_i32gather_epi32(base, index, 4);
+        #else
+            QInt lower = _mm256_castsi256_si128(index);
+            QInt upper = _mm256_extracti128_si256(index, 1);
+
+            return _mm256_set_epi32(
+
+                base[_mm_extract_epi32(upper, 3)],
+                base[_mm_extract_epi32(upper, 2)],
+                base[_mm_extract_epi32(upper, 1)],
+                base[_mm_cvtsi128_si32(upper)],
+                base[_mm_extract_epi32(lower, 3)],
+                base[_mm_extract_epi32(lower, 2)],
+                base[_mm_extract_epi32(lower, 1)],
+                base[_mm_cvtsi128_si32(lower)]
+            );
+        #endif
+        }
+
+        INLINED OFloat floor(OFloat value) {
+
+            return _mm256_round_ps(value, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        }
+    }
+    }
+}
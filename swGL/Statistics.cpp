@@ -0,0 +1,63 @@
+﻿#include "Log.h"
+#include "Statistics.h"
+
+namespace SWGL {
+
+    // Names of the counters in the log file
+    static const char *COUNTER_NAMES[Statistics::NUM_COUNTERS] = {
+
+        "Commands",
+        "Arena bytes",
+        "Arena block allocations",
+        "Wake ups",
+        "Wake up latency (ns)",
+        "Producer stalls",
+        "Producer stall time (ns)",
+        "Tile migrations",
+        "Draw state blocks built",
+        "Draw calls",
+        "Merged draw calls",
+        "Generic raster op draw calls"
+    };
+
+
+
+    Statistics::Statistics()
+
+        : m_numFrames(0) {
+
+        for (auto &counter : m_counters) {
+
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+
+
+    Statistics &Statistics::getInstance() {
+
+        static Statistics instance;
+        return instance;
+    }
+
+
+
+    void Statistics::endFrame() {
+
+        if (++m_numFrames < SWGL_STATISTICS_INTERVAL) {
+
+            return;
+        }
+
+        auto &log = Log::getInstance();
+        log.printf("Statistics (average per frame over %d frames):\n", m_numFrames);
+
+        for (int i = 0; i < NUM_COUNTERS; i++) {
+
+            auto value = m_counters[i].exchange(0, std::memory_order_relaxed);
+            log.printf("    %-32s %12.1f\n", COUNTER_NAMES[i], static_cast<double>(value) / m_numFrames);
+        }
+
+        m_numFrames = 0;
+    }
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include <atomic>
+#include "Defines.h"
+
+#if SWGL_ENABLE_STATISTICS
+#define STATISTICS_ADD(COUNTER, VALUE) SWGL::Statistics::getInstance().add(SWGL::Statistics::COUNTER, VALUE)
+#define STATISTICS_END_FRAME() SWGL::Statistics::getInstance().endFrame()
+#else
+#define STATISTICS_ADD(COUNTER, VALUE) (void)0
+#define STATISTICS_END_FRAME() (void)0
+#endif
+
+namespace SWGL {
+
+    //
+    // Counters to measure the behaviour of the renderer. The averages per frame are
+    // written into the log file every SWGL_STATISTICS_INTERVAL frames.
+    //
+    class Statistics {
+
+    public:
+        enum Counter {
+
+            COMMANDS,
+            ARENA_BYTES,
+            ARENA_BLOCK_ALLOCATIONS,
+            WAKE_UPS,
+            WAKE_UP_LATENCY_NS,
+            PRODUCER_STALLS,
+            PRODUCER_STALL_NS,
+            TILE_MIGRATIONS,
+            DRAW_STATE_BLOCKS,
+            DRAW_CALLS,
+            MERGED_DRAW_CALLS,
+            GENERIC_DRAW_CALLS,
+            NUM_COUNTERS
+        };
+
+    public:
+        ~Statistics() = default;
+
+        static Statistics &getInstance();
+
+    public:
+        void add(Counter counter, long long value) {
+
+            m_counters[counter].fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void endFrame();
+
+    private:
+        Statistics();
+
+    private:
+        std::atomic<long long> m_counters[NUM_COUNTERS];
+        int m_numFrames;
+    };
+}
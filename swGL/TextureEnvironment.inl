@@ -0,0 +1,411 @@
+﻿#pragma once
+
+#include "SIMD.h"
+#include "OpenGL.h"
+#include "TextureManager.h"
+#include "Kernels.h"
+
+#if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2
+#include "SIMDAVX2.h"
+#endif
+
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    //
+    // Texture functions (see glTexEnv()). Every mode and texture format, and every pair
+    // of combine modes, has its own kernel, so the draw triangle kernels only call the
+    // one of a texture unit instead of interpreting the environment for every quad.
+    // The kernel is picked once for each state block (see selectTexEnv()). The modes
+    // besides GL_COMBINE are compiled for a quad (ARGBColor) and, with AVX2, for a pair
+    // of quads (ARGBColor8) as well.
+    //
+    template<typename Color>
+    using TexEnvFunction = void (*)(const TextureEnvironment &texEnv, const Color &texColor, const Color &primaryColor, Color &color);
+
+    static INLINED QFloat multiply(QFloat valueA, QFloat valueB) { return _mm_mul_ps(valueA, valueB); }
+    static INLINED QFloat addSaturated(QFloat valueA, QFloat valueB) { return _mm_min_ps(_mm_set1_ps(1.0f), _mm_add_ps(valueA, valueB)); }
+    static INLINED QFloat lerpConstant(QFloat t, QFloat value, float constant) { return SIMD::lerp(t, value, _mm_set1_ps(constant)); }
+
+#if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2
+    static INLINED OFloat multiply(OFloat valueA, OFloat valueB) { return _mm256_mul_ps(valueA, valueB); }
+    static INLINED OFloat addSaturated(OFloat valueA, OFloat valueB) { return _mm256_min_ps(_mm256_set1_ps(1.0f), _mm256_add_ps(valueA, valueB)); }
+    static INLINED OFloat lerpConstant(OFloat t, OFloat value, float constant) { return SIMD::lerp(t, value, _mm256_set1_ps(constant)); }
+#endif
+
+    template<typename Color>
+    static void keepColor(const TextureEnvironment &texEnv, const Color &texColor, const Color &primaryColor, Color &color) {
+
+    }
+
+    template<GLenum Mode, TextureBaseFormat Format, typename Color>
+    static void applyTexEnv(const TextureEnvironment &texEnv, const Color &texColor, const Color &primaryColor, Color &color) {
+
+        constexpr bool hasAlpha = Format == TextureBaseFormat::Alpha ||
+                                  Format == TextureBaseFormat::LuminanceAlpha ||
+                                  Format == TextureBaseFormat::Intensity ||
+                                  Format == TextureBaseFormat::RGBA;
+        constexpr bool hasColor = Format != TextureBaseFormat::Alpha;
+
+        if constexpr (Mode == GL_REPLACE) {
+
+            if constexpr (hasAlpha) {
+
+                color.a = texColor.a;
+            }
+
+            if constexpr (hasColor) {
+
+                color.r = texColor.r;
+                color.g = texColor.g;
+                color.b = texColor.b;
+            }
+        }
+        else if constexpr (Mode == GL_MODULATE) {
+
+            if constexpr (hasAlpha) {
+
+                color.a = multiply(color.a, texColor.a);
+            }
+
+            if constexpr (hasColor) {
+
+                color.r = multiply(color.r, texColor.r);
+                color.g = multiply(color.g, texColor.g);
+                color.b = multiply(color.b, texColor.b);
+            }
+        }
+        else if constexpr (Mode == GL_DECAL) {
+
+            // Undefined for the formats besides RGB and RGBA
+            if constexpr (Format == TextureBaseFormat::RGB) {
+
+                color.r = texColor.r;
+                color.g = texColor.g;
+                color.b = texColor.b;
+            }
+            else if constexpr (Format == TextureBaseFormat::RGBA) {
+
+                color.r = SIMD::lerp(texColor.a, color.r, texColor.r);
+                color.g = SIMD::lerp(texColor.a, color.g, texColor.g);
+                color.b = SIMD::lerp(texColor.a, color.b, texColor.b);
+            }
+        }
+        else if constexpr (Mode == GL_ADD) {
+
+            // Intensity adds the alpha as well, the other formats multiply it
+            if constexpr (Format == TextureBaseFormat::Intensity) {
+
+                color.a = addSaturated(color.a, texColor.a);
+            }
+            else if constexpr (hasAlpha) {
+
+                color.a = multiply(color.a, texColor.a);
+            }
+
+            if constexpr (hasColor) {
+
+                color.r = addSaturated(color.r, texColor.r);
+                color.g = addSaturated(color.g, texColor.g);
+                color.b = addSaturated(color.b, texColor.b);
+            }
+        }
+        else if constexpr (Mode == GL_BLEND) {
+
+            // Intensity blends the alpha as well, the other formats multiply it
+            if constexpr (Format == TextureBaseFormat::Intensity) {
+
+                color.a = lerpConstant(texColor.a, color.a, texEnv.colorConstA);
+            }
+            else if constexpr (hasAlpha) {
+
+                color.a = multiply(color.a, texColor.a);
+            }
+
+            if constexpr (hasColor) {
+
+                color.r = lerpConstant(texColor.r, color.r, texEnv.colorConstR);
+                color.g = lerpConstant(texColor.g, color.g, texEnv.colorConstG);
+                color.b = lerpConstant(texColor.b, color.b, texEnv.colorConstB);
+            }
+        }
+    }
+
+    // The number of arguments of a combine mode
+    constexpr int getNumCombineArgs(GLenum mode) {
+
+        return (mode == GL_REPLACE) ? 1 : (mode == GL_INTERPOLATE) ? 3 : 2;
+    }
+
+    template<GLenum ModeRGB, GLenum ModeAlpha>
+    static void applyCombine(const TextureEnvironment &texEnv, const ARGBColor &texColor, const ARGBColor &primaryColor, ARGBColor &color) {
+
+        ARGBColor args[3], result;
+
+        //
+        // Alpha
+        //
+        if constexpr (ModeRGB != GL_DOT3_RGBA) {
+
+            // Read argument(s) and apply the modifiers
+            for (int argIdx = 0; argIdx < getNumCombineArgs(ModeAlpha); argIdx++) {
+
+                auto &arg = args[argIdx];
+
+                switch (texEnv.sourceAlpha[argIdx]) {
+
+                case GL_TEXTURE:
+                    arg.a = texColor.a;
+                    break;
+
+                case GL_CONSTANT:
+                    arg.a = _mm_set1_ps(texEnv.colorConstA);
+                    break;
+
+                case GL_PRIMARY_COLOR:
+                    arg.a = primaryColor.a;
+                    break;
+
+                case GL_PREVIOUS:
+                    arg.a = color.a;
+                    break;
+                }
+
+                if (texEnv.operandAlpha[argIdx] == GL_ONE_MINUS_SRC_ALPHA) {
+
+                    arg.a = _mm_sub_ps(_mm_set1_ps(1.0f), arg.a);
+                }
+            }
+
+            // Combine alpha
+            if constexpr (ModeAlpha == GL_REPLACE) {
+
+                result.a = args[0].a;
+            }
+            else if constexpr (ModeAlpha == GL_MODULATE) {
+
+                result.a = _mm_mul_ps(args[0].a, args[1].a);
+            }
+            else if constexpr (ModeAlpha == GL_ADD) {
+
+                result.a = _mm_add_ps(args[0].a, args[1].a);
+            }
+            else if constexpr (ModeAlpha == GL_ADD_SIGNED) {
+
+                result.a = _mm_sub_ps(_mm_add_ps(args[0].a, args[1].a), _mm_set1_ps(0.5f));
+            }
+            else if constexpr (ModeAlpha == GL_SUBTRACT) {
+
+                result.a = _mm_sub_ps(args[0].a, args[1].a);
+            }
+            else if constexpr (ModeAlpha == GL_INTERPOLATE) {
+
+                result.a = SIMD::lerp(args[2].a, args[1].a, args[0].a);
+            }
+        }
+
+        //
+        // RGB
+        //
+        for (int argIdx = 0; argIdx < getNumCombineArgs(ModeRGB); argIdx++) {
+
+            auto &arg = args[argIdx];
+
+            // Read argument(s) and apply the modifiers
+            switch (texEnv.sourceRGB[argIdx]) {
+
+            case GL_TEXTURE:
+                arg = texColor;
+                break;
+
+            case GL_CONSTANT:
+                arg.a = _mm_set1_ps(texEnv.colorConstA);
+                arg.r = _mm_set1_ps(texEnv.colorConstR);
+                arg.g = _mm_set1_ps(texEnv.colorConstG);
+                arg.b = _mm_set1_ps(texEnv.colorConstB);
+                break;
+
+            case GL_PRIMARY_COLOR:
+                arg = primaryColor;
+                break;
+
+            case GL_PREVIOUS:
+                arg = color;
+                break;
+            }
+
+            switch (texEnv.operandRGB[argIdx]) {
+
+            case GL_SRC_COLOR:
+                break;
+
+            case GL_ONE_MINUS_SRC_COLOR:
+                arg.r = _mm_sub_ps(_mm_set1_ps(1.0f), arg.r);
+                arg.g = _mm_sub_ps(_mm_set1_ps(1.0f), arg.g);
+                arg.b = _mm_sub_ps(_mm_set1_ps(1.0f), arg.b);
+                break;
+
+            case GL_SRC_ALPHA:
+                arg.r = arg.a;
+                arg.g = arg.a;
+                arg.b = arg.a;
+                break;
+
+            case GL_ONE_MINUS_SRC_ALPHA:
+                arg.r = _mm_sub_ps(_mm_set1_ps(1.0f), arg.a);
+                arg.g = _mm_sub_ps(_mm_set1_ps(1.0f), arg.a);
+                arg.b = _mm_sub_ps(_mm_set1_ps(1.0f), arg.a);
+                break;
+            }
+        }
+
+        // Combine red, green and blue
+        if constexpr (ModeRGB == GL_REPLACE) {
+
+            result.r = args[0].r;
+            result.g = args[0].g;
+            result.b = args[0].b;
+        }
+        else if constexpr (ModeRGB == GL_MODULATE) {
+
+            result.r = _mm_mul_ps(args[0].r, args[1].r);
+            result.g = _mm_mul_ps(args[0].g, args[1].g);
+            result.b = _mm_mul_ps(args[0].b, args[1].b);
+        }
+        else if constexpr (ModeRGB == GL_ADD) {
+
+            result.r = _mm_add_ps(args[0].r, args[1].r);
+            result.g = _mm_add_ps(args[0].g, args[1].g);
+            result.b = _mm_add_ps(args[0].b, args[1].b);
+        }
+        else if constexpr (ModeRGB == GL_ADD_SIGNED) {
+
+            result.r = _mm_sub_ps(_mm_add_ps(args[0].r, args[1].r), _mm_set1_ps(0.5f));
+            result.g = _mm_sub_ps(_mm_add_ps(args[0].g, args[1].g), _mm_set1_ps(0.5f));
+            result.b = _mm_sub_ps(_mm_add_ps(args[0].b, args[1].b), _mm_set1_ps(0.5f));
+        }
+        else if constexpr (ModeRGB == GL_SUBTRACT) {
+
+            result.r = _mm_sub_ps(args[0].r, args[1].r);
+            result.g = _mm_sub_ps(args[0].g, args[1].g);
+            result.b = _mm_sub_ps(args[0].b, args[1].b);
+        }
+        else if constexpr (ModeRGB == GL_DOT3_RGB) {
+
+            result.r = SIMD::dot3(args[0].r, args[1].r, args[0].g, args[1].g, args[0].b, args[1].b);
+            result.g = result.r;
+            result.b = result.r;
+        }
+        else if constexpr (ModeRGB == GL_DOT3_RGBA) {
+
+            result.a = SIMD::dot3(args[0].r, args[1].r, args[0].g, args[1].g, args[0].b, args[1].b);
+            result.r = result.a;
+            result.g = result.a;
+            result.b = result.a;
+        }
+        else if constexpr (ModeRGB == GL_INTERPOLATE) {
+
+            result.r = SIMD::lerp(args[2].r, args[1].r, args[0].r);
+            result.g = SIMD::lerp(args[2].g, args[1].g, args[0].g);
+            result.b = SIMD::lerp(args[2].b, args[1].b, args[0].b);
+        }
+
+        color.a = _mm_mul_ps(result.a, _mm_set1_ps(texEnv.colorScaleA));
+        color.r = _mm_mul_ps(result.r, _mm_set1_ps(texEnv.colorScaleRGB));
+        color.g = _mm_mul_ps(result.g, _mm_set1_ps(texEnv.colorScaleRGB));
+        color.b = _mm_mul_ps(result.b, _mm_set1_ps(texEnv.colorScaleRGB));
+    }
+
+
+
+    template<typename Color, GLenum Mode>
+    static TexEnvFunction<Color> selectTexEnv(TextureBaseFormat format) {
+
+        switch (format) {
+
+        case TextureBaseFormat::Alpha: return &applyTexEnv<Mode, TextureBaseFormat::Alpha, Color>;
+        case TextureBaseFormat::Luminance: return &applyTexEnv<Mode, TextureBaseFormat::Luminance, Color>;
+        case TextureBaseFormat::LuminanceAlpha: return &applyTexEnv<Mode, TextureBaseFormat::LuminanceAlpha, Color>;
+        case TextureBaseFormat::Intensity: return &applyTexEnv<Mode, TextureBaseFormat::Intensity, Color>;
+        case TextureBaseFormat::RGB: return &applyTexEnv<Mode, TextureBaseFormat::RGB, Color>;
+        case TextureBaseFormat::RGBA: return &applyTexEnv<Mode, TextureBaseFormat::RGBA, Color>;
+        }
+
+        return &keepColor<Color>;
+    }
+
+    template<typename Color>
+    static TexEnvFunction<Color> selectTexEnv(GLenum mode, TextureBaseFormat format) {
+
+        switch (mode) {
+
+        case GL_REPLACE: return selectTexEnv<Color, GL_REPLACE>(format);
+        case GL_MODULATE: return selectTexEnv<Color, GL_MODULATE>(format);
+        case GL_DECAL: return selectTexEnv<Color, GL_DECAL>(format);
+        case GL_ADD: return selectTexEnv<Color, GL_ADD>(format);
+        case GL_BLEND: return selectTexEnv<Color, GL_BLEND>(format);
+        }
+
+        return &keepColor<Color>;
+    }
+
+    template<GLenum ModeRGB>
+    static TexEnvKernel selectCombine(GLenum modeAlpha) {
+
+        switch (modeAlpha) {
+
+        case GL_REPLACE: return &applyCombine<ModeRGB, GL_REPLACE>;
+        case GL_MODULATE: return &applyCombine<ModeRGB, GL_MODULATE>;
+        case GL_ADD: return &applyCombine<ModeRGB, GL_ADD>;
+        case GL_ADD_SIGNED: return &applyCombine<ModeRGB, GL_ADD_SIGNED>;
+        case GL_SUBTRACT: return &applyCombine<ModeRGB, GL_SUBTRACT>;
+        case GL_INTERPOLATE: return &applyCombine<ModeRGB, GL_INTERPOLATE>;
+        }
+
+        return &keepColor<ARGBColor>;
+    }
+
+    static TexEnvKernel selectCombine(GLenum modeRGB, GLenum modeAlpha) {
+
+        switch (modeRGB) {
+
+        case GL_REPLACE: return selectCombine<GL_REPLACE>(modeAlpha);
+        case GL_MODULATE: return selectCombine<GL_MODULATE>(modeAlpha);
+        case GL_ADD: return selectCombine<GL_ADD>(modeAlpha);
+        case GL_ADD_SIGNED: return selectCombine<GL_ADD_SIGNED>(modeAlpha);
+        case GL_SUBTRACT: return selectCombine<GL_SUBTRACT>(modeAlpha);
+        case GL_INTERPOLATE: return selectCombine<GL_INTERPOLATE>(modeAlpha);
+        case GL_DOT3_RGB: return selectCombine<GL_DOT3_RGB>(modeAlpha);
+
+        // The alpha combine mode is ignored
+        case GL_DOT3_RGBA: return &applyCombine<GL_DOT3_RGBA, GL_NONE>;
+        }
+
+        return &keepColor<ARGBColor>;
+    }
+
+    static TexEnvKernel selectTexEnv(const TextureEnvironment &texEnv, TextureBaseFormat format) {
+
+        if (texEnv.mode == GL_COMBINE) {
+
+            return selectCombine(texEnv.combineModeRGB, texEnv.combineModeAlpha);
+        }
+
+        return selectTexEnv<ARGBColor>(texEnv.mode, format);
+    }
+
+    static TexEnvKernel8 selectTexEnv8(const TextureEnvironment &texEnv, TextureBaseFormat format) {
+
+#if SWGL_SIMD_LEVEL >= SWGL_SIMD_AVX2
+        // The combine kernels only exist for single quads
+        if (texEnv.mode != GL_COMBINE) {
+
+            return selectTexEnv<ARGBColor8>(texEnv.mode, format);
+        }
+#endif
+
+        return nullptr;
+    }
+}
+}
@@ -55,6 +55,19 @@ namespace SWGL {
 
 namespace SWGL {
 
+    // The draw calls get the texture state through a cached state block, which has to
+    // be rebuilt whenever the textures of the units change
+    static void invalidateDrawState() {
+
+        auto &context = SWGL::Context::getCurrentContext();
+        if (context != nullptr) {
+
+            context->getRenderer().invalidateDrawState();
+        }
+    }
+
+
+
     TextureManager::TextureManager() {
 
         m_activeUnit = &m_unit[0];
@@ -73,21 +86,26 @@ namespace SWGL {
             auto &texMip = texData->mips[mipLevel][faceIdx];
             auto &texPixel = texMip.pixel;
 
-            // Synchronize with the drawing threads if this texture
-            // is currently in use
-            if (texData.use_count() > 0L) {
+            // Wait for the drawing threads if this texture is still
+            // referenced by a draw call
+            if (texData.use_count() > 1L) {
 
-                SWGL::Context::getCurrentContext()->getRenderer().finish();
+                SWGL::Context::getCurrentContext()->getRenderer().waitForTexture(*texData);
             }
 
             // Update max lod
             if (texData->maxLOD < mipLevel) {
 
                 texData->maxLOD = mipLevel;
+                invalidateDrawState();
             }
 
-            // Update format
-            texData->format = internalFormat;
+            // Update format, the state blocks pick the texture function by it
+            if (texData->format != internalFormat) {
+
+                texData->format = internalFormat;
+                invalidateDrawState();
+            }
 
             // Update texture size
             if (width * height != static_cast<GLint>(texPixel.size())) {
@@ -120,11 +138,11 @@ namespace SWGL {
             auto &texPixel = texMip.pixel;
             auto &internalFormat = texData->format;
 
-            // Synchronize with the drawing threads if this texture
-            // is currently in use
-            if (texData.use_count() > 0L) {
+            // Wait for the drawing threads if this texture is still
+            // referenced by a draw call
+            if (texData.use_count() > 1L) {
 
-                SWGL::Context::getCurrentContext()->getRenderer().finish();
+                SWGL::Context::getCurrentContext()->getRenderer().waitForTexture(*texData);
             }
 
             // Read texture
@@ -315,6 +333,7 @@ namespace SWGL {
     bool TextureManager::bindTexture(GLenum target, GLuint name) {
 
         auto texTarget = getTextureTarget(m_activeUnit, target);
+        invalidateDrawState();
 
         // Bind or unbind a texture to/from a given target
         if (name != 0U) {
@@ -371,6 +390,7 @@ namespace SWGL {
 
             // Erase the texture
             m_textureObjects.erase(it);
+            invalidateDrawState();
 
             // The texture name is now available again
             m_freeTextures.push_back(name);
@@ -386,6 +406,7 @@ namespace SWGL {
 
         auto texTarget = getTextureTarget(m_activeUnit, target);
         texTarget->isEnabled = isEnabled;
+        invalidateDrawState();
 
         // Find the most "prioritized" texture target and make it the current
         // target. Cubemap has the highest priority, followed by 3D, 2D and 1D
@@ -446,11 +467,15 @@ namespace SWGL {
 
     TextureEnvironment &TextureManager::getActiveTextureEnvironment() {
 
+        // Only used to change the environment
+        invalidateDrawState();
         return m_activeUnit->texEnv;
     }
 
     TextureParameter &TextureManager::getTextureParameter(GLenum target) {
 
+        // Only used to change the parameters
+        invalidateDrawState();
         return getTextureTarget(m_activeUnit, target)->texObj->parameter;
     }
 
@@ -6,6 +6,7 @@
 #include <array>
 #include <vector>
 #include <memory>
+#include <limits>
 #include "Defines.h"
 #include "SIMD.h"
 #include "OpenGL.h"
@@ -103,6 +104,13 @@ namespace SWGL {
         int maxLOD;
         TextureMipMaps mips;
 
+        // Screen area of the draw calls that used the texture since the drawing
+        // threads were synchronized with it the last time
+        int drawMinX = std::numeric_limits<int>::max();
+        int drawMinY = std::numeric_limits<int>::max();
+        int drawMaxX = 0;
+        int drawMaxY = 0;
+
         virtual ~TextureData() { }
         virtual void sampleTexels(TextureParameter &texParams, TextureCoordinates &texCoords, ARGBColor &colorOut) = 0;
     };
@@ -183,6 +191,22 @@ namespace SWGL {
         QFloat b;
     };
 
+    // Texture coordinates and color of two quads
+    struct TextureCoordinates8 {
+
+        OFloat s;
+        OFloat t;
+        OFloat r;
+    };
+
+    struct ARGBColor8 {
+
+        OFloat a;
+        OFloat r;
+        OFloat g;
+        OFloat b;
+    };
+
     //
     // Implements the texture management functionality of swGL
     //
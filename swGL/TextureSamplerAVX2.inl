@@ -0,0 +1,262 @@
+﻿#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include "SIMDAVX2.h"
+#include "TextureManager.h"
+#include "TextureSampler.inl"
+
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    // Type aliases
+    using SamplerMethod8 = void(*)(TextureMipMap &, TextureParameter &, TextureCoordinates8 &, ARGBColor8 &);
+
+    //
+    // The samplers of TextureSampler.inl for two quads. Every lane does the same
+    // arithmetic as the quad samplers, so both return exactly the same colors.
+    //
+    static void sampleTexelsLinear8(TextureMipMap &texMipMap, TextureParameter &texParams, TextureCoordinates8 &texCoords, ARGBColor8 &colorOut) {
+
+        // Get the dimension of the texture
+        OInt width = _mm256_set1_epi32(texMipMap.width);
+        OInt height = _mm256_set1_epi32(texMipMap.height);
+        OInt wrapWidth = _mm256_set1_epi32(texMipMap.width - 1);
+        OInt wrapHeight = _mm256_set1_epi32(texMipMap.height - 1);
+
+        // Scale u and v according to the textures dimensions
+        OFloat scaledU = _mm256_sub_ps(_mm256_mul_ps(texCoords.s, _mm256_cvtepi32_ps(width)), _mm256_set1_ps(0.5f));
+        OFloat scaledV = _mm256_sub_ps(_mm256_mul_ps(texCoords.t, _mm256_cvtepi32_ps(height)), _mm256_set1_ps(0.5f));
+        OFloat flooredU = SIMD::floor(scaledU);
+        OFloat flooredV = SIMD::floor(scaledV);
+
+        OInt texelX0 = _mm256_cvttps_epi32(flooredU);
+        OInt texelY0 = _mm256_cvttps_epi32(flooredV);
+        OInt texelX1 = _mm256_add_epi32(texelX0, _mm256_set1_epi32(1));
+        OInt texelY1 = _mm256_add_epi32(texelY0, _mm256_set1_epi32(1));
+
+        // Get fractional part of u and v
+        OFloat fracX0 = _mm256_sub_ps(scaledU, flooredU);
+        OFloat fracY0 = _mm256_sub_ps(scaledV, flooredV);
+        OFloat fracX1 = _mm256_sub_ps(_mm256_set1_ps(1.0f), fracX0);
+        OFloat fracY1 = _mm256_sub_ps(_mm256_set1_ps(1.0f), fracY0);
+
+        // Calculate the blending weights as Q1.8 fixed point values
+        const OFloat shift = _mm256_set1_ps(256.0f);
+        OInt wx1y1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_mul_ps(fracX0, fracY0), shift));
+        OInt wx0y1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_mul_ps(fracX1, fracY0), shift));
+        OInt wx1y0 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_mul_ps(fracX0, fracY1), shift));
+        OInt wx0y0 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_mul_ps(fracX1, fracY1), shift));
+
+        // Determine the texel x- and y-coordinates according to the selected wrapping mode
+        if (texParams.wrappingModeS == GL_REPEAT) {
+
+            texelX0 = _mm256_and_si256(texelX0, wrapWidth);
+            texelX1 = _mm256_and_si256(texelX1, wrapWidth);
+        }
+        else {
+
+            texelX0 = SIMD::clamp(texelX0, _mm256_setzero_si256(), wrapWidth);
+            texelX1 = SIMD::clamp(texelX1, _mm256_setzero_si256(), wrapWidth);
+        }
+        if (texParams.wrappingModeT == GL_REPEAT) {
+
+            texelY0 = _mm256_and_si256(texelY0, wrapHeight);
+            texelY1 = _mm256_and_si256(texelY1, wrapHeight);
+        }
+        else {
+
+            texelY0 = SIMD::clamp(texelY0, _mm256_setzero_si256(), wrapHeight);
+            texelY1 = SIMD::clamp(texelY1, _mm256_setzero_si256(), wrapHeight);
+        }
+
+        // Gather texture samples
+        OInt texelOffsetX1Y1 = SIMD::multiplyAdd(texelY1, width, texelX1);
+        OInt texelOffsetX0Y1 = SIMD::multiplyAdd(texelY1, width, texelX0);
+        OInt texelOffsetX1Y0 = SIMD::multiplyAdd(texelY0, width, texelX1);
+        OInt texelOffsetX0Y0 = SIMD::multiplyAdd(texelY0, width, texelX0);
+
+        auto data = reinterpret_cast<const int *>(texMipMap.pixel.data());
+        OInt sampleX1Y1 = SIMD::gather(data, texelOffsetX1Y1);
+        OInt sampleX0Y1 = SIMD::gather(data, texelOffsetX0Y1);
+        OInt sampleX1Y0 = SIMD::gather(data, texelOffsetX1Y0);
+        OInt sampleX0Y0 = SIMD::gather(data, texelOffsetX0Y0);
+
+        // Extract alpha/green and red/blue channels
+        const OInt channelMask = _mm256_set1_epi32(0x00ff00ff);
+
+        OInt ag[4], rb[4];
+        ag[0] = _mm256_and_si256(_mm256_srli_epi32(sampleX0Y0, 8), channelMask);
+        ag[1] = _mm256_and_si256(_mm256_srli_epi32(sampleX1Y0, 8), channelMask);
+        ag[2] = _mm256_and_si256(_mm256_srli_epi32(sampleX0Y1, 8), channelMask);
+        ag[3] = _mm256_and_si256(_mm256_srli_epi32(sampleX1Y1, 8), channelMask);
+        rb[0] = _mm256_and_si256(sampleX0Y0, channelMask);
+        rb[1] = _mm256_and_si256(sampleX1Y0, channelMask);
+        rb[2] = _mm256_and_si256(sampleX0Y1, channelMask);
+        rb[3] = _mm256_and_si256(sampleX1Y1, channelMask);
+
+        // Blend samples
+        OInt blendAG = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(ag[0], wx0y0), _mm256_mullo_epi32(ag[1], wx1y0)), _mm256_mullo_epi32(ag[2], wx0y1)), _mm256_mullo_epi32(ag[3], wx1y1));
+        OInt blendRB = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(rb[0], wx0y0), _mm256_mullo_epi32(rb[1], wx1y0)), _mm256_mullo_epi32(rb[2], wx0y1)), _mm256_mullo_epi32(rb[3], wx1y1));
+
+        // Convert the rgba-channels to their floating point representation
+        const OFloat normalize = _mm256_set1_ps(1.0f / 255.0f);
+        const OInt mask = _mm256_set1_epi32(0xff);
+
+        OFloat a = _mm256_cvtepi32_ps(_mm256_srli_epi32(blendAG, 24));
+        OFloat g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(blendAG, 8), mask));
+        OFloat r = _mm256_cvtepi32_ps(_mm256_srli_epi32(blendRB, 24));
+        OFloat b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(blendRB, 8), mask));
+
+        colorOut.a = _mm256_mul_ps(a, normalize);
+        colorOut.r = _mm256_mul_ps(r, normalize);
+        colorOut.g = _mm256_mul_ps(g, normalize);
+        colorOut.b = _mm256_mul_ps(b, normalize);
+    }
+
+    static void sampleTexelsNearest8(TextureMipMap &texMipMap, TextureParameter &texParams, TextureCoordinates8 &texCoords, ARGBColor8 &colorOut) {
+
+        // Get the dimension of the texture
+        OInt width = _mm256_set1_epi32(texMipMap.width);
+        OInt height = _mm256_set1_epi32(texMipMap.height);
+        OInt wrapWidth = _mm256_set1_epi32(texMipMap.width - 1);
+        OInt wrapHeight = _mm256_set1_epi32(texMipMap.height - 1);
+
+        // Scale u and v according to the texture dimension
+        OInt scaledU = _mm256_cvttps_epi32(SIMD::floor(_mm256_mul_ps(texCoords.s, _mm256_cvtepi32_ps(width))));
+        OInt scaledV = _mm256_cvttps_epi32(SIMD::floor(_mm256_mul_ps(texCoords.t, _mm256_cvtepi32_ps(height))));
+
+        // Determine the texel x- and y-coordinates according to the selected wrapping mode
+        OInt texelX, texelY;
+        if (texParams.wrappingModeS == GL_REPEAT) {
+
+            texelX = _mm256_and_si256(scaledU, wrapWidth);
+        }
+        else {
+
+            texelX = SIMD::clamp(scaledU, _mm256_setzero_si256(), wrapWidth);
+        }
+        if (texParams.wrappingModeT == GL_REPEAT) {
+
+            texelY = _mm256_and_si256(scaledV, wrapHeight);
+        }
+        else {
+
+            texelY = SIMD::clamp(scaledV, _mm256_setzero_si256(), wrapHeight);
+        }
+
+        // Gather texture samples
+        OInt texelOffset = SIMD::multiplyAdd(texelY, width, texelX);
+        OInt samples = SIMD::gather(
+
+            reinterpret_cast<const int *>(texMipMap.pixel.data()),
+            texelOffset
+        );
+
+        // Convert the rgba-channels to their floating point representation
+        const OFloat normalize = _mm256_set1_ps(1.0f / 255.0f);
+        const OInt mask = _mm256_set1_epi32(0xff);
+
+        OFloat a = _mm256_cvtepi32_ps(_mm256_srli_epi32(samples, 24));
+        OFloat r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(samples, 16), mask));
+        OFloat g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(samples, 8), mask));
+        OFloat b = _mm256_cvtepi32_ps(_mm256_and_si256(samples, mask));
+
+        colorOut.a = _mm256_mul_ps(normalize, a);
+        colorOut.r = _mm256_mul_ps(normalize, r);
+        colorOut.g = _mm256_mul_ps(normalize, g);
+        colorOut.b = _mm256_mul_ps(normalize, b);
+    }
+
+
+
+    //
+    // The detail level(s) a quad is sampled from, as chosen by sample2D()
+    //
+    struct DetailLevel {
+
+        SamplerMethod sampler;
+        int lod;
+        int blendLod;   // -1 if no second level is blended in
+        float t;
+    };
+
+    static DetailLevel getDetailLevel(TextureData2D &texData, TextureParameter &texParams, TextureCoordinates &texCoords) {
+
+        if (texParams.isUsingMipMapping) {
+
+            static constexpr float c = 0.5f;
+
+            float lambda = getLambda(&texData, texCoords);
+            if (lambda >= c) {
+
+                if (texParams.isUsingTrilinearFilter) {
+
+                    int lod = static_cast<int>(lambda);
+                    if (lod >= texData.maxLOD) {
+
+                        return { texParams.minifySampler, texData.maxLOD, -1, 0.0f };
+                    }
+
+                    return { texParams.minifySampler, lod, lod + 1, lambda - SIMD::floor(lambda) };
+                }
+
+                int lod = static_cast<int>(SIMD::ceil(lambda + 0.5f) - 1.0f);
+                return { texParams.minifySampler, SIMD::min(lod, texData.maxLOD), -1, 0.0f };
+            }
+        }
+
+        return { texParams.magnifySampler, 0, -1, 0.0f };
+    }
+
+    static void sample2D8(TextureData2D &texData, TextureParameter &texParams, TextureCoordinates8 &texCoords, ARGBColor8 &colorOut) {
+
+        TextureCoordinates quadCoords[2] = {
+
+            { SIMD::lower(texCoords.s), SIMD::lower(texCoords.t), SIMD::lower(texCoords.r) },
+            { SIMD::upper(texCoords.s), SIMD::upper(texCoords.t), SIMD::upper(texCoords.r) }
+        };
+
+        // The level of detail is determined per quad. Both quads are only sampled at once
+        // if they use the same levels, which is the common case.
+        DetailLevel level[2] = {
+
+            getDetailLevel(texData, texParams, quadCoords[0]),
+            getDetailLevel(texData, texParams, quadCoords[1])
+        };
+
+        if (level[0].sampler != level[1].sampler ||
+            level[0].lod != level[1].lod ||
+            level[0].blendLod != level[1].blendLod) {
+
+            ARGBColor quadColor[2];
+            sample2D(texData, texParams, quadCoords[0], quadColor[0]);
+            sample2D(texData, texParams, quadCoords[1], quadColor[1]);
+
+            colorOut.a = SIMD::combine(quadColor[0].a, quadColor[1].a);
+            colorOut.r = SIMD::combine(quadColor[0].r, quadColor[1].r);
+            colorOut.g = SIMD::combine(quadColor[0].g, quadColor[1].g);
+            colorOut.b = SIMD::combine(quadColor[0].b, quadColor[1].b);
+            return;
+        }
+
+        SamplerMethod8 sampler = (level[0].sampler == &sampleTexelsNearest) ? &sampleTexelsNearest8 : &sampleTexelsLinear8;
+        sampler(texData.mips[level[0].lod][0], texParams, texCoords, colorOut);
+
+        // Trilinear filtering, the weight of the second level may differ between the quads
+        if (level[0].blendLod >= 0) {
+
+            ARGBColor8 color2;
+            sampler(texData.mips[level[0].blendLod][0], texParams, texCoords, color2);
+
+            OFloat t = SIMD::combine(_mm_set1_ps(level[0].t), _mm_set1_ps(level[1].t));
+
+            colorOut.a = SIMD::lerp(t, colorOut.a, color2.a);
+            colorOut.r = SIMD::lerp(t, colorOut.r, color2.r);
+            colorOut.g = SIMD::lerp(t, colorOut.g, color2.g);
+            colorOut.b = SIMD::lerp(t, colorOut.b, color2.b);
+        }
+    }
+}
+}
@@ -0,0 +1,158 @@
+﻿#include <algorithm>
+#include <memory>
+#include <tuple>
+#include "Log.h"
+#include "ThreadAffinity.h"
+
+namespace SWGL {
+
+    ThreadAffinity::ThreadAffinity() {
+
+        auto policy = Configuration::getInstance().getAffinityPolicy();
+        if (policy == AffinityPolicy::None) {
+
+            return;
+        }
+
+        queryTopology();
+        sortProcessors(policy);
+
+        LOG("Found %u logical processors for pinning", static_cast<unsigned int>(m_processors.size()));
+    }
+
+
+
+    ThreadAffinity &ThreadAffinity::getInstance() {
+
+        static ThreadAffinity instance;
+        return instance;
+    }
+
+
+
+    void ThreadAffinity::pinCurrentThread(int threadIdx) const {
+
+        if (m_processors.empty()) {
+
+            return;
+        }
+
+        // There may be more drawing threads than logical processors
+        auto &processor = m_processors[static_cast<unsigned int>(threadIdx) % m_processors.size()];
+
+        GROUP_AFFINITY affinity = {};
+        affinity.Group = processor.group;
+        affinity.Mask = static_cast<KAFFINITY>(1) << processor.number;
+
+        if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr)) {
+
+            LOG("SetThreadGroupAffinity() failed: %u", GetLastError());
+            return;
+        }
+
+        PROCESSOR_NUMBER idealProcessor = {};
+        idealProcessor.Group = processor.group;
+        idealProcessor.Number = processor.number;
+
+        SetThreadIdealProcessorEx(GetCurrentThread(), &idealProcessor, nullptr);
+    }
+
+
+
+    void ThreadAffinity::queryTopology() {
+
+        DWORD length = 0;
+        GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+
+            LOG("GetLogicalProcessorInformationEx() failed: %u", GetLastError());
+            return;
+        }
+
+        auto buffer = std::make_unique<unsigned char[]>(length);
+        auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.get());
+
+        if (!GetLogicalProcessorInformationEx(RelationAll, info, &length)) {
+
+            LOG("GetLogicalProcessorInformationEx() failed: %u", GetLastError());
+            return;
+        }
+
+        std::vector<std::pair<GROUP_AFFINITY, int>> nodes;
+        int numCores = 0;
+
+        // Every core lists its logical processors, the SMT siblings are numbered in
+        // the order of the affinity mask
+        for (DWORD offset = 0; offset < length; ) {
+
+            auto entry = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.get() + offset);
+
+            if (entry->Relationship == RelationProcessorCore) {
+
+                auto &mask = entry->Processor.GroupMask[0];
+                int sibling = 0;
+
+                for (BYTE bit = 0; bit < sizeof(KAFFINITY) * 8; bit++) {
+
+                    if (mask.Mask & (static_cast<KAFFINITY>(1) << bit)) {
+
+                        m_processors.push_back({ mask.Group, bit, 0, numCores, 0, sibling++ });
+                    }
+                }
+                numCores++;
+            }
+            else if (entry->Relationship == RelationNumaNode) {
+
+                nodes.emplace_back(entry->NumaNode.GroupMask, static_cast<int>(entry->NumaNode.NodeNumber));
+            }
+
+            offset += entry->Size;
+        }
+
+        // Assign the processors to their NUMA nodes and number the cores within
+        // each node
+        for (auto &processor : m_processors) {
+
+            for (auto &node : nodes) {
+
+                if (node.first.Group == processor.group &&
+                    (node.first.Mask & (static_cast<KAFFINITY>(1) << processor.number))) {
+
+                    processor.node = node.second;
+                    break;
+                }
+            }
+        }
+
+        for (auto &processor : m_processors) {
+
+            processor.coreInNode = 0;
+            for (auto &other : m_processors) {
+
+                if (other.node == processor.node && other.sibling == 0 && other.core < processor.core) {
+
+                    processor.coreInNode++;
+                }
+            }
+        }
+    }
+
+    void ThreadAffinity::sortProcessors(AffinityPolicy policy) {
+
+        std::stable_sort(m_processors.begin(), m_processors.end(), [policy](const Processor &a, const Processor &b) {
+
+            switch (policy) {
+
+            case AffinityPolicy::Compact:
+                return std::tie(a.node, a.core, a.sibling) < std::tie(b.node, b.core, b.sibling);
+
+            case AffinityPolicy::Scatter:
+                return std::tie(a.sibling, a.coreInNode, a.node) < std::tie(b.sibling, b.coreInNode, b.node);
+
+            default:
+                return std::tie(a.sibling, a.node, a.core) < std::tie(b.sibling, b.node, b.core);
+            }
+        });
+    }
+}
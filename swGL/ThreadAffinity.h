@@ -0,0 +1,44 @@
+﻿#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include "Configuration.h"
+
+namespace SWGL {
+
+    //
+    // Pins the drawing threads to logical processors according to the affinity
+    // policy of the configuration. The processor topology (NUMA nodes, cores and
+    // their SMT siblings) is queried once on first use.
+    //
+    class ThreadAffinity {
+
+    public:
+        ~ThreadAffinity() = default;
+
+        static ThreadAffinity &getInstance();
+
+    public:
+        void pinCurrentThread(int threadIdx) const;
+
+    private:
+        ThreadAffinity();
+
+        void queryTopology();
+        void sortProcessors(AffinityPolicy policy);
+
+    private:
+        struct Processor {
+
+            WORD group;
+            BYTE number;
+            int node;
+            int core;
+            int coreInNode;
+            int sibling;
+        };
+
+        // The processors in the order the threads are placed on them
+        std::vector<Processor> m_processors;
+    };
+}
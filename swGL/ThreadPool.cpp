@@ -0,0 +1,150 @@
+﻿#include <stdexcept>
+#include "Log.h"
+#include "ThreadPool.h"
+
+namespace SWGL {
+
+    ThreadPool::ThreadPool()
+
+        : m_isStopRequested(false),
+          m_job(nullptr),
+          m_numJobs(0),
+          m_generation(0),
+          m_numActiveWorkers(0),
+          m_nextJob(0),
+          m_numPendingJobs(0) {
+
+    }
+
+
+
+    void ThreadPool::start(int numThreads) {
+
+        m_isStopRequested = false;
+
+        for (int i = 0; i < numThreads; i++) {
+
+            m_threads.emplace_back(&ThreadPool::workerMain, this);
+        }
+    }
+
+    void ThreadPool::stop() {
+
+        {
+            std::lock_guard<std::mutex> cs(m_mutex);
+            m_isStopRequested = true;
+        }
+        m_jobAvailable.notify_all();
+
+        for (auto &thread : m_threads) {
+
+            try {
+
+                if (thread.joinable()) {
+
+                    thread.join();
+                }
+            }
+            catch (std::runtime_error ex) {
+
+                LOG("std::thread::join() failed: %s", ex.what());
+            }
+        }
+
+        m_threads.clear();
+    }
+
+
+
+    void ThreadPool::run(int numJobs, const std::function<void(int)> &job) {
+
+        // Not worth to bother the workers (or they are busy with the jobs of
+        // another caller)
+        std::unique_lock<std::mutex> runLock(m_runMutex, std::defer_lock);
+
+        if (m_threads.empty() || numJobs <= 1 || !runLock.try_lock()) {
+
+            for (int i = 0; i < numJobs; i++) {
+
+                job(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> cs(m_mutex);
+
+            m_job = &job;
+            m_numJobs = numJobs;
+            m_nextJob.store(0, std::memory_order_relaxed);
+            m_numPendingJobs.store(numJobs, std::memory_order_relaxed);
+            m_generation++;
+        }
+        m_jobAvailable.notify_all();
+
+        executeJobs();
+
+        // Wait until all jobs are done and no worker refers to the job anymore,
+        // as it lives on the stack of the caller
+        std::unique_lock<std::mutex> cs(m_mutex);
+        m_jobsDone.wait(cs, [this] {
+
+            return m_numPendingJobs.load(std::memory_order_acquire) == 0 && m_numActiveWorkers == 0;
+        });
+
+        m_job = nullptr;
+        m_numJobs = 0;
+    }
+
+
+
+    void ThreadPool::workerMain() {
+
+        unsigned int generation = 0;
+
+        std::unique_lock<std::mutex> cs(m_mutex);
+
+        for (;;) {
+
+            m_jobAvailable.wait(cs, [&] {
+
+                return m_isStopRequested || (m_job != nullptr && m_generation != generation);
+            });
+
+            if (m_isStopRequested) {
+
+                return;
+            }
+
+            generation = m_generation;
+            m_numActiveWorkers++;
+            cs.unlock();
+
+            executeJobs();
+
+            cs.lock();
+            m_numActiveWorkers--;
+            m_jobsDone.notify_one();
+        }
+    }
+
+    void ThreadPool::executeJobs() {
+
+        for (;;) {
+
+            auto jobIdx = m_nextJob.fetch_add(1, std::memory_order_relaxed);
+            if (jobIdx >= m_numJobs) {
+
+                return;
+            }
+
+            (*m_job)(jobIdx);
+
+            if (m_numPendingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+
+                std::lock_guard<std::mutex> cs(m_mutex);
+                m_jobsDone.notify_one();
+            }
+        }
+    }
+}
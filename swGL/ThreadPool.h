@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+namespace SWGL {
+
+    //
+    // A small pool of worker threads for data parallel work of the application
+    // thread (e.g. binning of large draw calls). The application thread takes part
+    // in the work and returns when all jobs are done. The pool is shared by all
+    // contexts, a caller which finds it busy does its jobs on its own.
+    //
+    class ThreadPool {
+
+    public:
+        ThreadPool();
+        ~ThreadPool() = default;
+
+    public:
+        void start(int numThreads);
+        void stop();
+
+        void run(int numJobs, const std::function<void(int)> &job);
+
+        int getNumThreads() const { return static_cast<int>(m_threads.size()) + 1; }
+
+    private:
+        void workerMain();
+        void executeJobs();
+
+    private:
+        std::vector<std::thread> m_threads;
+        std::mutex m_runMutex;
+        std::mutex m_mutex;
+        std::condition_variable m_jobAvailable;
+        std::condition_variable m_jobsDone;
+        bool m_isStopRequested;
+
+    private:
+        const std::function<void(int)> *m_job;
+        int m_numJobs;
+        unsigned int m_generation;
+        int m_numActiveWorkers;
+        std::atomic<int> m_nextJob;
+        std::atomic<int> m_numPendingJobs;
+    };
+}
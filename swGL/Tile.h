@@ -0,0 +1,143 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "Defines.h"
+#include "DrawBuffer.h"
+#include "Command.h"
+#include "LockFreeQueue.h"
+
+namespace SWGL {
+
+    // Forward declarations
+    class Tile;
+
+    // Type aliases
+    using TilePtr = std::unique_ptr<Tile>;
+
+    //
+    // A small rectangular region of the drawing surface with its own command queue.
+    // The commands of a tile are always executed in order by at most one drawing
+    // thread at a time, but any drawing thread may pick up a tile that has pending
+    // commands.
+    //
+    class Tile {
+
+    public:
+        Tile(int homeThread, int minX, int minY, int maxX, int maxY)
+
+            : m_isLocked(false),
+              m_isProducerWaiting(false),
+              m_homeThread(homeThread),
+              m_workloadEstimate(0),
+              m_executionTime(0),
+              m_isInitialized(false),
+              m_minX(minX),
+              m_minY(minY),
+              m_maxX(maxX),
+              m_maxY(maxY) {
+
+        }
+        ~Tile() = default;
+
+    public:
+        bool tryLock() {
+
+            return !m_isLocked.load(std::memory_order_relaxed) &&
+                   !m_isLocked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock() {
+
+            m_isLocked.store(false, std::memory_order_release);
+        }
+
+    public:
+        bool push(Command &command) { return m_commandQueue.push(command); }
+        bool hasCommands() const { return !m_commandQueue.isEmpty(); }
+
+        // Blocks until there is space for the command in the queue. Somebody has to
+        // work on the tile in the meantime.
+        void pushWaiting(Command &command) {
+
+            std::unique_lock<std::mutex> cs(m_mutex);
+
+            m_isProducerWaiting.store(true);
+            while (!m_commandQueue.push(command)) {
+
+                m_spaceAvailable.wait(cs);
+            }
+            m_isProducerWaiting.store(false, std::memory_order_relaxed);
+        }
+
+        bool pop(Command &command) {
+
+            if (!m_commandQueue.pop(command)) {
+
+                return false;
+            }
+
+            // The fence makes sure that either the waiting producer sees the free
+            // space, or the consumer sees the waiting producer
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_isProducerWaiting.load(std::memory_order_relaxed)) {
+
+                std::lock_guard<std::mutex> cs(m_mutex);
+                m_spaceAvailable.notify_one();
+            }
+
+            return true;
+        }
+
+    public:
+        // The buffers are allocated and cleared by the home thread while it holds the
+        // lock of the tile, so their memory is first touched by (and placed near) the
+        // thread that works with them most of the time
+        bool isInitialized() const { return m_isInitialized; }
+
+        void initialize() {
+
+            m_drawBuffer.resize(m_minX, m_minY, m_maxX, m_maxY);
+            m_drawBuffer.clearColor(0, m_minX, m_minY, m_maxX, m_maxY);
+            m_drawBuffer.clearDepth(0, m_minX, m_minY, m_maxX, m_maxY);
+            m_isInitialized = true;
+        }
+
+    public:
+        DrawBuffer &getDrawBuffer() { return m_drawBuffer; }
+
+        // The home thread is only a hint which thread should work on the tile, so it
+        // may be changed (see LoadBalancer) while the drawing threads are running
+        int getHomeThread() const { return m_homeThread.load(std::memory_order_relaxed); }
+        void setHomeThread(int homeThread) { m_homeThread.store(homeThread, std::memory_order_relaxed); }
+
+        // Time (in nanoseconds) the drawing threads spent on the commands of the tile
+        // since the last call of takeExecutionTime()
+        void addExecutionTime(long long nanoseconds) { m_executionTime.fetch_add(nanoseconds, std::memory_order_relaxed); }
+        long long takeExecutionTime() { return m_executionTime.exchange(0, std::memory_order_relaxed); }
+
+        // The workload estimate is only touched by the thread that issues the commands
+        long long &getWorkloadEstimate() { return m_workloadEstimate; }
+
+    private:
+        std::atomic<bool> m_isLocked;
+        LockFreeQueue<Command, SWGL_COMMAND_QUEUE_SIZE> m_commandQueue;
+
+    private:
+        std::atomic<bool> m_isProducerWaiting;
+        std::condition_variable m_spaceAvailable;
+        std::mutex m_mutex;
+
+    private:
+        std::atomic<int> m_homeThread;
+        long long m_workloadEstimate;
+        std::atomic<long long> m_executionTime;
+
+    private:
+        bool m_isInitialized;
+        int m_minX, m_minY, m_maxX, m_maxY;
+        DrawBuffer m_drawBuffer;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <array>
 #include <memory>
 #include "Vector.h"
 #include "Vertex.h"
@@ -283,10 +284,30 @@ namespace SWGL {
         }
 
     public:
+        struct CachedVertex {
+
+            unsigned int index;
+            Vertex vertex;
+        };
+        using PostTransformCache = std::array<CachedVertex, 32>;
+
         void fetchVertices(Vertex currentState, VertexList &vertices, unsigned int first, unsigned int count, IndexSupplier indexSupplier) {
 
+            auto base = vertices.size();
+            vertices.resize(base + count);
+
+            fetchVertices(currentState, &vertices[base], first, count, indexSupplier, m_postTransformCache);
+        }
+
+        // Every vertex only depends on its index and the given current state, so different
+        // ranges of a draw call can be fetched at the same time as long as each one has
+        // its own cache
+        void fetchVertices(Vertex currentState, Vertex *vertices, unsigned int first, unsigned int count, const IndexSupplier &indexSupplier, PostTransformCache &postTransformCache) {
+
+            const auto initialState = currentState;
+
             // Reset vertex post transform cache
-            for (auto &cacheEntry : m_postTransformCache) {
+            for (auto &cacheEntry : postTransformCache) {
 
                 cacheEntry.index = 0xffffffff;
             }
@@ -301,10 +322,10 @@ namespace SWGL {
 
 
                 // Look inside the post transform cache first
-                auto &cacheEntry = m_postTransformCache[idx & 0x1f];
+                auto &cacheEntry = postTransformCache[idx & 0x1f];
                 if (cacheEntry.index == idx) {
 
-                    vertices.emplace_back(cacheEntry.vertex);
+                    *vertices++ = cacheEntry.vertex;
                 }
                 else {
 
@@ -330,6 +351,10 @@ namespace SWGL {
 
                         if (m_texGen.isEnabled(texUnit)) {
 
+                            // The components which aren't generated are taken from the array or
+                            // the current state, and not from the previous vertex
+                            currentState.texCoord[texUnit] = isVertexTexCoordEnabled(texUnit) ? getVertexTexCoord(idx, texUnit) : initialState.texCoord[texUnit];
+
                             m_texGen.generate(currentState, texUnit);
                             currentState.texCoord[texUnit] = currentState.texCoord[texUnit] * m_matrixStack.getTextureMatrix(texUnit);
                         }
@@ -345,7 +370,7 @@ namespace SWGL {
                     cacheEntry.vertex = currentState;
 
                     // Add vertex
-                    vertices.emplace_back(currentState);
+                    *vertices++ = currentState;
                 }
             }
         }
@@ -364,11 +389,6 @@ namespace SWGL {
         TexCoordGen &m_texGen;
 
     private:
-        struct CachedVertex {
-
-            unsigned int index;
-            Vertex vertex;
-        };
-        CachedVertex m_postTransformCache[32];
+        PostTransformCache m_postTransformCache;
     };
 }
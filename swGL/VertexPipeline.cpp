@@ -1,4 +1,5 @@
-﻿#include <cmath>
+﻿#include <algorithm>
+#include <cmath>
 #include "Context.h"
 #include "VertexPipeline.h"
 
@@ -299,14 +300,7 @@ namespace SWGL {
                     break;
                 }
                     
-                m_vertexDataArray.fetchVertices(
-
-                    m_vertexState,
-                    m_vertices,
-                    0U,
-                    count,
-                    supplier
-                );
+                fetchVertices(0U, count, supplier);
             }
             end();
         }
@@ -318,14 +312,7 @@ namespace SWGL {
 
             begin(mode); {
 
-                m_vertexDataArray.fetchVertices(
-
-                    m_vertexState,
-                    m_vertices,
-                    first,
-                    count,
-                    [] (unsigned int i) { return i; }
-                );
+                fetchVertices(first, count, [] (unsigned int i) { return i; });
             }
             end();
         }
@@ -333,43 +320,140 @@ namespace SWGL {
 
 
 
+    void VertexPipeline::fetchVertices(unsigned int first, unsigned int count, const IndexSupplier &indexSupplier) {
+
+        auto &context = Context::getCurrentContext();
+        auto &threadPool = context->getRenderer().getThreadPool();
+        auto numChunks = static_cast<int>((count + SWGL_GEOMETRY_CHUNK_SIZE - 1) / SWGL_GEOMETRY_CHUNK_SIZE);
+
+        // Small draw calls are fetched right away
+        if (numChunks <= 1 || threadPool.getNumThreads() <= 1) {
+
+            m_vertexDataArray.fetchVertices(m_vertexState, m_vertices, first, count, indexSupplier);
+            context->getFrontend().releaseCaller();
+            return;
+        }
+
+        auto base = m_vertices.size();
+        m_vertices.resize(base + count);
+
+        threadPool.run(numChunks, [&](int chunkIdx) {
+
+            auto begin = static_cast<unsigned int>(chunkIdx * SWGL_GEOMETRY_CHUNK_SIZE);
+            auto end = std::min(begin + SWGL_GEOMETRY_CHUNK_SIZE, count);
+
+            VertexDataArray::PostTransformCache postTransformCache;
+
+            m_vertexDataArray.fetchVertices(
+
+                m_vertexState,
+                &m_vertices[base + begin],
+                first + begin,
+                end - begin,
+                indexSupplier,
+                postTransformCache
+            );
+        });
+
+        // The arrays of the application aren't needed anymore
+        context->getFrontend().releaseCaller();
+    }
+
     void VertexPipeline::drawTriangles() {
 
-        if (m_lighting.isEnabled()) {
+        auto &renderer = Context::getCurrentContext()->getRenderer();
+        auto &threadPool = renderer.getThreadPool();
+        auto numTriangles = static_cast<int>(m_triangles.size());
+        auto numChunks = (numTriangles + SWGL_GEOMETRY_CHUNK_SIZE - 1) / SWGL_GEOMETRY_CHUNK_SIZE;
+
+        // Small draw calls are processed right away
+        if (numChunks <= 1 || threadPool.getNumThreads() <= 1) {
+
+            if (m_lighting.isEnabled()) {
 
-            m_lighting.calculateLighting(m_triangles);
+                m_lighting.calculateLighting(m_triangles);
+            }
+
+            if (m_clipper.clipTriangles(m_triangles)) {
+
+                projectTriangles(m_triangles.data(), m_triangles.data() + m_triangles.size());
+                renderer.drawTriangles(m_triangles);
+            }
+            return;
         }
 
-        if (m_clipper.clipTriangles(m_triangles)) {
+        if (static_cast<int>(m_chunks.size()) < numChunks) {
 
-            for (auto &t : m_triangles) {
+            m_chunks.resize(numChunks);
+        }
 
-                for (auto &v : t.v) {
+        // Every chunk is lit, clipped and projected on its own
+        threadPool.run(numChunks, [&](int chunkIdx) {
 
-                    auto &proj = v.posProj;
-                    auto &raster = v.posObj;
+            auto first = m_triangles.data() + chunkIdx * SWGL_GEOMETRY_CHUNK_SIZE;
+            auto last = m_triangles.data() + std::min((chunkIdx + 1) * SWGL_GEOMETRY_CHUNK_SIZE, numTriangles);
+            auto &chunk = m_chunks[chunkIdx];
 
-                    // Perspective division
-                    auto rhw = 1.0f / proj.w();
+            if (m_lighting.isEnabled()) {
 
-                    raster.w() = rhw;
-                    raster.z() = proj.z() * rhw;
-                    raster.y() = proj.y() * rhw;
-                    raster.x() = proj.x() * rhw;
+                m_lighting.calculateLighting(first, last);
+            }
+
+            chunk.clear();
+            m_clipper.clipTriangles(first, last, chunk);
+            projectTriangles(chunk.data(), chunk.data() + chunk.size());
+        });
+
+        // Put the chunks back together in the order of the draw call
+        std::vector<unsigned int> offsets(numChunks + 1, 0U);
+        for (int i = 0; i < numChunks; i++) {
+
+            offsets[i + 1] = offsets[i] + static_cast<unsigned int>(m_chunks[i].size());
+        }
+
+        if (offsets[numChunks] == 0U) {
+
+            return;
+        }
+
+        m_triangles.resize(offsets[numChunks]);
+
+        threadPool.run(numChunks, [&](int chunkIdx) {
 
-                    v.colorPrimary *= rhw;
-                    v.colorSecondary *= rhw;
-                    for (auto &texCoord : v.texCoord) {
+            auto &chunk = m_chunks[chunkIdx];
+            std::copy(chunk.begin(), chunk.end(), m_triangles.begin() + offsets[chunkIdx]);
+        });
 
-                        texCoord *= rhw;
-                    }
+        renderer.drawTriangles(m_triangles);
+    }
+
+    void VertexPipeline::projectTriangles(Triangle *first, Triangle *last) {
+
+        for (auto t = first; t != last; t++) {
+
+            for (auto &v : t->v) {
+
+                auto &proj = v.posProj;
+                auto &raster = v.posObj;
 
-                    // Viewport transformation
-                    m_viewport.transform(raster);
+                // Perspective division
+                auto rhw = 1.0f / proj.w();
+
+                raster.w() = rhw;
+                raster.z() = proj.z() * rhw;
+                raster.y() = proj.y() * rhw;
+                raster.x() = proj.x() * rhw;
+
+                v.colorPrimary *= rhw;
+                v.colorSecondary *= rhw;
+                for (auto &texCoord : v.texCoord) {
+
+                    texCoord *= rhw;
                 }
-            }
 
-            Context::getCurrentContext()->getRenderer().drawTriangles(m_triangles);
+                // Viewport transformation
+                m_viewport.transform(raster);
+            }
         }
     }
 }
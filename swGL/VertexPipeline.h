@@ -51,7 +51,9 @@ namespace SWGL {
     private:
         void addTriangle(Vertex &v1, Vertex &v2, Vertex &v3);
         void addLine(Vertex &v1, Vertex &v2);
+        void fetchVertices(unsigned int first, unsigned int count, const IndexSupplier &indexSupplier);
         void drawTriangles();
+        void projectTriangles(Triangle *first, Triangle *last);
 
     private:
         bool m_isInsideGLBegin;
@@ -70,5 +72,6 @@ namespace SWGL {
     private:
         VertexList m_vertices;
         TriangleList m_triangles;
+        std::vector<TriangleList> m_chunks;
     };
 }
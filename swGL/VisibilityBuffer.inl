@@ -0,0 +1,432 @@
+﻿#pragma once
+
+#include <algorithm>
+#include "DrawBuffer.h"
+#include "SIMD.h"
+#include "OpenGL.h"
+#include "TextureManager.h"
+#include "CommandDrawTriangle.h"
+#include "Rasterizer.inl"
+#include "CommandDrawTriangle.inl"
+#include "DrawBuffer.inl"
+
+namespace SWGL {
+
+inline namespace SWGL_SIMD_NAMESPACE {
+
+    //
+    // Visibility pass kernel for opaque triangles which write depth. Only the depth and
+    // the id of the triangle are written for every pixel, the visible pixels are shaded
+    // once by resolveVisibility() when the tile needs its colors. Hidden pixels are never
+    // textured, no matter how often they have been drawn over.
+    //
+    template<GLenum DepthFunc>
+    static bool drawVisibility(TriangleDrawCallState &state, const int *indices, int numIndices, DrawBuffer &drawBuffer) {
+
+        auto &stateBlock = *state.stateBlock;
+        auto &scissor = stateBlock.scissor;
+        auto &polygonOffset = stateBlock.polygonOffset;
+        auto &setup = state.setup;
+
+        for (int indexIdx = 0; indexIdx < numIndices; indexIdx++) {
+
+            auto triangleIdx = indices[indexIdx];
+
+            //
+            // Get the fixed point coordinates from the triangle setup
+            //
+            int x1 = setup.getPosition(TriangleSetup::X1)[triangleIdx];
+            int y1 = setup.getPosition(TriangleSetup::Y1)[triangleIdx];
+            int x2 = setup.getPosition(TriangleSetup::X2)[triangleIdx];
+            int y2 = setup.getPosition(TriangleSetup::Y2)[triangleIdx];
+            int x3 = setup.getPosition(TriangleSetup::X3)[triangleIdx];
+            int y3 = setup.getPosition(TriangleSetup::Y3)[triangleIdx];
+
+            //
+            // Determine triangle bounding box with respect to our rendertarget
+            //
+            int minY = SIMD::max((SIMD::min(y1, SIMD::min(y2, y3)) + 0x0f) >> 4, drawBuffer.getMinY());
+            int maxY = SIMD::min((SIMD::max(y1, SIMD::max(y2, y3)) + 0x0f) >> 4, drawBuffer.getMaxY());
+            int minX = SIMD::max((SIMD::min(x1, SIMD::min(x2, x3)) + 0x0f) >> 4, drawBuffer.getMinX());
+            int maxX = SIMD::min((SIMD::max(x1, SIMD::max(x2, x3)) + 0x0f) >> 4, drawBuffer.getMaxX());
+
+            if (scissor.isEnabled()) {
+
+                scissor.cut(minX, minY, maxX, maxY);
+            }
+
+            // Make sure that we rasterize at the beginning of a quad (which is 2x2 pixel)
+            minX &= ~1;
+            minY &= ~1;
+
+            //
+            // Determine the triangle edge equations
+            //
+            int dx12 = x1 - x2, dx23 = x2 - x3, dx31 = x3 - x1;
+            int dy12 = y1 - y2, dy23 = y2 - y3, dy31 = y3 - y1;
+
+            EdgeEquation edges[3];
+            QInt quadEdgeValue[3], edgeDX[3];
+            setupEdgeEquation(edges[0], quadEdgeValue[0], edgeDX[0], setup.getPosition(TriangleSetup::Edge12)[triangleIdx], dx12, dy12, minX, minY);
+            setupEdgeEquation(edges[1], quadEdgeValue[1], edgeDX[1], setup.getPosition(TriangleSetup::Edge23)[triangleIdx], dx23, dy23, minX, minY);
+            setupEdgeEquation(edges[2], quadEdgeValue[2], edgeDX[2], setup.getPosition(TriangleSetup::Edge31)[triangleIdx], dx31, dy31, minX, minY);
+
+            //
+            // Depth is the only attribute of the visibility pass
+            //
+            QFloat zValue, zDX, zDY;
+            loadGradientEquation(zValue, zDX, zDY, setup, TriangleSetup::Z, triangleIdx);
+
+            if (polygonOffset.isFillEnabled()) {
+
+                QFloat m = _mm_max_ps(SIMD::absolute(zDX), SIMD::absolute(zDY));
+                QFloat zOffset = SIMD::multiplyAdd(
+
+                    m,
+                    _mm_set1_ps(stateBlock.polygonOffsetFactor),
+                    _mm_set1_ps(stateBlock.polygonOffsetRTimesUnits)
+                );
+
+                zValue = _mm_add_ps(zValue, zOffset);
+            }
+
+            // Hierarchical depth test of the whole triangle
+            DepthPlane depthPlane = {};
+            depthPlane.value = _mm_cvtss_f32(zValue);
+            depthPlane.dzdx = _mm_cvtss_f32(zDX);
+            depthPlane.dzdy = _mm_cvtss_f32(zDY);
+
+            if (isDepthTestFailing(DepthFunc, depthPlane.getBounds(minX, minY, maxX, maxY), drawBuffer.getTileDepthBounds())) {
+
+                continue;
+            }
+
+            // The id is only taken once a pixel of the triangle is visible
+            unsigned int triangleId = 0;
+
+            int gridMinX = minX - ((minX - drawBuffer.getMinX()) % SWGL_RASTER_BLOCK_SIZE);
+            int gridMinY = minY - ((minY - drawBuffer.getMinY()) % SWGL_RASTER_BLOCK_SIZE);
+
+            for (int blockY = gridMinY; blockY < maxY; blockY += SWGL_RASTER_BLOCK_SIZE) {
+
+                int firstY = SIMD::max(blockY, minY);
+                int blockMaxY = SIMD::min(blockY + SWGL_RASTER_BLOCK_SIZE, maxY);
+
+                for (int blockX = gridMinX; blockX < maxX; blockX += SWGL_RASTER_BLOCK_SIZE) {
+
+                    int firstX = SIMD::max(blockX, minX);
+                    int blockMaxX = SIMD::min(blockX + SWGL_RASTER_BLOCK_SIZE, maxX);
+
+                    // The last pixel which is touched by the quads of the block
+                    int lastX = firstX + ((1 + (blockMaxX - firstX)) & ~1) - 1;
+                    int lastY = firstY + ((1 + (blockMaxY - firstY)) & ~1) - 1;
+
+                    auto coverage = testBlockCoverage(edges, firstX - minX, firstY - minY, lastX - minX, lastY - minY);
+                    if (coverage == BlockCoverage::Empty) {
+
+                        continue;
+                    }
+
+                    if (isDepthTestFailing(DepthFunc, depthPlane.getBounds(firstX, firstY, lastX, lastY), drawBuffer.getDepthBounds(blockX, blockY))) {
+
+                        continue;
+                    }
+
+                    bool isDepthWritten = false;
+
+                    for (int y = firstY; y < blockMaxY; y += 2) {
+
+                        QFloat yyyy = _mm_set1_ps(static_cast<float>(y));
+
+                        // Edge equation values at the first quad of the row
+                        QInt edgeValue[3];
+                        for (int i = 0; i < 3; i++) {
+
+                            edgeValue[i] = _mm_add_epi32(quadEdgeValue[i], _mm_set1_epi32(edges[i].evaluate(firstX - minX, y - minY)));
+                        }
+
+                        ptrdiff_t bufferOffset = ((firstX - drawBuffer.getMinX()) << 1) + ((y - drawBuffer.getMinY()) * drawBuffer.getWidth());
+                        auto depthBuffer = drawBuffer.getDepth() + bufferOffset;
+                        auto visibilityBuffer = drawBuffer.getVisibility() + bufferOffset;
+
+                        for (int x = firstX; x < blockMaxX; x += 2) {
+
+                            //
+                            // Coverage test for a 2x2 pixel quad, fully covered blocks don't need it
+                            //
+                            QInt fragmentMask = _mm_set1_epi32(-1);
+
+                            if (coverage == BlockCoverage::Partial) {
+
+                                QInt e0 = _mm_cmpgt_epi32(edgeValue[0], _mm_setzero_si128());
+                                QInt e1 = _mm_cmpgt_epi32(edgeValue[1], _mm_setzero_si128());
+                                QInt e2 = _mm_cmpgt_epi32(edgeValue[2], _mm_setzero_si128());
+                                fragmentMask = _mm_and_si128(_mm_and_si128(e0, e1), e2);
+                            }
+
+                            if (!SIMD::isZero(fragmentMask)) {
+
+                                QFloat xxxx = _mm_set1_ps(static_cast<float>(x));
+
+                                //
+                                // Depth test
+                                //
+                                QInt depthBufferZ = _mm_load_si128(reinterpret_cast<QInt *>(depthBuffer));
+                                QInt currentZ = _mm_cvtps_epi32(
+                                    _mm_mul_ps(
+                                        _mm_set1_ps(16777215.0f),
+                                        SIMD::clamp01(_mm_add_ps(zValue, _mm_add_ps(_mm_mul_ps(xxxx, zDX), _mm_mul_ps(yyyy, zDY))))
+                                    )
+                                );
+
+                                if (DepthFunc == GL_LESS) {
+
+                                    fragmentMask = _mm_and_si128(_mm_cmplt_epi32(currentZ, depthBufferZ), fragmentMask);
+                                }
+                                else {
+
+                                    fragmentMask = _mm_andnot_si128(_mm_cmpgt_epi32(currentZ, depthBufferZ), fragmentMask);
+                                }
+
+                                //
+                                // Write the depth and the id of the visible fragments
+                                //
+                                if (!SIMD::isZero(fragmentMask)) {
+
+                                    if (triangleId == 0) {
+
+                                        triangleId = drawBuffer.addVisibleTriangle(&state, triangleIdx);
+                                    }
+
+                                    QInt visibility = _mm_load_si128(reinterpret_cast<QInt *>(visibilityBuffer));
+
+                                    _mm_store_si128(reinterpret_cast<QInt *>(depthBuffer), SIMD::blend(depthBufferZ, currentZ, fragmentMask));
+                                    _mm_store_si128(reinterpret_cast<QInt *>(visibilityBuffer), SIMD::blend(visibility, _mm_set1_epi32(triangleId), fragmentMask));
+                                    isDepthWritten = true;
+                                }
+                            }
+
+                            // Update edge equation values with respect to the change in x
+                            edgeValue[0] = _mm_add_epi32(edgeValue[0], edgeDX[0]);
+                            edgeValue[1] = _mm_add_epi32(edgeValue[1], edgeDX[1]);
+                            edgeValue[2] = _mm_add_epi32(edgeValue[2], edgeDX[2]);
+
+                            // Update buffer address
+                            depthBuffer += 4;
+                            visibilityBuffer += 4;
+                        }
+                    }
+
+                    if (isDepthWritten) {
+
+                        updateDepthBounds(drawBuffer, blockX, blockY);
+                        drawBuffer.markVisibilityBlock(blockX, blockY);
+                    }
+                }
+            }
+        }
+
+        drawBuffer.updateTileDepthBounds();
+        return true;
+    }
+
+    static DrawTrianglesKernel selectDrawVisibility(const RasterOps &rasterOps) {
+
+        // Only opaque triangles which write depth can be shaded after the visibility is
+        // known. Anything that reads or keeps the color of the pixel has to be shaded
+        // in order.
+        if (rasterOps.depthWrite != GL_TRUE ||
+            rasterOps.alphaFunc != GL_NONE ||
+            rasterOps.blendSrc != GL_ONE ||
+            rasterOps.blendDst != GL_ZERO) {
+
+            return nullptr;
+        }
+
+        switch (rasterOps.depthFunc) {
+
+        case GL_LESS: return &drawVisibility<GL_LESS>;
+        case GL_LEQUAL: return &drawVisibility<GL_LEQUAL>;
+        }
+
+        return nullptr;
+    }
+
+
+
+    // The gradients of the attributes which are needed to shade a triangle
+    struct ShadingGradients {
+
+        QFloat value[TriangleSetup::NumAttributes];
+        QFloat dx[TriangleSetup::NumAttributes];
+        QFloat dy[TriangleSetup::NumAttributes];
+
+        INLINED void load(TriangleSetup &setup, int attribute, int triangleIdx) {
+
+            load(setup, attribute, attribute, triangleIdx);
+        }
+
+        // The texture coordinates are kept in the full layout, while the setup only
+        // has room for the bound units
+        INLINED void load(TriangleSetup &setup, int attribute, int setupAttribute, int triangleIdx) {
+
+            loadGradientEquation(value[attribute], dx[attribute], dy[attribute], setup, setupAttribute, triangleIdx);
+        }
+
+        INLINED QFloat interpolate(int attribute, QFloat xxxx, QFloat yyyy) const {
+
+            return _mm_add_ps(value[attribute], _mm_add_ps(_mm_mul_ps(xxxx, dx[attribute]), _mm_mul_ps(yyyy, dy[attribute])));
+        }
+    };
+
+    static void loadShadingGradients(ShadingGradients &gradients, const VisibleTriangle &triangle) {
+
+        auto &setup = triangle.state->setup;
+        auto &textureState = triangle.state->stateBlock->textures;
+
+        gradients.load(setup, TriangleSetup::RcpW, triangle.index);
+        gradients.load(setup, TriangleSetup::PrimaryA, triangle.index);
+        gradients.load(setup, TriangleSetup::PrimaryR, triangle.index);
+        gradients.load(setup, TriangleSetup::PrimaryG, triangle.index);
+        gradients.load(setup, TriangleSetup::PrimaryB, triangle.index);
+
+        for (auto i = 0U; i < SWGL_MAX_TEXTURE_UNITS; i++) {
+
+            if (textureState[i].texData == nullptr) {
+
+                continue;
+            }
+
+            auto texCoord = TriangleSetup::TexCoord + static_cast<int>(i * 4);
+            auto setupTexCoord = setup.getTexCoord(i);
+            gradients.load(setup, texCoord + 0, setupTexCoord + 0, triangle.index);
+            gradients.load(setup, texCoord + 1, setupTexCoord + 1, triangle.index);
+            gradients.load(setup, texCoord + 2, setupTexCoord + 2, triangle.index);
+            gradients.load(setup, texCoord + 3, setupTexCoord + 3, triangle.index);
+        }
+    }
+
+    // Shades a quad with the texture units of a triangle, like the draw triangle kernel
+    // does after the depth test
+    static INLINED QInt shadeQuad(const ShadingGradients &gradients, DrawStateBlock &stateBlock, QFloat xxxx, QFloat yyyy) {
+
+        ARGBColor srcColor, texColor, primaryColor;
+        TextureCoordinates texCoords;
+
+        QFloat w = _mm_div_ps(_mm_set1_ps(1.0f), gradients.interpolate(TriangleSetup::RcpW, xxxx, yyyy));
+
+        primaryColor.a = _mm_mul_ps(w, gradients.interpolate(TriangleSetup::PrimaryA, xxxx, yyyy));
+        primaryColor.r = _mm_mul_ps(w, gradients.interpolate(TriangleSetup::PrimaryR, xxxx, yyyy));
+        primaryColor.g = _mm_mul_ps(w, gradients.interpolate(TriangleSetup::PrimaryG, xxxx, yyyy));
+        primaryColor.b = _mm_mul_ps(w, gradients.interpolate(TriangleSetup::PrimaryB, xxxx, yyyy));
+
+        srcColor = primaryColor;
+
+        for (auto texUnit = 0U; texUnit < SWGL_MAX_TEXTURE_UNITS; texUnit++) {
+
+            auto &texState = stateBlock.textures[texUnit];
+            if (texState.texData == nullptr) {
+
+                continue;
+            }
+
+            auto texCoord = TriangleSetup::TexCoord + static_cast<int>(texUnit * 4);
+
+            QFloat rcpQ = _mm_div_ps(_mm_set1_ps(1.0f), gradients.interpolate(texCoord + 3, xxxx, yyyy));
+            texCoords.s = _mm_mul_ps(rcpQ, gradients.interpolate(texCoord + 0, xxxx, yyyy));
+            texCoords.t = _mm_mul_ps(rcpQ, gradients.interpolate(texCoord + 1, xxxx, yyyy));
+            texCoords.r = _mm_mul_ps(rcpQ, gradients.interpolate(texCoord + 2, xxxx, yyyy));
+            sampleTexture(texState, texCoords, texColor);
+
+            texState.texEnvKernel(texState.texEnv, texColor, primaryColor, srcColor);
+        }
+
+        return getIntegerRGBA(srcColor);
+    }
+
+    //
+    // Shades the pixels of the visibility pass. The quads are shaded once for every
+    // triangle which is visible in them, with the partial derivatives of the whole quad,
+    // so texture filtering is the same as if the triangle had been shaded right away.
+    //
+    static void resolveVisibility(DrawBuffer &drawBuffer) {
+
+        ShadingGradients gradients;
+        unsigned int loadedId = 0;
+
+        int width = drawBuffer.getWidth();
+        int height = drawBuffer.getHeight();
+        int numBlocksX = drawBuffer.getNumDepthBlocksX();
+        int numBlocksY = drawBuffer.getNumDepthBlocksY();
+
+        for (int blockIdx = 0; blockIdx < numBlocksX * numBlocksY; blockIdx++) {
+
+            if (!drawBuffer.isVisibilityBlockMarked(blockIdx)) {
+
+                continue;
+            }
+
+            // The block in pixels, relative to the tile
+            int minX = (blockIdx % numBlocksX) * SWGL_RASTER_BLOCK_SIZE;
+            int minY = (blockIdx / numBlocksX) * SWGL_RASTER_BLOCK_SIZE;
+            int maxX = SIMD::min(minX + SWGL_RASTER_BLOCK_SIZE, width);
+            int maxY = SIMD::min(minY + SWGL_RASTER_BLOCK_SIZE, height);
+
+            for (int y = minY; y < maxY; y += 2) {
+
+                QFloat yyyy = _mm_set1_ps(static_cast<float>(y + drawBuffer.getMinY()));
+
+                ptrdiff_t bufferOffset = (minX << 1) + (y * width);
+                auto colorBuffer = drawBuffer.getColor() + bufferOffset;
+                auto visibilityBuffer = drawBuffer.getVisibility() + bufferOffset;
+
+                for (int x = minX; x < maxX; x += 2, colorBuffer += 4, visibilityBuffer += 4) {
+
+                    QInt ids = _mm_load_si128(reinterpret_cast<QInt *>(visibilityBuffer));
+                    if (SIMD::isZero(ids)) {
+
+                        continue;
+                    }
+
+                    QFloat xxxx = _mm_set1_ps(static_cast<float>(x + drawBuffer.getMinX()));
+                    QInt color = _mm_load_si128(reinterpret_cast<QInt *>(colorBuffer));
+
+                    // The pixels of a quad may belong to different triangles
+                    do {
+
+                        alignas(16) unsigned int laneIds[4];
+                        _mm_store_si128(reinterpret_cast<QInt *>(laneIds), ids);
+
+                        unsigned int id = 0;
+                        for (auto laneId : laneIds) {
+
+                            if (laneId != 0) {
+
+                                id = laneId;
+                                break;
+                            }
+                        }
+
+                        auto &triangle = drawBuffer.getVisibleTriangle(id);
+                        if (id != loadedId) {
+
+                            loadShadingGradients(gradients, triangle);
+                            loadedId = id;
+                        }
+
+                        QInt mask = _mm_cmpeq_epi32(ids, _mm_set1_epi32(id));
+                        color = SIMD::blend(color, shadeQuad(gradients, *triangle.state->stateBlock, xxxx, yyyy), mask);
+                        ids = _mm_andnot_si128(mask, ids);
+
+                    } while (!SIMD::isZero(ids));
+
+                    _mm_store_si128(reinterpret_cast<QInt *>(colorBuffer), color);
+                    _mm_store_si128(reinterpret_cast<QInt *>(visibilityBuffer), _mm_setzero_si128());
+                }
+            }
+        }
+
+        drawBuffer.endVisibility();
+    }
+}
+}
@@ -146,9 +146,8 @@ SWGLAPI BOOL STDCALL glDrv_wglMakeCurrent(HDC hdc, HGLRC hglrc) {
             reinterpret_cast<SWGL::ContextID>(hglrc)
         );
 
-        if (context != nullptr) {
+        if (context != nullptr && SWGL::Context::setCurrentContext(context, hdc)) {
 
-            SWGL::Context::setCurrentContext(context, hdc);
             return TRUE;
         }
     }
@@ -193,7 +192,12 @@ SWGLAPI BOOL STDCALL glDrv_wglSwapBuffers(HDC hdc) {
     auto &context = SWGL::Context::getCurrentContext();
     if (context != nullptr) {
 
-        context->getRenderer().swapBuffers();
+        auto swapBuffers = [] { SWGL::Context::getCurrentContext()->getRenderer().swapBuffers(); };
+
+        if (!context->getFrontend().forwardFrame(swapBuffers)) {
+
+            swapBuffers();
+        }
         return TRUE;
     }
 
@@ -209,7 +213,12 @@ SWGLAPI BOOL STDCALL glDrv_wglSwapLayerBuffers(HDC hdc, UINT planes) {
 
         if ((planes & WGL_SWAP_MAIN_PLANE) != 0U) {
 
-            context->getRenderer().swapBuffers();
+            auto swapBuffers = [] { SWGL::Context::getCurrentContext()->getRenderer().swapBuffers(); };
+
+            if (!context->getFrontend().forwardFrame(swapBuffers)) {
+
+                swapBuffers();
+            }
         }
 
         return TRUE;
@@ -278,3 +287,20 @@ SWGLAPI const char * STDCALL glDrv_wglGetExtensionsString(HDC hdc) {
 
     return nullptr;
 }
+
+SWGLAPI BOOL STDCALL glDrv_wglSetContextPriority(HGLRC hglrc, int priority) {
+
+    LOG("Context: %p, Priority: %d", hglrc, priority);
+
+    auto context = SWGL::Context::getContext(
+        reinterpret_cast<SWGL::ContextID>(hglrc)
+    );
+
+    if (context == nullptr || priority <= 0) {
+
+        return FALSE;
+    }
+
+    context->getRenderer().setPriority(priority);
+    return TRUE;
+}